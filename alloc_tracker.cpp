@@ -0,0 +1,179 @@
+#include "alloc_tracker.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @file alloc_tracker.cpp
+ * @brief Allocation counters and, with PACMAN_ALLOC_TRACKING, the operator new that feeds them
+ */
+
+const char *alloc_tag_name(AllocTag tag)
+{
+    switch (tag)
+    {
+    case AllocTag::OTHER:
+        return "other";
+    case AllocTag::MAZE:
+        return "maze";
+    case AllocTag::PELLETS:
+        return "pellets";
+    case AllocTag::ENTITIES:
+        return "entities";
+    case AllocTag::TIMERS:
+        return "timers";
+    case AllocTag::SYSTEMS:
+        return "systems";
+    case AllocTag::BOT:
+        return "bot";
+    case AllocTag::REPLAY:
+        return "replay";
+    case AllocTag::ANALYTICS:
+        return "analytics";
+    default:
+        return "?";
+    }
+}
+
+// ============== AllocStats Implementation ==============
+
+std::uint64_t AllocStats::total_count() const
+{
+    std::uint64_t total = 0;
+    for (std::uint64_t n : count)
+        total += n;
+    return total;
+}
+
+std::uint64_t AllocStats::total_bytes() const
+{
+    std::uint64_t total = 0;
+    for (std::uint64_t n : bytes)
+        total += n;
+    return total;
+}
+
+AllocStats AllocStats::operator-(const AllocStats &earlier) const
+{
+    AllocStats difference;
+    for (int i = 0; i < ALLOC_TAG_COUNT; i++)
+    {
+        difference.count[i] = count[i] - earlier.count[i];
+        difference.bytes[i] = bytes[i] - earlier.bytes[i];
+    }
+    return difference;
+}
+
+AllocStats &AllocStats::operator+=(const AllocStats &other)
+{
+    for (int i = 0; i < ALLOC_TAG_COUNT; i++)
+    {
+        count[i] += other.count[i];
+        bytes[i] += other.bytes[i];
+    }
+    return *this;
+}
+
+#ifdef PACMAN_ALLOC_TRACKING
+
+// ============== Tracking ==============
+
+namespace
+{
+    // Plain arrays of atomics: constant-initialized, so allocations made before main() are counted safely
+    std::atomic<std::uint64_t> counts[ALLOC_TAG_COUNT];
+    std::atomic<std::uint64_t> byte_counts[ALLOC_TAG_COUNT];
+    std::atomic<bool> tick_assertions{false};
+
+    thread_local AllocTag current_tag = AllocTag::OTHER;
+    thread_local bool in_tick = false;
+
+    void record(std::size_t size)
+    {
+        const int tag = static_cast<int>(current_tag);
+        counts[tag].fetch_add(1, std::memory_order_relaxed);
+        byte_counts[tag].fetch_add(size, std::memory_order_relaxed);
+
+        if (in_tick && tick_assertions.load(std::memory_order_relaxed))
+        {
+            // stdio rather than iostream, which could allocate again
+            std::fprintf(stderr, "Allocation of %zu bytes (%s) inside a simulation tick!\n", size,
+                         alloc_tag_name(current_tag));
+            std::abort();
+        }
+    }
+
+    void *allocate(std::size_t size)
+    {
+        record(size);
+        if (void *memory = std::malloc(size == 0 ? 1 : size))
+            return memory;
+        throw std::bad_alloc();
+    }
+}
+
+namespace AllocTracker
+{
+    AllocStats snapshot()
+    {
+        AllocStats stats;
+        for (int i = 0; i < ALLOC_TAG_COUNT; i++)
+        {
+            stats.count[i] = counts[i].load(std::memory_order_relaxed);
+            stats.bytes[i] = byte_counts[i].load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    void set_tick_assertions(bool enabled)
+    {
+        tick_assertions.store(enabled, std::memory_order_relaxed);
+    }
+
+    AllocTag exchange_tag(AllocTag tag)
+    {
+        const AllocTag previous = current_tag;
+        current_tag = tag;
+        return previous;
+    }
+
+    bool exchange_in_tick(bool tick)
+    {
+        const bool previous = in_tick;
+        in_tick = tick;
+        return previous;
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+#endif
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file alloc_tracker.h
+ * @brief Opt-in heap allocation tracking, tagged by subsystem
+ *
+ * Configuring with -DPACMAN_ALLOC_TRACKING=ON replaces the global operator
+ * new so every allocation is counted against the subsystem whose AllocScope
+ * is innermost on the allocating thread. Tools take an AllocTracker::snapshot()
+ * before and after a frame or a level load and subtract them to see what it
+ * allocated. Simulation::step runs inside an AllocTickScope: with tick
+ * assertions on, any allocation during a tick aborts with the subsystem and
+ * size that allocated.
+ *
+ * Without the option every function here is an inline no-op and snapshots
+ * stay empty, so the scopes can stay in the code at no cost.
+ */
+
+/**
+ * Subsystems allocations are charged to
+ */
+enum class AllocTag : std::uint8_t
+{
+    OTHER,     ///< Outside any scope
+    MAZE,      ///< Maze layout and walkable cells
+    PELLETS,   ///< GameState: tokens, power pellets and collection lists
+    ENTITIES,  ///< World components, Pac-Man, ghosts and fruit
+    TIMERS,    ///< Timer wheel buckets, callbacks and expiry index
+    SYSTEMS,   ///< Systems run during a simulation step
+    BOT,       ///< Autopilot path search
+    REPLAY,    ///< Replay recording
+    ANALYTICS, ///< Analytics event chunks
+    COUNT
+};
+
+constexpr int ALLOC_TAG_COUNT = static_cast<int>(AllocTag::COUNT);
+
+/**
+ * @brief Short lower-case name of a tag, for reports
+ */
+const char *alloc_tag_name(AllocTag tag);
+
+/**
+ * Allocations counted per subsystem
+ */
+struct AllocStats
+{
+    std::uint64_t count[ALLOC_TAG_COUNT] = {}; ///< operator new calls
+    std::uint64_t bytes[ALLOC_TAG_COUNT] = {}; ///< Bytes requested
+
+    std::uint64_t total_count() const;
+    std::uint64_t total_bytes() const;
+
+    /**
+     * @brief What was allocated between an earlier snapshot and this one
+     */
+    AllocStats operator-(const AllocStats &earlier) const;
+    AllocStats &operator+=(const AllocStats &other);
+};
+
+namespace AllocTracker
+{
+#ifdef PACMAN_ALLOC_TRACKING
+    constexpr bool ENABLED = true;
+
+    /**
+     * @brief Allocations made by every thread since the program started
+     */
+    AllocStats snapshot();
+
+    /**
+     * @brief Abort on any allocation inside an AllocTickScope (off by default)
+     */
+    void set_tick_assertions(bool enabled);
+
+    /**
+     * @brief Make tag the current thread's tag and return the previous one
+     */
+    AllocTag exchange_tag(AllocTag tag);
+
+    /**
+     * @brief Mark the current thread as inside (or outside) a steady-state tick; returns the previous value
+     */
+    bool exchange_in_tick(bool in_tick);
+#else
+    constexpr bool ENABLED = false;
+
+    inline AllocStats snapshot() { return AllocStats(); }
+    inline void set_tick_assertions(bool) {}
+#endif
+}
+
+/**
+ * @class AllocScope
+ * @brief Charges allocations made by this thread to a subsystem until it goes out of scope
+ */
+class AllocScope
+{
+public:
+#ifdef PACMAN_ALLOC_TRACKING
+    explicit AllocScope(AllocTag tag) : previous_(AllocTracker::exchange_tag(tag)) {}
+    ~AllocScope() { AllocTracker::exchange_tag(previous_); }
+#else
+    explicit AllocScope(AllocTag) {}
+#endif
+
+    AllocScope(const AllocScope &) = delete;
+    AllocScope &operator=(const AllocScope &) = delete;
+
+#ifdef PACMAN_ALLOC_TRACKING
+private:
+    AllocTag previous_;
+#endif
+};
+
+/**
+ * @class AllocTickScope
+ * @brief Marks a steady-state simulation tick, where tick assertions forbid allocating
+ */
+class AllocTickScope
+{
+public:
+#ifdef PACMAN_ALLOC_TRACKING
+    AllocTickScope() : previous_(AllocTracker::exchange_in_tick(true)) {}
+    ~AllocTickScope() { AllocTracker::exchange_in_tick(previous_); }
+#else
+    AllocTickScope() {}
+#endif
+
+    AllocTickScope(const AllocTickScope &) = delete;
+    AllocTickScope &operator=(const AllocTickScope &) = delete;
+
+#ifdef PACMAN_ALLOC_TRACKING
+private:
+    bool previous_;
+#endif
+};
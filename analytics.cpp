@@ -0,0 +1,220 @@
+#include "analytics.h"
+#include "alloc_tracker.h"
+#include <cstring>
+
+/**
+ * @file analytics.cpp
+ * @brief Implementation of the AnalyticsLog class and the event file reader
+ */
+
+const char *analytics_event_name(AnalyticsEventKind kind)
+{
+    switch (kind)
+    {
+    case AnalyticsEventKind::GAME_START:
+        return "GAME_START";
+    case AnalyticsEventKind::LEVEL_START:
+        return "LEVEL_START";
+    case AnalyticsEventKind::PELLET:
+        return "PELLET";
+    case AnalyticsEventKind::POWER_PELLET:
+        return "POWER_PELLET";
+    case AnalyticsEventKind::GHOST_CAUGHT:
+        return "GHOST_CAUGHT";
+    case AnalyticsEventKind::DEATH:
+        return "DEATH";
+    case AnalyticsEventKind::FRUIT:
+        return "FRUIT";
+    case AnalyticsEventKind::LEVEL_CLEARED:
+        return "LEVEL_CLEARED";
+    default:
+        return "?";
+    }
+}
+
+namespace
+{
+    template <typename T>
+    void write_column(std::ofstream &file, const T *values, std::size_t rows)
+    {
+        file.write(reinterpret_cast<const char *>(values), static_cast<std::streamsize>(rows * sizeof(T)));
+    }
+
+    template <typename T>
+    bool read_column(std::ifstream &file, std::vector<T> &column, std::size_t rows)
+    {
+        const std::size_t start = column.size();
+        column.resize(start + rows);
+        file.read(reinterpret_cast<char *>(column.data() + start), static_cast<std::streamsize>(rows * sizeof(T)));
+        return static_cast<bool>(file);
+    }
+}
+
+bool load_analytics(const std::string &path, AnalyticsTable &table)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    char magic[sizeof(AnalyticsConfig::MAGIC)];
+    std::uint32_t version = 0;
+    std::uint32_t schema_length = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char *>(&version), sizeof(version));
+    file.read(reinterpret_cast<char *>(&schema_length), sizeof(schema_length));
+    if (!file || std::memcmp(magic, AnalyticsConfig::MAGIC, sizeof(magic)) != 0 ||
+        version != AnalyticsConfig::FORMAT_VERSION)
+        return false;
+
+    std::string schema(schema_length, '\0');
+    file.read(&schema[0], schema_length);
+    if (!file || schema != AnalyticsConfig::SCHEMA)
+        return false;
+
+    table = AnalyticsTable();
+    std::uint32_t rows = 0;
+    while (file.read(reinterpret_cast<char *>(&rows), sizeof(rows)))
+    {
+        if (!read_column(file, table.game, rows) || !read_column(file, table.tick, rows) ||
+            !read_column(file, table.kind, rows) || !read_column(file, table.level, rows) ||
+            !read_column(file, table.row, rows) || !read_column(file, table.col, rows) ||
+            !read_column(file, table.ghost, rows) || !read_column(file, table.value, rows))
+            return false;
+    }
+    return file.eof() && file.gcount() == 0;
+}
+
+// ============== AnalyticsLog Implementation ==============
+
+AnalyticsLog::AnalyticsLog(const std::string &path)
+    : file_(path, std::ios::binary | std::ios::trunc), game_(0), event_count_(0), writing_(false), stopping_(false)
+{
+    {
+        AllocScope alloc_scope(AllocTag::ANALYTICS);
+        current_ = std::make_unique<Chunk>();
+        full_.reserve(AnalyticsConfig::SPARE_CHUNKS + 1);
+        spare_.reserve(AnalyticsConfig::SPARE_CHUNKS + 1);
+        for (std::size_t i = 0; i < AnalyticsConfig::SPARE_CHUNKS; i++)
+            spare_.push_back(std::make_unique<Chunk>());
+    }
+
+    if (file_.is_open())
+    {
+        const std::uint32_t version = AnalyticsConfig::FORMAT_VERSION;
+        const std::uint32_t schema_length = static_cast<std::uint32_t>(std::strlen(AnalyticsConfig::SCHEMA));
+        file_.write(AnalyticsConfig::MAGIC, sizeof(AnalyticsConfig::MAGIC));
+        file_.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        file_.write(reinterpret_cast<const char *>(&schema_length), sizeof(schema_length));
+        file_.write(AnalyticsConfig::SCHEMA, schema_length);
+    }
+
+    writer_ = std::thread(&AnalyticsLog::write_loop, this);
+}
+
+AnalyticsLog::~AnalyticsLog()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    writer_.join();
+}
+
+void AnalyticsLog::record(const AnalyticsEvent &event)
+{
+    if (event.kind == AnalyticsEventKind::GAME_START && event_count_ != 0)
+        game_++;
+
+    Chunk &chunk = *current_;
+    const std::size_t i = chunk.rows++;
+    chunk.game[i] = game_;
+    chunk.tick[i] = event.tick;
+    chunk.kind[i] = static_cast<std::uint8_t>(event.kind);
+    chunk.level[i] = static_cast<std::uint8_t>(event.level);
+    chunk.row[i] = static_cast<std::int8_t>(event.row);
+    chunk.col[i] = static_cast<std::int8_t>(event.col);
+    chunk.ghost[i] = static_cast<std::int8_t>(event.ghost);
+    chunk.value[i] = event.value;
+    event_count_++;
+
+    if (chunk.rows == AnalyticsConfig::CHUNK_ROWS)
+        submit();
+}
+
+void AnalyticsLog::flush()
+{
+    if (current_->rows != 0)
+        submit();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this]()
+                  { return full_.empty() && !writing_; });
+    file_.flush();
+}
+
+void AnalyticsLog::submit()
+{
+    std::unique_ptr<Chunk> next;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        full_.push_back(std::move(current_));
+        if (!spare_.empty())
+        {
+            next = std::move(spare_.back());
+            spare_.pop_back();
+        }
+    }
+    changed_.notify_all();
+
+    // The writer has fallen behind: grow rather than wait for it
+    if (!next)
+    {
+        AllocScope alloc_scope(AllocTag::ANALYTICS);
+        next = std::make_unique<Chunk>();
+    }
+    next->rows = 0;
+    current_ = std::move(next);
+}
+
+void AnalyticsLog::write_loop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        changed_.wait(lock, [this]()
+                      { return !full_.empty() || stopping_; });
+        if (full_.empty())
+            return;
+
+        std::unique_ptr<Chunk> chunk = std::move(full_.front());
+        full_.erase(full_.begin());
+        writing_ = true;
+
+        lock.unlock();
+        write_chunk(*chunk);
+        lock.lock();
+
+        writing_ = false;
+        spare_.push_back(std::move(chunk));
+        changed_.notify_all();
+    }
+}
+
+void AnalyticsLog::write_chunk(const Chunk &chunk)
+{
+    if (!file_.is_open())
+        return;
+
+    const std::uint32_t rows = static_cast<std::uint32_t>(chunk.rows);
+    file_.write(reinterpret_cast<const char *>(&rows), sizeof(rows));
+    write_column(file_, chunk.game.data(), chunk.rows);
+    write_column(file_, chunk.tick.data(), chunk.rows);
+    write_column(file_, chunk.kind.data(), chunk.rows);
+    write_column(file_, chunk.level.data(), chunk.rows);
+    write_column(file_, chunk.row.data(), chunk.rows);
+    write_column(file_, chunk.col.data(), chunk.rows);
+    write_column(file_, chunk.ghost.data(), chunk.rows);
+    write_column(file_, chunk.value.data(), chunk.rows);
+}
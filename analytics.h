@@ -0,0 +1,179 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file analytics.h
+ * @brief Gameplay events gathered in columns and written to disk in the background
+ *
+ * This file contains the AnalyticsLog class. A Simulation given a log
+ * records one row per gameplay event (pellets, ghosts caught, deaths,
+ * fruit, level clears). Rows go into a fixed-size chunk held column by
+ * column; a full chunk is handed to a writer thread, so recording an event
+ * is a handful of array stores and never waits on the disk.
+ *
+ * Event files start with AnalyticsConfig::MAGIC ("PMEV"), the format
+ * version and the column schema as text ("name:type" pairs separated by
+ * spaces), followed by chunks: a uint32 row count, then each column's
+ * values back to back in schema order. Values are stored in the writing machine's byte order
+ * (little-endian on every platform the game builds for), so a chunk's
+ * columns can be read straight into numpy or Arrow arrays without parsing.
+ */
+
+/**
+ * Analytics configuration constants
+ */
+namespace AnalyticsConfig
+{
+    constexpr char MAGIC[4] = {'P', 'M', 'E', 'V'};
+    constexpr std::uint32_t FORMAT_VERSION = 1;
+    constexpr const char *SCHEMA = "game:u32 tick:u32 kind:u8 level:u8 row:i8 col:i8 ghost:i8 value:i32";
+    constexpr std::size_t CHUNK_ROWS = 16384; ///< Events per chunk handed to the writer
+    constexpr std::size_t SPARE_CHUNKS = 3;   ///< Chunks allocated up front for recording while others are written
+}
+
+/**
+ * Kinds of gameplay event
+ */
+enum class AnalyticsEventKind : std::uint8_t
+{
+    GAME_START,    ///< value: the game's seed
+    LEVEL_START,   ///< A later level of an endless game began
+    PELLET,        ///< Cell of the token eaten
+    POWER_PELLET,  ///< Cell of the power pellet eaten
+    GHOST_CAUGHT,  ///< ghost: its GhostAIType; cell where it was caught
+    DEATH,         ///< ghost: the GhostAIType that caught Pac-Man; cell where he died
+    FRUIT,         ///< value: points scored; cell where it was eaten
+    LEVEL_CLEARED, ///< value: ticks the level took
+    COUNT
+};
+
+/**
+ * @brief Upper-case name of an event kind, for exports
+ */
+const char *analytics_event_name(AnalyticsEventKind kind);
+
+/**
+ * One gameplay event, as recorded
+ */
+struct AnalyticsEvent
+{
+    AnalyticsEventKind kind = AnalyticsEventKind::PELLET;
+    std::uint32_t tick = 0; ///< Simulation steps since the game started
+    int level = 1;          ///< Level being played (1-5)
+    int row = -1, col = -1; ///< Maze cell the event happened in, -1 if none
+    int ghost = -1;         ///< GhostAIType of the ghost involved, -1 if none
+    std::int32_t value = 0; ///< Kind-specific figure (see AnalyticsEventKind)
+};
+
+/**
+ * Events held column by column, as read back from an event file
+ */
+struct AnalyticsTable
+{
+    std::vector<std::uint32_t> game; ///< Games counted from 0 in the order they started
+    std::vector<std::uint32_t> tick;
+    std::vector<std::uint8_t> kind;
+    std::vector<std::uint8_t> level;
+    std::vector<std::int8_t> row;
+    std::vector<std::int8_t> col;
+    std::vector<std::int8_t> ghost;
+    std::vector<std::int32_t> value;
+
+    std::size_t size() const { return kind.size(); }
+};
+
+/**
+ * @brief Read every chunk of an event file written by AnalyticsLog
+ * @return false if the file is missing, from another format version or truncated
+ */
+bool load_analytics(const std::string &path, AnalyticsTable &table);
+
+/**
+ * @class AnalyticsLog
+ * @brief Records gameplay events into columnar chunks that a background thread writes out
+ *
+ * record() is meant for the simulation thread only. Chunks are recycled
+ * once written; if the writer falls behind and no spare chunk is left a new
+ * one is allocated rather than blocking the simulation. flush() waits for
+ * everything recorded so far to reach the file, and the destructor flushes.
+ */
+class AnalyticsLog
+{
+public:
+    /**
+     * @brief Create (or truncate) an event file and start its writer thread
+     * @param path File to write; check is_open() afterwards
+     */
+    explicit AnalyticsLog(const std::string &path);
+    ~AnalyticsLog();
+
+    AnalyticsLog(const AnalyticsLog &) = delete;
+    AnalyticsLog &operator=(const AnalyticsLog &) = delete;
+
+    bool is_open() const { return file_.is_open(); }
+
+    /**
+     * @brief Append an event; GAME_START events also begin a new game number
+     */
+    void record(const AnalyticsEvent &event);
+
+    /**
+     * @brief Hand over the partly filled chunk and wait until every event is on disk
+     */
+    void flush();
+
+    /**
+     * @brief Events recorded since the log was created
+     */
+    std::uint64_t get_event_count() const { return event_count_; }
+
+private:
+    /**
+     * Up to CHUNK_ROWS events, one array per column
+     */
+    struct Chunk
+    {
+        std::size_t rows = 0;
+        std::array<std::uint32_t, AnalyticsConfig::CHUNK_ROWS> game;
+        std::array<std::uint32_t, AnalyticsConfig::CHUNK_ROWS> tick;
+        std::array<std::uint8_t, AnalyticsConfig::CHUNK_ROWS> kind;
+        std::array<std::uint8_t, AnalyticsConfig::CHUNK_ROWS> level;
+        std::array<std::int8_t, AnalyticsConfig::CHUNK_ROWS> row;
+        std::array<std::int8_t, AnalyticsConfig::CHUNK_ROWS> col;
+        std::array<std::int8_t, AnalyticsConfig::CHUNK_ROWS> ghost;
+        std::array<std::int32_t, AnalyticsConfig::CHUNK_ROWS> value;
+    };
+
+    std::ofstream file_;                        ///< Written by the writer thread only, after the header
+    std::unique_ptr<Chunk> current_;            ///< Chunk being recorded into
+    std::uint32_t game_;                        ///< Number of the game being recorded
+    std::uint64_t event_count_;                 ///< Events recorded so far
+    std::mutex mutex_;                          ///< Guards everything below
+    std::condition_variable changed_;           ///< Signals a chunk queued, a chunk written, or stopping
+    std::vector<std::unique_ptr<Chunk>> full_;  ///< Chunks waiting to be written, oldest first
+    std::vector<std::unique_ptr<Chunk>> spare_; ///< Written chunks ready to be recorded into again
+    bool writing_;                              ///< The writer thread holds a chunk it is writing
+    bool stopping_;                             ///< The destructor asked the writer to finish
+    std::thread writer_;                        ///< Writes full_ chunks to file_ (started last)
+
+    /**
+     * @brief Queue the current chunk for writing and continue in a spare one
+     */
+    void submit();
+
+    /**
+     * @brief Writer thread: write queued chunks in order until stopped
+     */
+    void write_loop();
+
+    void write_chunk(const Chunk &chunk);
+};
@@ -0,0 +1,263 @@
+#include "maze.h"
+#include "systems.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @file micro_bench.cpp
+ * @brief Google Benchmark microbenchmarks for the movement, collision and AI primitives
+ *
+ * Usage: pacman_microbench [--benchmark_filter=REGEX] [--benchmark_repetitions=N] ...
+ *
+ * Each benchmark times a single call per iteration and is registered once
+ * per shipped maze (the "level" argument), cycling through inputs drawn
+ * from that maze so every cell is visited. Inputs are built before timing
+ * starts. Run it from the build directory, which links Resources/; use
+ * --benchmark_repetitions to judge whether a change beats the noise.
+ */
+
+using namespace MazeConfig;
+
+/**
+ * Microbenchmark configuration constants
+ */
+namespace MicroBenchConfig
+{
+    constexpr int LEVEL_COUNT = 5;
+    constexpr double OFF_CENTRE = 10.0; ///< Probe offset that reaches into neighbouring cells (pixels)
+    constexpr double NEAR_CENTRE = 2.0; ///< Offset within ALIGNMENT_TOLERANCE of the centre line
+    constexpr double FAR_CENTRE = 6.0;  ///< Offset beyond ALIGNMENT_TOLERANCE of the centre line
+    constexpr direction_t DIRECTIONS[] = {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT};
+}
+
+namespace
+{
+    /**
+     * A maze and the inputs drawn from it, shared by every benchmark run on that level
+     */
+    struct MazeFixture
+    {
+        Maze maze;
+        GameState game_state;                               ///< Tokens and pellets laid out as a new game does
+        std::vector<std::pair<double, double>> points;      ///< Cell centres and points nudged towards each neighbour
+        std::vector<std::pair<double, double>> edges;       ///< Midpoints between cells, out of every token's reach
+        std::vector<std::pair<int, int>> cells;             ///< Every cell plus a one-cell border around the maze
+        std::vector<std::pair<Transform, Movement>> movers; ///< Entities on or just off open cell centres
+
+        explicit MazeFixture(int level) : maze(level)
+        {
+            const auto [spawn_row, spawn_col] = Maze::find_spawn_position(maze, MAZE_ROWS / 2 + 3, MAZE_COLS / 2);
+            maze.initialize_tokens(game_state, spawn_row, spawn_col);
+            maze.initialize_power_pellets(game_state);
+
+            for (int row = -1; row <= MAZE_ROWS; row++)
+            {
+                for (int col = -1; col <= MAZE_COLS; col++)
+                {
+                    cells.push_back({row, col});
+                }
+            }
+
+            for (const auto &[row, col] : maze.get_walkable_cells())
+            {
+                const double x = Maze::get_cell_center_x(col);
+                const double y = Maze::get_cell_center_y(row);
+                points.push_back({x, y});
+                points.push_back({x - MicroBenchConfig::OFF_CENTRE, y});
+                points.push_back({x + MicroBenchConfig::OFF_CENTRE, y});
+                points.push_back({x, y - MicroBenchConfig::OFF_CENTRE});
+                points.push_back({x, y + MicroBenchConfig::OFF_CENTRE});
+
+                edges.push_back({x - CELL_SIZE / 2.0, y});
+                edges.push_back({x, y - CELL_SIZE / 2.0});
+
+                for (int d = 0; d < 4; d++)
+                {
+                    for (double offset : {0.0, MicroBenchConfig::NEAR_CENTRE, MicroBenchConfig::FAR_CENTRE})
+                    {
+                        Transform transform;
+                        transform.x = x + offset;
+                        transform.y = y - offset;
+                        Movement movement;
+                        movement.dir = MicroBenchConfig::DIRECTIONS[d];
+                        movement.desired_dir = MicroBenchConfig::DIRECTIONS[(d + 1) % 4];
+                        movers.push_back({transform, movement});
+                    }
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Fixture for a level (1-5), built on first use
+     */
+    const MazeFixture &fixture(int level)
+    {
+        static std::unique_ptr<MazeFixture> fixtures[MicroBenchConfig::LEVEL_COUNT];
+        std::unique_ptr<MazeFixture> &slot = fixtures[level - 1];
+        if (!slot)
+            slot = std::make_unique<MazeFixture>(level);
+        return *slot;
+    }
+
+    /**
+     * @brief Advance a cycling input index
+     */
+    inline std::size_t next(std::size_t i, std::size_t size)
+    {
+        return ++i == size ? 0 : i;
+    }
+
+    // ============== Maze ==============
+
+    void BM_MazeCanMoveTo(benchmark::State &state)
+    {
+        const MazeFixture &f = fixture(static_cast<int>(state.range(0)));
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(f.maze.can_move_to(f.points[i].first, f.points[i].second));
+            i = next(i, f.points.size());
+        }
+    }
+
+    void BM_MazeIsEmptyOrTunnel(benchmark::State &state)
+    {
+        const MazeFixture &f = fixture(static_cast<int>(state.range(0)));
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(f.maze.is_empty_or_tunnel(f.cells[i].first, f.cells[i].second));
+            i = next(i, f.cells.size());
+        }
+    }
+
+    // Targets include walls, so most calls search outward for the nearest open cell
+    void BM_MazeFindSpawnPosition(benchmark::State &state)
+    {
+        const MazeFixture &f = fixture(static_cast<int>(state.range(0)));
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(Maze::find_spawn_position(f.maze, f.cells[i].first, f.cells[i].second));
+            i = next(i, f.cells.size());
+        }
+    }
+
+    // ============== Movement ==============
+
+    void BM_AttemptDirectionChange(benchmark::State &state)
+    {
+        const MazeFixture &f = fixture(static_cast<int>(state.range(0)));
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            Transform transform = f.movers[i].first;
+            Movement movement = f.movers[i].second;
+            const int row = static_cast<int>(transform.y / CELL_SIZE);
+            const int col = static_cast<int>(transform.x / CELL_SIZE);
+            attempt_direction_change(transform, movement, f.maze, row, col, Maze::get_cell_center_x(col),
+                                     Maze::get_cell_center_y(row));
+            benchmark::DoNotOptimize(transform);
+            benchmark::DoNotOptimize(movement);
+            i = next(i, f.movers.size());
+        }
+    }
+
+    void BM_SnapToGridIfClose(benchmark::State &state)
+    {
+        const MazeFixture &f = fixture(static_cast<int>(state.range(0)));
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            Transform transform = f.movers[i].first;
+            const int row = static_cast<int>(transform.y / CELL_SIZE);
+            const int col = static_cast<int>(transform.x / CELL_SIZE);
+            snap_to_grid_if_close(transform, f.movers[i].second, Maze::get_cell_center_x(col),
+                                  Maze::get_cell_center_y(row));
+            benchmark::DoNotOptimize(transform);
+            i = next(i, f.movers.size());
+        }
+    }
+
+    // ============== Ghost AI ==============
+
+    // Each mover heads for a cell centre taken from elsewhere in the maze
+    void BM_ChooseDirectionTowardsTarget(benchmark::State &state)
+    {
+        const MazeFixture &f = fixture(static_cast<int>(state.range(0)));
+        std::size_t i = 0;
+        std::size_t target = f.points.size() / 2;
+        for (auto _ : state)
+        {
+            Movement movement = f.movers[i].second;
+            choose_direction_towards_target(f.movers[i].first, movement, f.maze, f.points[target].first,
+                                            f.points[target].second);
+            benchmark::DoNotOptimize(movement);
+            i = next(i, f.movers.size());
+            target = next(target, f.points.size());
+        }
+    }
+
+    void BM_FindEscapeTarget(benchmark::State &state)
+    {
+        const MazeFixture &f = fixture(static_cast<int>(state.range(0)));
+        std::size_t i = 0;
+        AIState ai;
+        for (auto _ : state)
+        {
+            ai.target_x = f.points[i].first;
+            ai.target_y = f.points[i].second;
+            find_escape_target(f.movers[i % f.movers.size()].first, ai, f.maze);
+            benchmark::DoNotOptimize(ai);
+            i = next(i, f.points.size());
+        }
+    }
+
+    // ============== Pellets ==============
+
+    // Probes sit between cells, so every call scans the full token list as most frames do
+    void BM_CheckTokenCollection(benchmark::State &state)
+    {
+        const MazeFixture &f = fixture(static_cast<int>(state.range(0)));
+        GameState game_state = f.game_state;
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(game_state.check_token_collection(f.edges[i].first, f.edges[i].second));
+            i = next(i, f.edges.size());
+        }
+        if (game_state.get_tokens_collected() != 0)
+            state.SkipWithError("a probe collected a token");
+    }
+}
+
+BENCHMARK(BM_MazeCanMoveTo)->ArgName("level")->DenseRange(1, MicroBenchConfig::LEVEL_COUNT);
+BENCHMARK(BM_MazeIsEmptyOrTunnel)->ArgName("level")->DenseRange(1, MicroBenchConfig::LEVEL_COUNT);
+BENCHMARK(BM_MazeFindSpawnPosition)->ArgName("level")->DenseRange(1, MicroBenchConfig::LEVEL_COUNT);
+BENCHMARK(BM_AttemptDirectionChange)->ArgName("level")->DenseRange(1, MicroBenchConfig::LEVEL_COUNT);
+BENCHMARK(BM_SnapToGridIfClose)->ArgName("level")->DenseRange(1, MicroBenchConfig::LEVEL_COUNT);
+BENCHMARK(BM_ChooseDirectionTowardsTarget)->ArgName("level")->DenseRange(1, MicroBenchConfig::LEVEL_COUNT);
+BENCHMARK(BM_FindEscapeTarget)->ArgName("level")->DenseRange(1, MicroBenchConfig::LEVEL_COUNT);
+BENCHMARK(BM_CheckTokenCollection)->ArgName("level")->DenseRange(1, MicroBenchConfig::LEVEL_COUNT);
+
+int main(int argc, char *argv[])
+{
+    // Without the maps every level would silently fall back to the built-in layout
+    if (!std::filesystem::exists("Resources/Maps/level1.csv"))
+    {
+        std::cerr << "Resources/Maps not found: run pacman_microbench from the build directory" << std::endl;
+        return 1;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
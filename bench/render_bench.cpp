@@ -0,0 +1,162 @@
+#include "headless.h"
+#include "bot.h"
+#include "game_config.h"
+#include "menu.h"
+#include "scene_renderer.h"
+#include "simulation.h"
+#include "spritesheet.h"
+#include "systems.h"
+#include "text_renderer.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+/**
+ * @file render_bench.cpp
+ * @brief Google Benchmark timings of frame drawing on the headless backend
+ *
+ * Usage: pacman_render_bench [--benchmark_filter=REGEX] [--benchmark_repetitions=N] ...
+ *
+ * Times a full in-game scene per level (maze, pellets, sprites and HUD), a
+ * full main menu repaint, HUD text and a trimmed, scaled sprite, all drawn
+ * into the headless framebuffer. The virtual clock is used so the menu's
+ * refresh_screen never sleeps. Run it from the build directory, which
+ * links Resources/.
+ */
+
+/**
+ * Render benchmark configuration constants
+ */
+namespace RenderBenchConfig
+{
+    constexpr int LEVEL_COUNT = 5;
+    constexpr int WARMUP_TICKS = 3 * GameConfig::SIMULATION_RATE; ///< Bot play before the scene is captured
+}
+
+namespace
+{
+    /**
+     * The window, sprite sheet and text renderer shared by every benchmark
+     */
+    struct RenderFixture
+    {
+        std::unique_ptr<SpriteSheet> sprite_sheet;
+        std::unique_ptr<TextRenderer> text_renderer;
+
+        RenderFixture()
+        {
+            headless_use_virtual_clock(true);
+            open_window(GameConfig::WINDOW_TITLE, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+            sprite_sheet = std::make_unique<SpriteSheet>(GameConfig::SPRITESHEET_NAME, GameConfig::SPRITESHEET_PATH,
+                                                         16, 16, 4, 3, 1, 2);
+            text_renderer = std::make_unique<TextRenderer>();
+        }
+    };
+
+    RenderFixture &fixture()
+    {
+        static RenderFixture shared;
+        return shared;
+    }
+
+    // ============== Scene ==============
+
+    void BM_SceneDraw(benchmark::State &state)
+    {
+        RenderFixture &f = fixture();
+        SceneRenderer scene_renderer(*f.sprite_sheet, *f.text_renderer);
+
+        // A few seconds into a bot game, so some pellets are gone and the ghosts are out
+        Simulation simulation;
+        PacmanBot bot;
+        SimulationSettings settings;
+        settings.seed = 1u;
+        simulation.new_game(static_cast<int>(state.range(0)), settings);
+        scene_renderer.reset(simulation.get_maze(), simulation.get_game_state());
+        for (int tick = 0; tick < RenderBenchConfig::WARMUP_TICKS; tick++)
+        {
+            bot.steer(simulation);
+            simulation.step(1.0 / GameConfig::SIMULATION_RATE);
+        }
+
+        RenderSnapshot snapshot;
+        snapshot_system(simulation.get_world(), snapshot);
+        GameState &game_state = simulation.get_game_state();
+        game_state.drain_collected_pellets(snapshot.collected_tokens, snapshot.collected_power_pellets);
+        snapshot.score = game_state.get_score();
+        snapshot.tokens_collected = game_state.get_tokens_collected();
+        snapshot.total_tokens = game_state.get_total_tokens();
+        scene_renderer.apply_collected(snapshot);
+        snapshot.collected_tokens.clear();
+        snapshot.collected_power_pellets.clear();
+
+        for (auto _ : state)
+        {
+            scene_renderer.draw(snapshot);
+            benchmark::ClobberMemory();
+        }
+    }
+
+    // ============== Menu ==============
+
+    void BM_MenuFullRedraw(benchmark::State &state)
+    {
+        RenderFixture &f = fixture();
+        Menu menu;
+        menu.set_sprite_sheet(f.sprite_sheet.get());
+        menu.set_text_renderer(f.text_renderer.get());
+
+        for (auto _ : state)
+        {
+            // Re-entering the screen forces a full repaint
+            menu.set_state(MenuState::MAIN_MENU);
+            benchmark::DoNotOptimize(menu.render());
+        }
+    }
+
+    // ============== Primitives ==============
+
+    void BM_TextRendererDraw(benchmark::State &state)
+    {
+        RenderFixture &f = fixture();
+        for (auto _ : state)
+        {
+            f.text_renderer->draw_text("SCORE: 123450", COLOR_WHITE, 24, 10, 10);
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void BM_TrimmedSpriteDraw(benchmark::State &state)
+    {
+        RenderFixture &f = fixture();
+        for (auto _ : state)
+        {
+            f.sprite_sheet->draw_sprite_at_pixel(PACMAN_PALETTE, 0, 0, 200, 200, MazeConfig::SPRITE_SCALE, true, false,
+                                                 true);
+            benchmark::ClobberMemory();
+        }
+    }
+}
+
+BENCHMARK(BM_SceneDraw)->ArgName("level")->DenseRange(1, RenderBenchConfig::LEVEL_COUNT);
+BENCHMARK(BM_MenuFullRedraw);
+BENCHMARK(BM_TextRendererDraw);
+BENCHMARK(BM_TrimmedSpriteDraw);
+
+int main(int argc, char *argv[])
+{
+    // Without the images every draw would silently do nothing
+    if (!std::filesystem::exists(GameConfig::SPRITESHEET_PATH))
+    {
+        std::cerr << "Resources/Images not found: run pacman_render_bench from the build directory" << std::endl;
+        return 1;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
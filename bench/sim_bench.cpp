@@ -0,0 +1,235 @@
+#include "simulation.h"
+#include "alloc_tracker.h"
+#include "bot.h"
+#include "game_config.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * @file sim_bench.cpp
+ * @brief Measures headless simulation throughput on every level
+ *
+ * Usage: pacman_bench [ticks_per_level] [seed] [--report FILE]
+ *
+ * The bot plays each of the five levels for the given number of fixed
+ * 60 Hz ticks, starting a new game with the next seed whenever Pac-Man
+ * dies or clears the maze. Only the simulation and the bot are timed:
+ * nothing is drawn and no SplashKit backend is linked, so the figures
+ * track the cost of the game rules alone.
+ *
+ * Besides throughput, every tick's latency and heap allocations are
+ * recorded (starting a new game is not counted). --report writes the
+ * results as "name value" lines for bench_compare. Built with
+ * PACMAN_ALLOC_TRACKING, the allocations are also broken down by subsystem.
+ */
+
+/**
+ * Benchmark configuration constants
+ */
+namespace BenchConfig
+{
+    constexpr int DEFAULT_TICKS_PER_LEVEL = 200000;
+    constexpr std::uint32_t DEFAULT_SEED = 1;
+    constexpr int LEVEL_COUNT = 5;
+}
+
+// ============== Allocation counting ==============
+
+// The tracker replaces operator new itself when enabled; otherwise a bare counter does
+#ifndef PACMAN_ALLOC_TRACKING
+namespace
+{
+    std::atomic<std::uint64_t> allocation_count{0}; ///< operator new calls since the program started
+}
+
+void *operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+#endif
+
+namespace
+{
+    std::uint64_t allocations_so_far()
+    {
+#ifdef PACMAN_ALLOC_TRACKING
+        return AllocTracker::snapshot().total_count();
+#else
+        return allocation_count.load(std::memory_order_relaxed);
+#endif
+    }
+}
+
+namespace
+{
+    /**
+     * Counts gathered while one level was played
+     */
+    struct LevelResult
+    {
+        int games = 0;                      ///< Games started, including the one still running at the end
+        double seconds = 0.0;               ///< Wall-clock time spent simulating
+        std::uint64_t allocations = 0;      ///< Heap allocations made during ticks
+        AllocStats tagged_allocations;      ///< The same, by subsystem (PACMAN_ALLOC_TRACKING only)
+        std::vector<std::uint32_t> tick_ns; ///< Latency of every tick, in nanoseconds
+    };
+
+    LevelResult run_level(int level, int ticks, std::uint32_t seed)
+    {
+        Simulation simulation;
+        PacmanBot bot;
+        SimulationSettings settings;
+        settings.seed = seed;
+
+        LevelResult result;
+        result.tick_ns.resize(ticks);
+        simulation.new_game(level, settings);
+        result.games = 1;
+
+        const double step_time = 1.0 / GameConfig::SIMULATION_RATE;
+        for (int i = 0; i < ticks; i++)
+        {
+            const AllocStats tagged_allocations = AllocTracker::ENABLED ? AllocTracker::snapshot() : AllocStats();
+            const std::uint64_t allocations = allocations_so_far();
+            const auto start = std::chrono::steady_clock::now();
+
+            bot.steer(simulation);
+            const StepEvents events = simulation.step(step_time);
+
+            const auto end = std::chrono::steady_clock::now();
+            result.allocations += allocations_so_far() - allocations;
+            if (AllocTracker::ENABLED)
+                result.tagged_allocations += AllocTracker::snapshot() - tagged_allocations;
+            result.tick_ns[i] = static_cast<std::uint32_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            result.seconds += std::chrono::duration<double>(end - start).count();
+
+            if (events.pacman_caught || events.level_cleared)
+            {
+                settings.seed++;
+                simulation.new_game(level, settings);
+                result.games++;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Latency below which the given fraction of ticks fall (sorts the samples)
+     */
+    double percentile(std::vector<std::uint32_t> &samples, double fraction)
+    {
+        std::sort(samples.begin(), samples.end());
+        const std::size_t index = std::min(samples.size() - 1, static_cast<std::size_t>(fraction * samples.size()));
+        return samples[index];
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> positional;
+    std::string report_path;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--report" && i + 1 < argc)
+            report_path = argv[++i];
+        else
+            positional.push_back(argument);
+    }
+
+    const int ticks = positional.size() > 0 ? std::max(1, std::atoi(positional[0].c_str()))
+                                            : BenchConfig::DEFAULT_TICKS_PER_LEVEL;
+    const std::uint32_t seed = positional.size() > 1
+                                   ? static_cast<std::uint32_t>(std::strtoul(positional[1].c_str(), nullptr, 10))
+                                   : BenchConfig::DEFAULT_SEED;
+
+    std::ofstream report;
+    if (!report_path.empty())
+    {
+        report.open(report_path);
+        if (!report.is_open())
+        {
+            std::cerr << "Failed to open report file " << report_path << "!" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    double total_seconds = 0.0;
+    std::uint64_t total_allocations = 0;
+    AllocStats tagged_allocations;
+    std::vector<std::uint32_t> all_tick_ns;
+    all_tick_ns.reserve(static_cast<std::size_t>(ticks) * BenchConfig::LEVEL_COUNT);
+    for (int level = 1; level <= BenchConfig::LEVEL_COUNT; level++)
+    {
+        LevelResult result = run_level(level, ticks, seed);
+        total_seconds += result.seconds;
+        total_allocations += result.allocations;
+        tagged_allocations += result.tagged_allocations;
+        all_tick_ns.insert(all_tick_ns.end(), result.tick_ns.begin(), result.tick_ns.end());
+
+        const double ticks_per_second = ticks / result.seconds;
+        const double allocations_per_tick = static_cast<double>(result.allocations) / ticks;
+        const double p99_ns = percentile(result.tick_ns, 0.99);
+        std::cout << "level " << level << ": " << ticks << " ticks, " << result.games << " games, "
+                  << result.seconds * 1000.0 << " ms, " << ticks_per_second << " ticks/s, "
+                  << result.seconds * 1e9 / ticks << " ns/tick, p99 " << p99_ns << " ns, "
+                  << std::setprecision(3) << allocations_per_tick << std::setprecision(1) << " allocs/tick"
+                  << std::endl;
+
+        if (report.is_open())
+        {
+            const std::string prefix = "level" + std::to_string(level) + ".";
+            report << prefix << "ticks_per_second " << ticks_per_second << "\n"
+                   << prefix << "allocations_per_tick " << allocations_per_tick << "\n"
+                   << prefix << "p99_tick_ns " << p99_ns << "\n";
+        }
+    }
+
+    const double total_ticks = static_cast<double>(ticks) * BenchConfig::LEVEL_COUNT;
+    const double allocations_per_tick = total_allocations / total_ticks;
+    const double p99_ns = percentile(all_tick_ns, 0.99);
+    std::cout << "total: " << total_ticks / total_seconds << " ticks/s, " << total_seconds * 1e9 / total_ticks
+              << " ns/tick, p99 " << p99_ns << " ns, " << std::setprecision(3) << allocations_per_tick
+              << " allocs/tick" << std::endl;
+
+    for (int tag = 0; tag < ALLOC_TAG_COUNT && AllocTracker::ENABLED; tag++)
+    {
+        if (tagged_allocations.count[tag] != 0)
+        {
+            std::cout << "  " << alloc_tag_name(static_cast<AllocTag>(tag)) << ": " << std::setprecision(3)
+                      << tagged_allocations.count[tag] / total_ticks << " allocs/tick, " << std::setprecision(1)
+                      << tagged_allocations.bytes[tag] / total_ticks << " bytes/tick" << std::endl;
+        }
+    }
+
+    if (report.is_open())
+    {
+        report << "total.ticks_per_second " << total_ticks / total_seconds << "\n"
+               << "total.allocations_per_tick " << allocations_per_tick << "\n"
+               << "total.p99_tick_ns " << p99_ns << "\n";
+    }
+    return 0;
+}
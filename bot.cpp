@@ -0,0 +1,251 @@
+#include "bot.h"
+#include "alloc_tracker.h"
+#include <cstdlib>
+#include <climits>
+
+/**
+ * @file bot.cpp
+ * @brief Implementation of the PacmanBot class
+ */
+
+using namespace MazeConfig;
+using namespace BotConfig;
+
+namespace
+{
+    constexpr direction_t SEARCH_ORDER[] = {DIR_LEFT, DIR_RIGHT, DIR_UP, DIR_DOWN};
+
+    /**
+     * @brief Whether an entity is a ghost that currently kills Pac-Man on contact
+     */
+    bool is_dangerous(const World &world, EntityId id)
+    {
+        return world.has(id, Component::TRANSFORM | Component::AI_STATE) && world.ai_state(id).state == GhostState::CHASING;
+    }
+
+    int cell_of(double position)
+    {
+        return static_cast<int>(position / CELL_SIZE);
+    }
+
+    /**
+     * @brief Direction from a position to the centre of its cell, or DIR_NONE when already there
+     */
+    direction_t towards_cell_center(double x, double y, int row, int col)
+    {
+        const double dx = Maze::get_cell_center_x(col) - x;
+        const double dy = Maze::get_cell_center_y(row) - y;
+        if (std::abs(dx) < 1.0 && std::abs(dy) < 1.0)
+            return DIR_NONE;
+        if (std::abs(dx) >= std::abs(dy))
+            return dx > 0 ? DIR_RIGHT : DIR_LEFT;
+        return dy > 0 ? DIR_DOWN : DIR_UP;
+    }
+}
+
+direction_t PacmanBot::choose_direction(const Maze &maze, const GameState &game_state, const World &world, EntityId pacman)
+{
+    AllocScope alloc_scope(AllocTag::BOT);
+    const int row = cell_of(world.transform(pacman).y);
+    const int col = cell_of(world.transform(pacman).x);
+
+    // Pac-Man is briefly outside the grid while passing through the tunnel
+    if (col < 0 || col >= MAZE_COLS)
+        return world.movement(pacman).dir;
+
+    mark_goals(game_state, world);
+    mark_danger(world);
+
+    // A pellet in Pac-Man's own cell is only eaten near its centre, and the search starts beyond this cell:
+    // finish the cell first, or Pac-Man turns back at the cell boundary and dithers across it forever
+    const int start = cell_index(row, col);
+    if (goal_[start] && !danger_[start])
+    {
+        const direction_t to_center = towards_cell_center(world.transform(pacman).x, world.transform(pacman).y, row, col);
+        if (to_center != DIR_NONE)
+            return to_center;
+    }
+
+    direction_t dir = search(maze, row, col);
+    if (dir == DIR_NONE)
+        dir = flee(maze, row, col, world);
+    return dir;
+}
+
+void PacmanBot::steer(Simulation &simulation)
+{
+    const Pacman &pacman = simulation.get_pacman();
+    const World &world = simulation.get_world();
+    const direction_t dir = choose_direction(simulation.get_maze(), simulation.get_game_state(), world, pacman.get_id());
+
+    // Holding the key already pressed needs no new input; with nowhere to go the last key stays held
+    if (dir != DIR_NONE && dir != world.movement(pacman.get_id()).desired_dir)
+        simulation.apply_input(dir);
+}
+
+void PacmanBot::mark_goals(const GameState &game_state, const World &world)
+{
+    goal_.fill(false);
+
+    for (const Token &token : game_state.get_tokens())
+    {
+        if (!token.is_collected())
+            goal_[cell_index(token.get_row(), token.get_col())] = true;
+    }
+
+    for (const PowerPellet &pellet : game_state.get_power_pellets())
+    {
+        if (!pellet.is_collected())
+            goal_[cell_index(pellet.get_row(), pellet.get_col())] = true;
+    }
+
+    // Scared ghosts are worth chasing
+    for (EntityId id = 0; id < world.size(); id++)
+    {
+        if (!world.has(id, Component::TRANSFORM | Component::AI_STATE) || world.ai_state(id).state != GhostState::SCARED)
+            continue;
+
+        const int row = cell_of(world.transform(id).y);
+        const int col = cell_of(world.transform(id).x);
+        if (row >= 0 && row < MAZE_ROWS && col >= 0 && col < MAZE_COLS)
+            goal_[cell_index(row, col)] = true;
+    }
+}
+
+void PacmanBot::mark_danger(const World &world)
+{
+    danger_.fill(false);
+
+    for (EntityId id = 0; id < world.size(); id++)
+    {
+        if (!is_dangerous(world, id))
+            continue;
+
+        const int ghost_row = cell_of(world.transform(id).y);
+        const int ghost_col = cell_of(world.transform(id).x);
+        for (int row = ghost_row - DANGER_RADIUS; row <= ghost_row + DANGER_RADIUS; row++)
+        {
+            for (int col = ghost_col - DANGER_RADIUS; col <= ghost_col + DANGER_RADIUS; col++)
+            {
+                if (std::abs(row - ghost_row) + std::abs(col - ghost_col) > DANGER_RADIUS)
+                    continue;
+                if (row >= 0 && row < MAZE_ROWS && col >= 0 && col < MAZE_COLS)
+                    danger_[cell_index(row, col)] = true;
+            }
+        }
+    }
+}
+
+direction_t PacmanBot::search(const Maze &maze, int start_row, int start_col)
+{
+    first_step_.fill(DIR_NONE);
+
+    int head = 0;
+    int tail = 0;
+
+    // Seed the queue with the safe neighbours of Pac-Man's cell
+    for (direction_t dir : SEARCH_ORDER)
+    {
+        int next_row, next_col;
+        if (!step(maze, start_row, start_col, dir, next_row, next_col))
+            continue;
+
+        const int next = cell_index(next_row, next_col);
+        if (danger_[next] || first_step_[next] != DIR_NONE)
+            continue;
+
+        first_step_[next] = dir;
+        queue_[tail++] = next;
+    }
+
+    while (head < tail)
+    {
+        const int current = queue_[head++];
+        if (goal_[current])
+            return first_step_[current];
+
+        const int row = current / MAZE_COLS;
+        const int col = current % MAZE_COLS;
+        for (direction_t dir : SEARCH_ORDER)
+        {
+            int next_row, next_col;
+            if (!step(maze, row, col, dir, next_row, next_col))
+                continue;
+
+            const int next = cell_index(next_row, next_col);
+            if (danger_[next] || first_step_[next] != DIR_NONE || (next_row == start_row && next_col == start_col))
+                continue;
+
+            first_step_[next] = first_step_[current];
+            queue_[tail++] = next;
+        }
+    }
+
+    return DIR_NONE;
+}
+
+direction_t PacmanBot::flee(const Maze &maze, int start_row, int start_col, const World &world) const
+{
+    direction_t best_dir = DIR_NONE;
+    int best_distance = -1;
+
+    for (direction_t dir : SEARCH_ORDER)
+    {
+        int next_row, next_col;
+        if (!step(maze, start_row, start_col, dir, next_row, next_col))
+            continue;
+
+        // Distance to the closest chasing ghost from the candidate cell
+        int closest = INT_MAX;
+        for (EntityId id = 0; id < world.size(); id++)
+        {
+            if (!is_dangerous(world, id))
+                continue;
+
+            const int distance = std::abs(next_row - cell_of(world.transform(id).y)) + std::abs(next_col - cell_of(world.transform(id).x));
+            closest = std::min(closest, distance);
+        }
+
+        if (closest > best_distance)
+        {
+            best_distance = closest;
+            best_dir = dir;
+        }
+    }
+
+    return best_dir;
+}
+
+bool PacmanBot::step(const Maze &maze, int row, int col, direction_t dir, int &next_row, int &next_col)
+{
+    next_row = row;
+    next_col = col;
+    switch (dir)
+    {
+    case DIR_LEFT:
+        next_col--;
+        break;
+    case DIR_RIGHT:
+        next_col++;
+        break;
+    case DIR_UP:
+        next_row--;
+        break;
+    case DIR_DOWN:
+        next_row++;
+        break;
+    default:
+        return false;
+    }
+
+    if (!maze.is_empty_or_tunnel(next_row, next_col))
+        return false;
+
+    // Wrap through the side tunnel
+    if (next_col < 0)
+        next_col = MAZE_COLS - 1;
+    else if (next_col >= MAZE_COLS)
+        next_col = 0;
+
+    return maze.is_empty(next_row, next_col);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "maze.h"
+#include "world.h"
+#include "simulation.h"
+#include "direction.h"
+#include <array>
+
+/**
+ * @file bot.h
+ * @brief Computer player that steers Pac-Man
+ *
+ * This file contains the PacmanBot class, which plays the game in attract
+ * (demo) mode and in headless tools by pressing direction keys each
+ * simulation step.
+ */
+
+/**
+ * Bot configuration constants
+ */
+namespace BotConfig
+{
+    constexpr int DANGER_RADIUS = 2; ///< Cells around a chasing ghost the bot will not path through
+}
+
+/**
+ * @class PacmanBot
+ * @brief Greedy pellet-collecting player that avoids chasing ghosts
+ *
+ * Each decision runs a breadth-first search over the maze grid from
+ * Pac-Man's cell to the nearest uncollected token, power pellet or scared
+ * ghost, treating cells close to a chasing ghost as walls. When no safe path
+ * exists the bot moves to the neighbouring cell furthest from danger.
+ * A pellet in Pac-Man's own cell is eaten before anything else: the search
+ * starts beyond that cell, so without this the bot would turn back at the
+ * cell boundary towards the pellet and then away again, forever.
+ *
+ * All search storage is fixed-size and owned by the bot, so choosing a
+ * direction never allocates.
+ */
+class PacmanBot
+{
+public:
+    PacmanBot() = default;
+
+    /**
+     * @brief Choose the direction Pac-Man should head in next
+     * @param maze The maze being played
+     * @param game_state Token and power pellet state
+     * @param world Entity storage; every entity with an AIState is treated as a ghost
+     * @param pacman Entity id of the player character being steered
+     * @return Desired direction, or DIR_NONE if Pac-Man cannot move
+     */
+    direction_t choose_direction(const Maze &maze, const GameState &game_state, const World &world, EntityId pacman);
+
+    /**
+     * @brief Choose Pac-Man's next direction and press it through Simulation::apply_input, as a player would
+     * The key is only pressed when the choice changes, so the bot takes the same buffered-turn path as the keyboard.
+     * @param simulation Game being played
+     */
+    void steer(Simulation &simulation);
+
+private:
+    static constexpr int CELL_COUNT = MazeConfig::MAZE_ROWS * MazeConfig::MAZE_COLS;
+
+    std::array<bool, CELL_COUNT> goal_;              ///< Cells worth moving towards
+    std::array<bool, CELL_COUNT> danger_;            ///< Cells near a chasing ghost
+    std::array<int, CELL_COUNT> queue_;              ///< BFS queue of cell indices
+    std::array<direction_t, CELL_COUNT> first_step_; ///< First move on the path to each cell (DIR_NONE = unvisited)
+
+    void mark_goals(const GameState &game_state, const World &world);
+    void mark_danger(const World &world);
+    direction_t search(const Maze &maze, int start_row, int start_col);
+    direction_t flee(const Maze &maze, int start_row, int start_col, const World &world) const;
+    static bool step(const Maze &maze, int row, int col, direction_t dir, int &next_row, int &next_col);
+    static int cell_index(int row, int col) { return row * MazeConfig::MAZE_COLS + col; }
+};
@@ -0,0 +1,63 @@
+#include "bot_games.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file bot_games.cpp
+ * @brief Implementation of parallel bot game batches and their summaries
+ */
+
+std::uint32_t bot_step_limit(int max_seconds, double speed_multiplier)
+{
+    return static_cast<std::uint32_t>(std::lround(max_seconds * GameConfig::SIMULATION_RATE / speed_multiplier));
+}
+
+std::vector<BotGameResult> play_bot_batch(const BotBatch &batch, int thread_count)
+{
+    return play_bot_batch(batch, thread_count, [](int, const Simulation &, const StepEvents &) {});
+}
+
+BotBatchSummary summarize_bot_batch(const std::vector<BotGameResult> &results)
+{
+    BotBatchSummary summary;
+    summary.games = static_cast<int>(results.size());
+    if (results.empty())
+        return summary;
+
+    std::vector<std::uint32_t> survival_steps;
+    double total_score = 0.0;
+    double total_steps = 0.0;
+    int cleared = 0;
+    for (const BotGameResult &result : results)
+    {
+        total_score += result.score;
+        total_steps += result.steps;
+        if (result.outcome == BotGameOutcome::CLEARED)
+            cleared++;
+        else if (result.outcome == BotGameOutcome::CAUGHT)
+            survival_steps.push_back(result.steps);
+    }
+
+    const double games = static_cast<double>(results.size());
+    const double rate = GameConfig::SIMULATION_RATE;
+    summary.clear_rate = cleared / games;
+    summary.caught_rate = survival_steps.size() / games;
+    summary.timed_out_rate = (results.size() - cleared - survival_steps.size()) / games;
+    summary.mean_score = total_score / games;
+    summary.mean_seconds = total_steps / games / rate;
+
+    if (!survival_steps.empty())
+    {
+        std::sort(survival_steps.begin(), survival_steps.end());
+        const auto percentile = [&survival_steps, rate](double fraction)
+        {
+            const std::size_t index = std::min(survival_steps.size() - 1,
+                                               static_cast<std::size_t>(fraction * survival_steps.size()));
+            return survival_steps[index] / rate;
+        };
+        summary.survival_p10 = percentile(0.1);
+        summary.survival_p50 = percentile(0.5);
+        summary.survival_p90 = percentile(0.9);
+    }
+    return summary;
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "bot.h"
+#include "game_config.h"
+#include "simulation.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @file bot_games.h
+ * @brief Headless games played by the bot, one at a time or in parallel batches
+ *
+ * Balancing tools judge a level, a difficulty or a set of ghost constants
+ * by how the bot fares over many games. play_bot_game plays one game to
+ * its end; play_bot_batch spreads a batch of games over worker threads,
+ * each with its own Simulation and bot. A game's seed depends only on its
+ * place in the batch, so results do not depend on the thread count.
+ */
+
+/**
+ * Bot game configuration constants
+ */
+namespace BotGamesConfig
+{
+    constexpr int DEFAULT_MAX_SECONDS = 300; ///< Games the bot neither wins nor loses are cut off here, at speed 1
+}
+
+/**
+ * How a bot game ended
+ */
+enum class BotGameOutcome : std::uint8_t
+{
+    CAUGHT,   ///< A chasing ghost caught Pac-Man
+    CLEARED,  ///< Every token was eaten
+    TIMED_OUT ///< Neither happened within the step limit
+};
+
+/**
+ * One finished bot game
+ */
+struct BotGameResult
+{
+    std::uint32_t seed = 0;  ///< Seed the game was played with
+    std::uint32_t steps = 0; ///< Simulation steps played, at GameConfig::SIMULATION_RATE
+    int score = 0;
+    BotGameOutcome outcome = BotGameOutcome::TIMED_OUT;
+};
+
+/**
+ * @brief Steps after which a bot game is cut off
+ * Slower games take longer to clear, so the cutoff stretches by 1 / speed_multiplier.
+ * @param max_seconds Cutoff for a game at speed multiplier 1
+ * @param speed_multiplier Speed the game is played at
+ */
+std::uint32_t bot_step_limit(int max_seconds, double speed_multiplier);
+
+/**
+ * @brief Play a single-level game with the bot steering Pac-Man
+ * @param simulation Simulation to play in; restarted with new_game
+ * @param bot Bot to steer with
+ * @param level Level to play (1-5)
+ * @param settings Seed, palette and speed of the game
+ * @param max_steps Steps after which the game is cut off
+ * @param on_step Called as on_step(simulation, events) after every step
+ */
+template <typename OnStep>
+BotGameResult play_bot_game(Simulation &simulation, PacmanBot &bot, int level, const SimulationSettings &settings,
+                            std::uint32_t max_steps, OnStep &&on_step)
+{
+    const double step_time = 1.0 / GameConfig::SIMULATION_RATE;
+    simulation.new_game(level, settings);
+
+    BotGameResult result;
+    result.seed = settings.seed;
+    while (result.steps < max_steps)
+    {
+        bot.steer(simulation);
+        const StepEvents events = simulation.step(step_time);
+        result.steps++;
+        on_step(static_cast<const Simulation &>(simulation), events);
+
+        if (events.pacman_caught || events.level_cleared)
+        {
+            result.outcome = events.pacman_caught ? BotGameOutcome::CAUGHT : BotGameOutcome::CLEARED;
+            break;
+        }
+    }
+    result.score = simulation.get_game_state().get_score();
+    return result;
+}
+
+/**
+ * @brief Play a single-level game with the bot steering Pac-Man, with nothing to do between steps
+ */
+inline BotGameResult play_bot_game(Simulation &simulation, PacmanBot &bot, int level,
+                                   const SimulationSettings &settings, std::uint32_t max_steps)
+{
+    return play_bot_game(simulation, bot, level, settings, max_steps, [](const Simulation &, const StepEvents &) {});
+}
+
+/**
+ * Games played with the same level and settings, apart from the seed
+ */
+struct BotBatch
+{
+    int level = 1;
+    SimulationSettings settings; ///< Game i is played with seed settings.seed + i
+    int games = 0;
+    std::uint32_t max_steps = BotGamesConfig::DEFAULT_MAX_SECONDS * GameConfig::SIMULATION_RATE;
+};
+
+/**
+ * @brief Number of worker threads play_bot_batch uses for a batch
+ * @param batch Games to play
+ * @param thread_count Worker threads asked for
+ */
+inline int bot_batch_workers(const BotBatch &batch, int thread_count)
+{
+    return std::max(1, std::min(thread_count, batch.games));
+}
+
+/**
+ * @brief Play a batch of games over worker threads, calling a hook after every step
+ * Threads take the next unplayed game as they finish one, so long and short games even out.
+ * @param batch Games to play
+ * @param thread_count Worker threads to use (at least one)
+ * @param on_step Called as on_step(worker, simulation, events) after every step. worker is the
+ *                playing thread's index, below bot_batch_workers(), so each thread can count into
+ *                its own state without locking
+ * @return One result per game, in seed order
+ */
+template <typename OnStep>
+std::vector<BotGameResult> play_bot_batch(const BotBatch &batch, int thread_count, OnStep &&on_step)
+{
+    std::vector<BotGameResult> results(std::max(0, batch.games));
+    std::atomic<int> next_game{0};
+
+    // Each worker writes only the results of the games it took, so only the game counter is shared
+    const auto work = [&batch, &results, &next_game, &on_step](int worker)
+    {
+        Simulation simulation;
+        PacmanBot bot;
+        SimulationSettings settings = batch.settings;
+        for (int game = next_game++; game < batch.games; game = next_game++)
+        {
+            settings.seed = batch.settings.seed + static_cast<std::uint32_t>(game);
+            results[game] = play_bot_game(simulation, bot, batch.level, settings, batch.max_steps,
+                                          [&on_step, worker](const Simulation &played, const StepEvents &events)
+                                          { on_step(worker, played, events); });
+        }
+    };
+
+    const int workers = bot_batch_workers(batch, thread_count);
+    std::vector<std::thread> threads;
+    for (int i = 1; i < workers; i++)
+    {
+        threads.emplace_back(work, i);
+    }
+    work(0);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    return results;
+}
+
+/**
+ * @brief Play a batch of games over worker threads, with nothing to do between steps
+ */
+std::vector<BotGameResult> play_bot_batch(const BotBatch &batch, int thread_count);
+
+/**
+ * What a batch of games says about how hard its setting is
+ */
+struct BotBatchSummary
+{
+    int games = 0;
+    double clear_rate = 0.0;     ///< Fraction of games the bot cleared
+    double caught_rate = 0.0;    ///< Fraction of games the bot was caught in
+    double timed_out_rate = 0.0; ///< Fraction of games cut off with neither (the bot survived but did not clear)
+    double mean_score = 0.0;
+    double mean_seconds = 0.0;   ///< Mean game length, however it ended
+    /// Seconds survived in caught games: 10th, 50th and 90th percentile (0 if none were caught)
+    double survival_p10 = 0.0, survival_p50 = 0.0, survival_p90 = 0.0;
+};
+
+/**
+ * @brief Summarize a batch's results
+ */
+BotBatchSummary summarize_bot_batch(const std::vector<BotGameResult> &results);
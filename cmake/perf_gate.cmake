@@ -0,0 +1,75 @@
+# Simulation throughput regression gate
+#
+# Usage (from the project root): cmake -DBASELINE=<git ref> -P cmake/perf_gate.cmake
+#
+# 1. Checks the baseline ref out into a git worktree under build/perf-baseline
+# 2. Builds pacman_bench there and in the release preset of the current tree
+# 3. Runs bench_compare on the two, from the current build directory, and fails
+#    when ticks/s, allocations/tick or p99 tick latency regressed significantly
+#
+# Optional variables (-D before -P): BASELINE (default HEAD, so uncommitted changes
+# are what is measured), and PERF_RUNS, PERF_TICKS and PERF_THRESHOLD (percent),
+# passed on to bench_compare. The baseline must be a revision whose pacman_bench
+# accepts --report.
+
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+set(CURRENT_DIR "${SOURCE_DIR}/build/release")
+set(BASELINE_SOURCE_DIR "${SOURCE_DIR}/build/perf-baseline/src")
+set(BASELINE_BUILD_DIR "${SOURCE_DIR}/build/perf-baseline/build")
+if(NOT BASELINE)
+    set(BASELINE HEAD)
+endif()
+if(NOT PERF_RUNS)
+    set(PERF_RUNS 5)
+endif()
+if(NOT PERF_TICKS)
+    set(PERF_TICKS 50000)
+endif()
+if(NOT PERF_THRESHOLD)
+    set(PERF_THRESHOLD 5)
+endif()
+
+function(run_step description)
+    message(STATUS "Perf gate: ${description}")
+    execute_process(COMMAND ${ARGN} WORKING_DIRECTORY "${SOURCE_DIR}" RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Perf gate: ${description} failed (${result})")
+    endif()
+endfunction()
+
+find_program(GIT_EXECUTABLE NAMES git)
+if(NOT GIT_EXECUTABLE)
+    message(FATAL_ERROR "Perf gate: git is needed to check out the baseline")
+endif()
+
+# A fresh worktree each time, so the baseline is exactly the requested ref
+if(EXISTS "${BASELINE_SOURCE_DIR}")
+    execute_process(COMMAND "${GIT_EXECUTABLE}" worktree remove --force "${BASELINE_SOURCE_DIR}"
+                    WORKING_DIRECTORY "${SOURCE_DIR}")
+    file(REMOVE_RECURSE "${BASELINE_SOURCE_DIR}")
+endif()
+run_step("check out ${BASELINE}" "${GIT_EXECUTABLE}" worktree add --detach "${BASELINE_SOURCE_DIR}" "${BASELINE}")
+
+run_step("configure baseline" "${CMAKE_COMMAND}" -S "${BASELINE_SOURCE_DIR}" -B "${BASELINE_BUILD_DIR}"
+         -DCMAKE_BUILD_TYPE=Release -DPACMAN_BUILD_TESTS=OFF)
+run_step("build baseline" "${CMAKE_COMMAND}" --build "${BASELINE_BUILD_DIR}" --target pacman_bench)
+
+run_step("configure current" "${CMAKE_COMMAND}" --preset release)
+run_step("build current" "${CMAKE_COMMAND}" --build --preset release --target pacman_bench bench_compare)
+
+# Both builds play the current tree's mazes, linked into its build directory
+message(STATUS "Perf gate: comparing against ${BASELINE}")
+execute_process(COMMAND "${CURRENT_DIR}/bench_compare" "${BASELINE_BUILD_DIR}/pacman_bench"
+                        "${CURRENT_DIR}/pacman_bench" --runs "${PERF_RUNS}" --ticks "${PERF_TICKS}"
+                        --threshold "${PERF_THRESHOLD}"
+                WORKING_DIRECTORY "${CURRENT_DIR}" RESULT_VARIABLE result)
+
+execute_process(COMMAND "${GIT_EXECUTABLE}" worktree remove --force "${BASELINE_SOURCE_DIR}"
+                WORKING_DIRECTORY "${SOURCE_DIR}")
+
+if(result EQUAL 1)
+    message(FATAL_ERROR "Perf gate: throughput regressed against ${BASELINE}")
+elseif(NOT result EQUAL 0)
+    message(FATAL_ERROR "Perf gate: bench_compare failed (${result})")
+endif()
+message(STATUS "Perf gate: no regression against ${BASELINE}")
@@ -0,0 +1,72 @@
+# Profile-guided optimization pipeline
+#
+# Usage (from the project root): cmake -P cmake/pgo.cmake
+#
+# 1. Configures and builds the instrumented pgo-generate preset
+# 2. Trains it by replaying the recorded corpus in Resources/Replays headlessly
+#    (every level at every difficulty), plus a short replay_export run to profile
+#    drawing when the headless backend is in use
+# 3. Merges the profiles (Clang only)
+# 4. Configures and builds the pgo-use preset from those profiles
+#
+# Optional variables (-D before -P): PGO_CORPUS to train on another replay directory,
+# PGO_REPEAT to play the corpus more than once.
+
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+set(GENERATE_DIR "${SOURCE_DIR}/build/pgo-generate")
+set(PROFILE_DIR "${SOURCE_DIR}/build/pgo-profiles")
+if(NOT PGO_CORPUS)
+    set(PGO_CORPUS "${SOURCE_DIR}/Resources/Replays")
+endif()
+if(NOT PGO_REPEAT)
+    set(PGO_REPEAT 1)
+endif()
+
+function(run_step description)
+    message(STATUS "PGO: ${description}")
+    execute_process(COMMAND ${ARGN} WORKING_DIRECTORY "${SOURCE_DIR}" RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "PGO: ${description} failed (${result})")
+    endif()
+endfunction()
+
+# Profiles from an older build would not match the new instrumentation
+file(REMOVE_RECURSE "${PROFILE_DIR}")
+
+run_step("configure instrumented build" "${CMAKE_COMMAND}" --preset pgo-generate)
+run_step("build instrumented build" "${CMAKE_COMMAND}" --build --preset pgo-generate)
+
+# Training runs from the build directory, which links Resources/
+message(STATUS "PGO: training on ${PGO_CORPUS}")
+execute_process(COMMAND "${GENERATE_DIR}/replay_run" "${PGO_CORPUS}" --repeat "${PGO_REPEAT}"
+                WORKING_DIRECTORY "${GENERATE_DIR}" RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "PGO: replay_run failed (${result})")
+endif()
+
+if(EXISTS "${GENERATE_DIR}/replay_export" OR EXISTS "${GENERATE_DIR}/replay_export.exe")
+    file(GLOB corpus_replays "${PGO_CORPUS}/*.txt")
+    list(SORT corpus_replays)
+    list(GET corpus_replays 0 first_replay)
+    set(export_output "${GENERATE_DIR}/pgo-training.y4m")
+    execute_process(COMMAND "${GENERATE_DIR}/replay_export" "${first_replay}" "${export_output}" y4m 60
+                    WORKING_DIRECTORY "${GENERATE_DIR}" RESULT_VARIABLE result)
+    file(REMOVE "${export_output}")
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "PGO: replay_export failed (${result})")
+    endif()
+endif()
+
+# Clang writes raw profiles that have to be merged; GCC's .gcda files are used as they are
+file(GLOB raw_profiles "${PROFILE_DIR}/*.profraw")
+if(raw_profiles)
+    find_program(LLVM_PROFDATA NAMES llvm-profdata)
+    if(NOT LLVM_PROFDATA)
+        message(FATAL_ERROR "PGO: llvm-profdata is needed to merge Clang profiles")
+    endif()
+    run_step("merge profiles" "${LLVM_PROFDATA}" merge -o "${PROFILE_DIR}/pacman.profdata" ${raw_profiles})
+endif()
+
+run_step("configure optimized build" "${CMAKE_COMMAND}" --preset pgo-use)
+run_step("build optimized build" "${CMAKE_COMMAND}" --build --preset pgo-use)
+message(STATUS "PGO: optimized build is in ${SOURCE_DIR}/build/pgo-use")
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "direction.h"
+#include "timer_wheel.h"
+#include "palette.h"
+#include <cstdint>
+
+/**
+ * @file components.h
+ * @brief Component types stored by the World
+ *
+ * Every game object (Pac-Man, ghosts, fruit) is an entity id with a mask of
+ * the components it owns. Components are plain data; all behaviour lives in
+ * the systems (systems.h), which iterate the component arrays linearly.
+ */
+
+using EntityId = std::uint32_t; ///< Index of an entity slot in the World
+
+/**
+ * Component mask bits
+ */
+namespace Component
+{
+    constexpr std::uint32_t TRANSFORM = 1u << 0; ///< Position in pixels
+    constexpr std::uint32_t MOVEMENT = 1u << 1;  ///< Grid movement along the maze
+    constexpr std::uint32_t ANIMATION = 1u << 2; ///< Animated by its sprite kind's shared clock
+    constexpr std::uint32_t SPRITE = 1u << 3;    ///< Drawn from the sprite sheet
+    constexpr std::uint32_t AI_STATE = 1u << 4;  ///< Ghost behaviour and state timers
+    constexpr std::uint32_t POPUP = 1u << 5;     ///< Temporary score popup
+    constexpr std::uint32_t BONUS = 1u << 6;     ///< Timed bonus item (fruit)
+}
+
+/**
+ * Ghost state enumeration for different AI behaviors
+ */
+enum class GhostState
+{
+    CHASING, // Normal behavior - chase Pacman
+    SCARED,  // Power mode - run away from Pacman
+    CAUGHT,  // Returning to center after being caught
+    COOLDOWN // Waiting at home before resuming chase
+};
+
+/**
+ * Ghost AI behavior types
+ */
+enum class GhostAIType
+{
+    RANDOM_PATROL, ///< Wanders randomly, locks on when close to Pacman
+    AMBUSHER       ///< Aims ahead of Pacman, chases when close
+};
+
+/**
+ * Which set of sprites an entity is drawn with
+ */
+enum class SpriteKind
+{
+    PACMAN,
+    GHOST,
+    FRUIT,
+    COUNT
+};
+
+struct Transform
+{
+    double x = 0.0; ///< Centre x (pixels)
+    double y = 0.0; ///< Centre y (pixels)
+};
+
+struct Movement
+{
+    direction_t dir = DIR_NONE;         ///< Current movement direction
+    direction_t desired_dir = DIR_NONE; ///< Direction to turn into when possible
+    double speed_multiplier = 1.0;      ///< Difficulty-based speed multiplier
+    double speed_boost = 1.0;           ///< State-based boost (power mode, caught ghost)
+    std::uint64_t turn_deadline = 0;    ///< Tick after which an untaken desired_dir is dropped (0 = held)
+    bool on_grid = true;                ///< false while another system moves the entity directly
+};
+
+/**
+ * Animation clock shared by every entity of one sprite kind
+ */
+struct Animation
+{
+    int frame = 0;      ///< Current frame index
+    double timer = 0.0; ///< Time spent on the current frame (seconds)
+};
+
+struct Sprite
+{
+    SpriteKind kind = SpriteKind::PACMAN;
+    PaletteId palette = PaletteId::YELLOW_PINK_SKY; ///< Base colour palette
+    int variant = 0;                                ///< Frame for kinds without animation (fruit type)
+    bool visible = true;
+};
+
+struct AIState
+{
+    GhostAIType type = GhostAIType::RANDOM_PATROL;
+    GhostState state = GhostState::CHASING;
+    double target_x = 0.0, target_y = 0.0;               ///< Pac-Man's position to chase
+    double escape_target_x = 0.0, escape_target_y = 0.0; ///< Target position when running away
+    double home_x = 0.0, home_y = 0.0;                   ///< Centre spawn position
+    double scared_duration = 0.0;                        ///< Scared duration for the current difficulty
+    direction_t random_target_dir = DIR_RIGHT;           ///< Current random direction for patrol
+    bool random_dir_change_due = false;                  ///< Set by random_dir_timer
+    TimerId scared_timer = 0;                            ///< Ends scared mode
+    TimerId cooldown_timer = 0;                          ///< Ends cooldown after returning home
+    TimerId random_dir_timer = 0;                        ///< Flags a patrol direction change
+};
+
+struct Popup
+{
+    bool visible = false;
+    double x = 0.0, y = 0.0; ///< Popup position (pixels)
+    int sprite_col = 0;      ///< Score sprite column
+    int sprite_row = 0;      ///< Score sprite row
+    TimerId timer = 0;       ///< Hides the popup
+};
+
+struct Bonus
+{
+    bool active = false;       ///< Whether the item is currently collectable
+    bool spawn_due = false;    ///< Set when the spawn timer fires
+    int points = 0;            ///< Points awarded on collection
+    TimerId spawn_timer = 0;   ///< Fires when the next item should spawn
+    TimerId visible_timer = 0; ///< Hides an uncollected item
+};
@@ -0,0 +1,142 @@
+#include "danger_map.h"
+#include "simulation.h"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+/**
+ * @file danger_map.cpp
+ * @brief Implementation of the DangerMap class and heat grid files
+ */
+
+using namespace MazeConfig;
+
+const char *danger_layer_name(DangerLayer layer)
+{
+    switch (layer)
+    {
+    case DangerLayer::DEATHS:
+        return "deaths";
+    case DangerLayer::PACMAN_DWELL:
+        return "pacman_dwell";
+    case DangerLayer::GHOST_CHASING:
+        return "ghost_chasing";
+    case DangerLayer::GHOST_SCARED:
+        return "ghost_scared";
+    case DangerLayer::GHOST_CAUGHT:
+        return "ghost_caught";
+    case DangerLayer::GHOST_COOLDOWN:
+        return "ghost_cooldown";
+    default:
+        return "?";
+    }
+}
+
+bool save_heat_grid(const std::string &path, const HeatGrid &grid)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+        return false;
+
+    for (const auto &row : grid)
+    {
+        for (int col = 0; col < MAZE_COLS; col++)
+        {
+            file << (col > 0 ? "," : "") << row[col];
+        }
+        file << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool load_heat_grid(const std::string &path, HeatGrid &grid)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    std::string line;
+    for (int row = 0; row < MAZE_ROWS; row++)
+    {
+        if (!std::getline(file, line))
+            return false;
+
+        std::istringstream cells(line);
+        std::string cell;
+        for (int col = 0; col < MAZE_COLS; col++)
+        {
+            if (!std::getline(cells, cell, ','))
+                return false;
+            try
+            {
+                grid[row][col] = std::stoull(cell);
+            }
+            catch (const std::exception &)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ============== DangerMap Implementation ==============
+
+void DangerMap::record_step(const Simulation &simulation)
+{
+    steps_++;
+
+    const Pacman &pacman = simulation.get_pacman();
+    count(DangerLayer::PACMAN_DWELL, pacman.get_x(), pacman.get_y());
+
+    for (const Ghost &ghost : simulation.get_ghosts())
+    {
+        switch (ghost.get_state())
+        {
+        case GhostState::CHASING:
+            count(DangerLayer::GHOST_CHASING, ghost.get_x(), ghost.get_y());
+            break;
+        case GhostState::SCARED:
+            count(DangerLayer::GHOST_SCARED, ghost.get_x(), ghost.get_y());
+            break;
+        case GhostState::CAUGHT:
+            count(DangerLayer::GHOST_CAUGHT, ghost.get_x(), ghost.get_y());
+            break;
+        case GhostState::COOLDOWN:
+            count(DangerLayer::GHOST_COOLDOWN, ghost.get_x(), ghost.get_y());
+            break;
+        }
+    }
+}
+
+void DangerMap::record_death(const Simulation &simulation)
+{
+    const Pacman &pacman = simulation.get_pacman();
+    count(DangerLayer::DEATHS, pacman.get_x(), pacman.get_y());
+}
+
+void DangerMap::merge(const DangerMap &other)
+{
+    for (int layer = 0; layer < DANGER_LAYER_COUNT; layer++)
+    {
+        for (int row = 0; row < MAZE_ROWS; row++)
+        {
+            for (int col = 0; col < MAZE_COLS; col++)
+            {
+                layers_[layer][row][col] += other.layers_[layer][row][col];
+            }
+        }
+    }
+    games_ += other.games_;
+    steps_ += other.steps_;
+}
+
+void DangerMap::count(DangerLayer layer, double x, double y)
+{
+    const int row = static_cast<int>(std::floor(y / CELL_SIZE));
+    const int col = static_cast<int>(std::floor(x / CELL_SIZE));
+    if (row < 0 || row >= MAZE_ROWS || col < 0 || col >= MAZE_COLS)
+        return;
+    layers_[static_cast<int>(layer)][row][col]++;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "maze.h"
+#include <array>
+#include <cstdint>
+#include <string>
+
+class Simulation;
+
+/**
+ * @file danger_map.h
+ * @brief Per-cell statistics of many games on one maze, for heatmaps
+ *
+ * This file contains the DangerMap class, which counts where Pac-Man dies,
+ * where he spends his time and where the ghosts go in each GhostState.
+ * Batch tools give every worker thread its own DangerMap per level and
+ * merge them once the workers have finished, so counting needs no locks or
+ * atomics. Each layer saves as a CSV with the shape of the
+ * Resources/Maps/level*.csv it was gathered on.
+ */
+
+/**
+ * What a DangerMap counts in each cell
+ */
+enum class DangerLayer : std::uint8_t
+{
+    DEATHS,         ///< Times Pac-Man was caught here
+    PACMAN_DWELL,   ///< Steps Pac-Man spent here
+    GHOST_CHASING,  ///< Steps a chasing ghost spent here (summed over ghosts)
+    GHOST_SCARED,   ///< Steps a scared ghost spent here
+    GHOST_CAUGHT,   ///< Steps a caught ghost spent here on its way home
+    GHOST_COOLDOWN, ///< Steps a ghost spent here cooling down
+    COUNT
+};
+
+constexpr int DANGER_LAYER_COUNT = static_cast<int>(DangerLayer::COUNT);
+
+/**
+ * @brief Short lower-case name of a layer, for file names and reports
+ */
+const char *danger_layer_name(DangerLayer layer);
+
+/**
+ * One count per maze cell, indexed [row][col]
+ */
+using HeatGrid = std::array<std::array<std::uint64_t, MazeConfig::MAZE_COLS>, MazeConfig::MAZE_ROWS>;
+
+/**
+ * @brief Write a grid as MAZE_ROWS lines of MAZE_COLS comma-separated counts
+ * @return false if the file could not be written
+ */
+bool save_heat_grid(const std::string &path, const HeatGrid &grid);
+
+/**
+ * @brief Read a grid written by save_heat_grid
+ * @return false if the file is missing or not MAZE_ROWS x MAZE_COLS counts
+ */
+bool load_heat_grid(const std::string &path, HeatGrid &grid);
+
+/**
+ * @class DangerMap
+ * @brief Accumulates per-cell counts over the games played on one maze
+ *
+ * Positions are counted in the cell containing them; positions outside the
+ * grid (Pac-Man or a ghost inside a tunnel) are not counted.
+ */
+class DangerMap
+{
+public:
+    /**
+     * @brief Count where Pac-Man and each ghost are after a simulation step
+     */
+    void record_step(const Simulation &simulation);
+
+    /**
+     * @brief Count a death in the cell Pac-Man was caught in
+     */
+    void record_death(const Simulation &simulation);
+
+    /**
+     * @brief Count a finished game
+     */
+    void record_game() { games_++; }
+
+    /**
+     * @brief Add another map's counts (gathered on the same maze) to this one
+     */
+    void merge(const DangerMap &other);
+
+    const HeatGrid &get_layer(DangerLayer layer) const { return layers_[static_cast<int>(layer)]; }
+    std::uint64_t get_games() const { return games_; }
+    std::uint64_t get_steps() const { return steps_; }
+
+private:
+    std::array<HeatGrid, DANGER_LAYER_COUNT> layers_{}; ///< Counts per layer and cell
+    std::uint64_t games_ = 0;                           ///< Games recorded
+    std::uint64_t steps_ = 0;                           ///< Simulation steps recorded
+
+    void count(DangerLayer layer, double x, double y);
+};
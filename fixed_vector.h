@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @file fixed_vector.h
+ * @brief Vector with its capacity stored inline, for level data of bounded size
+ *
+ * This file contains the FixedVector class template. The maze and its
+ * pellets can never outgrow the 13x25 grid, so they are kept in
+ * FixedVectors sized for it: a level's data then lives in one block that
+ * needs no heap allocation, does not fragment over a long endless game, and
+ * is copied (for a new level or a snapshot) by plain assignment.
+ */
+
+/**
+ * @class FixedVector
+ * @brief Array of up to N elements that behaves like a std::vector which never reallocates
+ *
+ * Elements past size() stay default-constructed, so T must be default
+ * constructible. Adding to a full FixedVector fails and leaves it unchanged.
+ */
+template <typename T, std::size_t N>
+class FixedVector
+{
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    /**
+     * @brief Append a copy of an element
+     * @return false if the vector is full and nothing was added
+     */
+    bool push_back(const T &item)
+    {
+        if (size_ == N)
+            return false;
+        items_[size_++] = item;
+        return true;
+    }
+
+    /**
+     * @brief Construct an element in place at the end
+     * @return false if the vector is full and nothing was added
+     */
+    template <typename... Args>
+    bool emplace_back(Args &&...args)
+    {
+        return push_back(T(std::forward<Args>(args)...));
+    }
+
+    void clear() { size_ = 0; }
+
+    std::size_t size() const { return size_; }
+    static constexpr std::size_t capacity() { return N; }
+    bool empty() const { return size_ == 0; }
+
+    T &operator[](std::size_t i) { return items_[i]; }
+    const T &operator[](std::size_t i) const { return items_[i]; }
+    T &front() { return items_[0]; }
+    const T &front() const { return items_[0]; }
+    T &back() { return items_[size_ - 1]; }
+    const T &back() const { return items_[size_ - 1]; }
+
+    iterator begin() { return items_.data(); }
+    iterator end() { return items_.data() + size_; }
+    const_iterator begin() const { return items_.data(); }
+    const_iterator end() const { return items_.data() + size_; }
+
+private:
+    std::array<T, N> items_{}; ///< Storage for every element, used or not
+    std::size_t size_ = 0;     ///< Elements in use, from the front
+};
@@ -1,8 +1,14 @@
 #include "game.h"
+#include "alloc_tracker.h"
 #include "splashkit.h"
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <random>
 
 /**
  * @file game.cpp
@@ -15,14 +21,69 @@
 using namespace GameConfig;
 using namespace MazeConfig;
 
+namespace
+{
+    /**
+     * @brief Direction of the arrow key held down, or DIR_NONE
+     */
+    direction_t read_direction_keys()
+    {
+        if (key_down(LEFT_KEY))
+            return DIR_LEFT;
+        if (key_down(RIGHT_KEY))
+            return DIR_RIGHT;
+        if (key_down(UP_KEY))
+            return DIR_UP;
+        if (key_down(DOWN_KEY))
+            return DIR_DOWN;
+        return DIR_NONE;
+    }
+
+    /**
+     * @brief Fill a snapshot dirty list with pellets the renderer has not presented yet
+     * On entry the list holds only the pellets collected this tick. Older
+     * entries are kept until a snapshot carrying them has been presented, so
+     * snapshots skipped by the renderer never lose a collection.
+     */
+    void merge_dirty_pellets(std::vector<std::pair<std::uint64_t, int>> &pending, std::vector<int> &collected,
+                             std::uint64_t sequence, std::uint64_t presented)
+    {
+        pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                     [presented](const std::pair<std::uint64_t, int> &entry)
+                                     { return entry.first <= presented; }),
+                      pending.end());
+
+        const size_t fresh = collected.size();
+        for (const auto &entry : pending)
+        {
+            collected.push_back(entry.second);
+        }
+        for (size_t i = 0; i < fresh; i++)
+        {
+            pending.emplace_back(sequence, collected[i]);
+        }
+    }
+}
+
 /**
  * @brief Constructor - initializes game with default state
  */
 Game::Game()
     : running_(false), game_initialized_(false), paused_(false), escape_key_cooldown_(0.0),
       last_time_(0.0), current_game_mode_(GameMode::STARTING), previous_game_mode_(GameMode::STARTING),
-      current_level_(1)
+      current_level_(1), attract_mode_(false), pause_frame_drawn_(false), last_activity_time_(0.0),
+      snapshot_sequence_(0), presented_sequence_(0), simulation_running_(false),
+      round_over_(false), start_sound_finished_(false), last_input_direction_(DIR_NONE), applied_input_sequence_(0), measured_input_sequence_(0),
+      show_latency_(false), next_tick_(0), replay_playback_(false), replay_player_(simulation_), simulation_tick_(0), scene_generation_(0)
+{
+}
+
+/**
+ * @brief Destructor - stops the simulation thread if it is running
+ */
+Game::~Game()
 {
+    stop_simulation();
 }
 
 /**
@@ -38,11 +99,12 @@ bool Game::initialize()
         srand(static_cast<unsigned>(time(nullptr)));
 
         // Create core game objects (but not entities yet - those are created when user selects Play)
-        maze_ = std::make_unique<Maze>(current_level_);
         sprite_sheet_ = std::make_unique<SpriteSheet>(SPRITESHEET_NAME, SPRITESHEET_PATH, 16, 16, 4, 3, 1, 2);
-        game_state_ = std::make_unique<GameState>();
         sound_manager_ = std::make_unique<SoundManager>();
         menu_ = std::make_unique<Menu>();
+        text_renderer_ = std::make_unique<TextRenderer>();
+        scene_renderer_ = std::make_unique<SceneRenderer>(*sprite_sheet_, *text_renderer_);
+        overlay_compositor_ = std::make_unique<OverlayCompositor>(WINDOW_WIDTH, WINDOW_HEIGHT);
 
         // Set sprite sheet for menu (for color preview)
         menu_->set_sprite_sheet(sprite_sheet_.get());
@@ -50,6 +112,18 @@ bool Game::initialize()
         // Set sound manager for menu (for menu sound effects)
         menu_->set_sound_manager(sound_manager_.get());
 
+        // Share the glyph-cached text renderer between the menu and the HUD
+        menu_->set_text_renderer(text_renderer_.get());
+
+        // A tuning written by ghost_tuner replaces the built-in ghost constants and difficulty speeds
+        ghost_tuning_ = GhostTuning();
+        if (std::filesystem::exists(GHOST_TUNING_PATH) && !load_ghost_tuning(GHOST_TUNING_PATH, ghost_tuning_))
+        {
+            std::cerr << "Ignoring malformed " << GHOST_TUNING_PATH << std::endl;
+            ghost_tuning_ = GhostTuning();
+        }
+        menu_->set_ghost_tuning(&ghost_tuning_);
+
         // Initialize sound system
         if (!sound_manager_->initialize())
         {
@@ -69,6 +143,7 @@ bool Game::initialize()
 void Game::run()
 {
     last_time_ = current_ticks() / 1000.0; // Convert to seconds
+    last_activity_time_ = last_time_;
 
     while (running_ && !window_close_requested(GameConfig::WINDOW_TITLE))
     {
@@ -83,6 +158,13 @@ void Game::run()
         // Process events first (required for key_typed to work)
         process_events();
 
+        // Attract mode runs until any key is pressed
+        if (attract_mode_)
+        {
+            run_attract_frame();
+            continue;
+        }
+
         // Check if we're in the menu or in-game
         if (menu_->get_state() != MenuState::IN_GAME)
         {
@@ -95,7 +177,24 @@ void Game::run()
 
             // Handle menu navigation
             menu_->handle_input();
-            menu_->render();
+
+            // The menu only presents a frame when something changed; otherwise
+            // wait for input instead of spinning at the full frame rate
+            if (!menu_->render())
+            {
+                delay(IDLE_POLL_INTERVAL);
+            }
+
+            // Start the demo after the main menu has been left alone for a while
+            if (any_key_pressed() || menu_->get_state() != MenuState::MAIN_MENU)
+            {
+                last_activity_time_ = current_time;
+            }
+            else if (current_time - last_activity_time_ >= ATTRACT_IDLE_TIMEOUT)
+            {
+                start_attract_mode();
+                continue;
+            }
 
             // Check if user has selected to start the game
             if (menu_->should_start_game())
@@ -105,13 +204,7 @@ void Game::run()
                 // Set the starting level based on menu selection
                 current_level_ = menu_->get_selected_level();
 
-                // Recreate the maze for the selected level
-                maze_ = std::make_unique<Maze>(current_level_);
-
-                // Recreate game state (fresh start for new level/game)
-                game_state_ = std::make_unique<GameState>();
-
-                // Initialize game entities (this will use the new maze and game state)
+                // Start a fresh game on the selected level
                 initialize_game_entities();
 
                 // Mark as initialized
@@ -122,6 +215,14 @@ void Game::run()
         {
             // In-game loop
 
+            // A round that ended on the simulation thread is played out here, where drawing and menus live
+            if (round_over_.load(std::memory_order_acquire))
+            {
+                stop_simulation();
+                finish_round();
+                continue;
+            }
+
             // Update escape key cooldown timer
             if (escape_key_cooldown_ > 0.0)
             {
@@ -132,7 +233,9 @@ void Game::run()
             if (!paused_ && escape_key_cooldown_ <= 0.0 && key_typed(ESCAPE_KEY))
             {
                 paused_ = true;
+                pause_frame_drawn_ = false;
                 escape_key_cooldown_ = 0.3; // 300ms cooldown
+                stop_simulation();
                 // Pause all background sounds when pausing
                 sound_manager_->stop_all_background_sounds();
             }
@@ -156,42 +259,378 @@ void Game::run()
                     sound_manager_->stop_all_background_sounds();
                 }
 
-                // Render game state with pause overlay
-                render();
+                if (!paused_)
+                {
+                    continue;
+                }
+
+                // The paused scene never changes: compose it once, then re-show it with a single blit
+                if (pause_frame_drawn_)
+                {
+                    if (overlay_compositor_->present())
+                    {
+                        refresh_screen();
+                    }
+                    delay(IDLE_POLL_INTERVAL);
+                    continue;
+                }
 
-                // Draw pause menu with semi-transparent overlay
-                fill_rectangle(rgba_color(0, 0, 0, 180), 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
-                draw_text("PAUSED", COLOR_WHITE, "Arial", 72, WINDOW_WIDTH / 2 - 120, WINDOW_HEIGHT / 2 - 100);
-                draw_text("YELLOW - Resume", COLOR_WHITE, "Arial", 32, WINDOW_WIDTH / 2 - 120, WINDOW_HEIGHT / 2);
-                draw_text("RED - Main Menu", COLOR_WHITE, "Arial", 32, WINDOW_WIDTH / 2 - 120, WINDOW_HEIGHT / 2 + 50);
+                overlay_compositor_->capture([this](const drawing_options &options) { draw_pause_frame(options); });
+                overlay_compositor_->present();
 
                 refresh_screen(GameConfig::TARGET_FPS);
+                pause_frame_drawn_ = true;
             }
             else
             {
-                // Normal gameplay
+                // Normal gameplay: the simulation thread ticks on its own, this thread samples input and draws
+                if (!simulation_thread_.joinable())
+                {
+                    start_simulation();
+                }
+
+                // Input is sampled before every simulation tick; frames are only drawn at TARGET_FPS
                 handle_events();
-                update(delta_time);
-                render();
-                refresh_screen(GameConfig::TARGET_FPS);
+                if (InputClock::now() < next_frame_time_)
+                {
+                    wait_for_next_frame();
+                    continue;
+                }
+
+                present_gameplay_frame();
             }
         }
     }
+
+    stop_simulation();
+}
+
+/**
+ * @brief Set up a recorded game to be stepped with step_replay()
+ */
+void Game::start_replay(const Replay &replay)
+{
+    stop_simulation();
+
+    replay_ = replay;
+    replay_playback_ = true;
+    attract_mode_ = false;
+    paused_ = false;
+
+    current_level_ = replay_.level;
+    initialize_game_entities();
+}
+
+/**
+ * @brief Simulate the next tick of the replay with the ReplayPlayer's playback rules
+ */
+bool Game::step_replay()
+{
+    if (!replay_playback_)
+        return false;
+
+    const int level = replay_player_.get_level();
+    if (!replay_player_.step())
+        return false;
+    simulation_tick_ = replay_player_.get_tick();
+
+    // An endless game moved on to the next level, as finish_round does in a live game
+    if (replay_player_.get_level() != level)
+    {
+        current_level_ = replay_player_.get_level();
+        reset_scene();
+    }
+
+    const StepEvents &events = replay_player_.get_events();
+    record_audio_cues(events);
+    if (events.pacman_caught)
+    {
+        current_game_mode_ = GameMode::GAME_OVER;
+    }
+    else if (events.level_cleared)
+    {
+        current_game_mode_ = GameMode::VICTORY;
+    }
+    else
+    {
+        current_game_mode_ = replay_player_.is_starting() ? GameMode::STARTING : determine_current_game_mode();
+    }
+    publish_snapshot();
+
+    // The caller sees every snapshot, so each one only needs this tick's pellets
+    snapshots_.acquire();
+    presented_sequence_.store(snapshots_.read_buffer().sequence, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Start ticking the simulation on its own thread
+ */
+void Game::start_simulation()
+{
+    if (simulation_thread_.joinable())
+        return;
+
+    // Changes made while the simulation was stopped are not replayed; a key still held is re-sampled
+    input_queue_.clear();
+    last_input_direction_ = DIR_NONE;
+    next_frame_time_ = InputClock::now();
+
+    simulation_running_.store(true, std::memory_order_release);
+    simulation_thread_ = std::thread(&Game::simulation_loop, this);
+}
+
+/**
+ * @brief Stop the simulation thread and wait for it to finish its current tick
+ */
+void Game::stop_simulation()
+{
+    if (!simulation_thread_.joinable())
+        return;
+
+    simulation_running_.store(false, std::memory_order_release);
+    simulation_thread_.join();
+}
+
+/**
+ * @brief Simulation thread body: fixed-rate update and publish until stopped or the round ends
+ */
+void Game::simulation_loop()
+{
+    using Clock = InputClock;
+    const double step_time = 1.0 / SIMULATION_RATE;
+    const Clock::duration step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(step_time));
+    Clock::time_point next_tick = Clock::now();
+
+    while (simulation_running_.load(std::memory_order_acquire))
+    {
+        // Apply, in order, every direction change sampled up to this tick's scheduled time
+        InputEvent input;
+        while (input_queue_.pop_until(next_tick, input))
+        {
+            apply_input(input.dir);
+            applied_input_sequence_++;
+            applied_input_time_ = input.time;
+        }
+
+        update(step_time);
+        simulation_tick_++;
+        publish_snapshot();
+
+        // Death and level completion need the window and menus, so hand them to the main thread
+        if (current_game_mode_ == GameMode::GAME_OVER || current_game_mode_ == GameMode::VICTORY)
+        {
+            round_over_.store(true, std::memory_order_release);
+            return;
+        }
+
+        // Tick at a fixed rate; after a long stall resume from now instead of replaying every missed tick
+        next_tick += step;
+        const Clock::time_point now = Clock::now();
+        if (now - next_tick > MAX_SIMULATION_LAG * step)
+        {
+            next_tick = now;
+        }
+        next_tick_.store(next_tick.time_since_epoch().count(), std::memory_order_relaxed);
+        std::this_thread::sleep_until(next_tick);
+    }
+}
+
+/**
+ * @brief Play out the end of a round (game over or level complete) on the main thread
+ */
+void Game::finish_round()
+{
+    round_over_.store(false, std::memory_order_relaxed);
+    paused_ = false;
+
+    // The death or level-clear sound is in the final snapshot, which may not have been presented yet
+    acquire_snapshot();
+    play_audio_cues();
+
+    // The game ends here unless an endless run moves on to the next level
+    if (current_game_mode_ != GameMode::VICTORY || !menu_->is_endless_mode())
+    {
+        save_last_replay();
+    }
+
+    if (current_game_mode_ == GameMode::VICTORY)
+    {
+        // Wait for cutscene sound to finish (approximately 4.3 seconds based on typical cutscene.wav length)
+        delay(4300);
+
+        // Advance to next level or end game
+        advance_to_next_level();
+        return;
+    }
+
+    // Game over - Pacman caught by ghost
+    play_dying_animation();
+    text_renderer_->draw_text("GAME OVER!", COLOR_RED, 48, WINDOW_WIDTH / 2 - 120, WINDOW_HEIGHT / 2);
+    refresh_screen(TARGET_FPS);
+    delay(GAME_OVER_DISPLAY_TIME);
+
+    // Check if endless mode to trigger high score entry
+    if (menu_->is_endless_mode())
+    {
+        int final_score = simulation_.get_game_state().get_score();
+        menu_->start_name_entry(final_score);
+        game_initialized_ = false;
+    }
+    else
+    {
+        // Single level mode - just return to menu
+        menu_->reset_game_start_flag();
+        menu_->set_state(MenuState::MAIN_MENU);
+        game_initialized_ = false;
+    }
+}
+
+void Game::apply_input(direction_t dir)
+{
+    simulation_.apply_input(dir);
+
+    AllocScope alloc_scope(AllocTag::REPLAY);
+    replay_.events.push_back({simulation_tick_, ReplayEventType::INPUT, dir});
+}
+
+void Game::save_last_replay()
+{
+    replay_.tick_count = simulation_tick_;
+    if (!save_replay(ReplayConfig::LAST_REPLAY_PATH, replay_))
+    {
+        std::cerr << "Failed to save replay!" << std::endl;
+    }
+}
+
+/**
+ * @brief Start the attract (demo) mode with the bot playing a random level
+ */
+void Game::start_attract_mode()
+{
+    attract_mode_ = true;
+    menu_->set_state(MenuState::IN_GAME);
+
+    current_level_ = rand() % 5 + 1;
+    initialize_game_entities();
+    sound_manager_->set_muted(true);
+}
+
+/**
+ * @brief Leave attract mode and return to the main menu
+ */
+void Game::end_attract_mode()
+{
+    attract_mode_ = false;
+    game_initialized_ = false;
+    sound_manager_->set_muted(false);
+    menu_->set_state(MenuState::MAIN_MENU);
+    last_activity_time_ = current_ticks() / 1000.0;
+}
+
+/**
+ * @brief Run one attract mode frame: several bot-driven simulation steps, then one draw
+ */
+void Game::run_attract_frame()
+{
+    if (any_key_pressed())
+    {
+        end_attract_mode();
+        return;
+    }
+
+    // Keep the simulation at its normal step size but only draw every few steps
+    const double step_time = 1.0 / TARGET_FPS;
+    for (int i = 0; i < TARGET_FPS / ATTRACT_FPS; i++)
+    {
+        bot_.steer(simulation_);
+        update(step_time);
+
+        // The demo ends when Pac-Man dies or clears the maze
+        if (!attract_mode_)
+            return;
+    }
+
+    publish_snapshot();
+    present();
+    play_audio_cues();
+    text_renderer_->draw_centered_text("DEMO - PRESS ANY KEY", COLOR_YELLOW, 24, WINDOW_WIDTH, WINDOW_HEIGHT - 32);
+    refresh_screen(ATTRACT_FPS);
 }
 
 void Game::handle_events()
 {
     // Note: process_events() is already called in run() loop
-    // Just capture Pacman input here
-    pacman_->capture_input();
+    if (key_typed(F1_KEY))
+    {
+        show_latency_ = !show_latency_;
+    }
+
+    // The simulation buffers a turn from press to release, so only changes need to be sent (DIR_NONE = released)
+    // A change the full queue refused is sent again on the next sample
+    const direction_t dir = read_direction_keys();
+    if (dir != last_input_direction_ && input_queue_.push({dir, InputClock::now()}))
+    {
+        last_input_direction_ = dir;
+    }
 }
 
-void Game::update(double delta_time)
+void Game::wait_for_next_frame()
 {
-    // Update background audio BEFORE checking game mode (must play start sound before checking if it's done)
-    double pellet_percentage = calculate_pellet_percentage();
-    sound_manager_->update_background_audio(current_game_mode_, pellet_percentage);
+    const InputClock::duration tick_since_epoch(next_tick_.load(std::memory_order_relaxed));
+    const InputClock::time_point sample_time =
+        InputClock::time_point(tick_since_epoch) - std::chrono::milliseconds(INPUT_SAMPLE_LEAD);
 
+    // Once the sample for the coming tick has been taken, sleep through to the frame
+    InputClock::time_point wake_time = next_frame_time_;
+    if (InputClock::now() < sample_time && sample_time < wake_time)
+    {
+        wake_time = sample_time;
+    }
+    std::this_thread::sleep_until(wake_time);
+}
+
+void Game::present_gameplay_frame()
+{
+    // Pace frames from the schedule, resynchronising if the display fell behind
+    const InputClock::duration frame_time = std::chrono::duration_cast<InputClock::duration>(
+        std::chrono::duration<double>(1.0 / TARGET_FPS));
+    next_frame_time_ += frame_time;
+    if (next_frame_time_ < InputClock::now())
+    {
+        next_frame_time_ = InputClock::now() + frame_time;
+    }
+
+    present();
+    play_audio_cues();
+    if (show_latency_)
+    {
+        scene_renderer_->draw_latency_readout(latency_meter_);
+    }
+    refresh_screen();
+
+    // The first frame presented with a new input completes one input-to-photon sample
+    const RenderSnapshot &shown = snapshots_.read_buffer();
+    if (shown.input_sequence != measured_input_sequence_)
+    {
+        latency_meter_.record(InputClock::now() - shown.input_time);
+        measured_input_sequence_ = shown.input_sequence;
+    }
+}
+
+void Game::draw_pause_frame(const drawing_options &options)
+{
+    present(options);
+
+    // Draw pause menu with semi-transparent overlay
+    fill_rectangle(rgba_color(0, 0, 0, 180), 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, options);
+    text_renderer_->draw_text("PAUSED", COLOR_WHITE, 72, WINDOW_WIDTH / 2 - 120, WINDOW_HEIGHT / 2 - 100, options);
+    text_renderer_->draw_text("YELLOW - Resume", COLOR_WHITE, 32, WINDOW_WIDTH / 2 - 120, WINDOW_HEIGHT / 2, options);
+    text_renderer_->draw_text("RED - Main Menu", COLOR_WHITE, 32, WINDOW_WIDTH / 2 - 120, WINDOW_HEIGHT / 2 + 50, options);
+}
+
+void Game::update(double delta_time)
+{
     // Update game mode (handles STARTING timer - checks if start sound finished)
     update_game_mode(delta_time);
 
@@ -201,105 +640,165 @@ void Game::update(double delta_time)
         return;
     }
 
-    // Store previous power pellet count
-    static int previous_power_pellets = -1; // -1 = uninitialized
-    int current_power_pellets = game_state_->count_collected_power_pellets();
+    const StepEvents events = simulation_.step(delta_time);
+    record_audio_cues(events);
 
-    // Update entities
-    pacman_->update(*maze_, *game_state_, delta_time);
+    // The demo ends when Pac-Man dies or clears the maze
+    if ((events.pacman_caught || events.level_cleared) && attract_mode_)
+    {
+        end_attract_mode();
+        return;
+    }
 
-    // Handle token collection sounds
-    if (game_state_->was_token_just_collected())
+    if (events.pacman_caught)
     {
-        sound_manager_->play_dot_collection_sound();
-        game_state_->reset_token_collection_flag();
+        // Game over - Pacman caught by ghost; finish_round plays the dying animation
+        current_game_mode_ = GameMode::GAME_OVER;
+        return;
     }
 
-    // Handle power pellet collection and ghost state changes
-    if (previous_power_pellets != -1 && current_power_pellets > previous_power_pellets)
+    if (events.level_cleared)
+    {
+        // finish_round waits for the cutscene sound and advances the level
+        current_game_mode_ = GameMode::VICTORY;
+    }
+}
+
+void Game::record_audio_cues(const StepEvents &events)
+{
+    // Sounds are only counted here; the main thread plays them from the published snapshot
+    audio_cues_.tokens_collected += events.token_collected ? 1 : 0;
+    audio_cues_.fruits_collected += events.fruit_collected ? 1 : 0;
+    audio_cues_.ghosts_caught += events.ghosts_caught;
+    audio_cues_.pacman_caught += events.pacman_caught ? 1 : 0;
+    audio_cues_.levels_cleared += events.level_cleared ? 1 : 0;
+}
+
+void Game::publish_snapshot()
+{
+    RenderSnapshot &snapshot = snapshots_.write_buffer();
+    snapshot.sequence = ++snapshot_sequence_;
+    snapshot.scene = scene_generation_;
+
+    snapshot_system(simulation_.get_world(), snapshot);
+
+    // Pellets collected this tick, plus any the renderer has not presented yet
+    const std::uint64_t presented = presented_sequence_.load(std::memory_order_acquire);
+    snapshot.collected_tokens.clear();
+    snapshot.collected_power_pellets.clear();
+    GameState &game_state = simulation_.get_game_state();
+    game_state.drain_collected_pellets(snapshot.collected_tokens, snapshot.collected_power_pellets);
+    merge_dirty_pellets(pending_tokens_, snapshot.collected_tokens, snapshot.sequence, presented);
+    merge_dirty_pellets(pending_power_pellets_, snapshot.collected_power_pellets, snapshot.sequence, presented);
+
+    snapshot.score = game_state.get_score();
+    snapshot.tokens_collected = game_state.get_tokens_collected();
+    snapshot.total_tokens = game_state.get_total_tokens();
+
+    snapshot.input_sequence = applied_input_sequence_;
+    snapshot.input_time = applied_input_time_;
+
+    snapshot.game_mode = current_game_mode_;
+    snapshot.pellet_percentage = simulation_.pellet_percentage();
+    snapshot.audio = audio_cues_;
+
+    snapshots_.publish();
+}
+
+void Game::present(const drawing_options &options)
+{
+    acquire_snapshot();
+    scene_renderer_->draw(snapshots_.read_buffer(), options);
+}
+
+void Game::acquire_snapshot()
+{
+    if (snapshots_.acquire())
     {
-        // Power pellet was collected - set all non-caught ghosts to scared mode
-        if (!ghost1_->is_caught())
-            ghost1_->set_scared_mode();
-        if (!ghost2_->is_caught())
-            ghost2_->set_scared_mode();
+        presented_sequence_.store(snapshots_.read_buffer().sequence, std::memory_order_release);
     }
-    previous_power_pellets = current_power_pellets;
+}
 
-    // Update ghost AI
-    ghost1_->update(*maze_, pacman_->get_x(), pacman_->get_y(), pacman_->get_direction(), delta_time);
-    ghost2_->update(*maze_, pacman_->get_x(), pacman_->get_y(), pacman_->get_direction(), delta_time);
+void Game::play_audio_cues()
+{
+    const RenderSnapshot &snapshot = snapshots_.read_buffer();
+    sound_manager_->update_background_audio(snapshot.game_mode, snapshot.pellet_percentage);
 
-    // Update ghost score popups
-    ghost1_->update_score_popup(delta_time);
-    ghost2_->update_score_popup(delta_time);
+    // Play begins once the jingle is over (straight away when muted, as nothing is playing)
+    if (snapshot.game_mode == GameMode::STARTING && !sound_effect_playing(SoundConfig::START_SOUND_NAME))
+    {
+        start_sound_finished_.store(true, std::memory_order_release);
+    }
 
-    // Update fruit
-    fruit_->update(delta_time, *maze_);
+    // Each kind of effect plays once per frame, however many ticks it happened on
+    const AudioCues &heard = played_audio_cues_;
+    const AudioCues &cues = snapshot.audio;
+    if (cues.tokens_collected != heard.tokens_collected)
+    {
+        sound_manager_->play_dot_collection_sound();
+    }
 
-    // Check fruit collision
-    if (fruit_->check_collision(pacman_->get_x(), pacman_->get_y()))
+    if (cues.fruits_collected != heard.fruits_collected && !sound_manager_->is_muted())
     {
-        game_state_->add_score(fruit_->get_points());
         play_sound_effect(SoundConfig::FRUIT_SOUND_NAME);
     }
 
-    // Handle ghost collisions
-    handle_ghost_collisions();
+    if (cues.ghosts_caught != heard.ghosts_caught)
+    {
+        sound_manager_->play_ghost_eat_sound();
+        sound_manager_->play_ghost_retreat_sound();
+    }
 
-    // Check for game end conditions
-    if (check_win_condition())
+    if (cues.pacman_caught != heard.pacman_caught)
     {
-        current_game_mode_ = GameMode::VICTORY;
         sound_manager_->stop_all_background_sounds();
+        if (!sound_manager_->is_muted())
+        {
+            play_sound_effect(SoundConfig::DIE_SOUND_NAME);
+        }
+    }
 
-        // Play cutscene sound
+    if (cues.levels_cleared != heard.levels_cleared)
+    {
+        sound_manager_->stop_all_background_sounds();
         sound_manager_->play_cutscene_sound();
-
-        // Wait for cutscene sound to finish (approximately 4.3 seconds based on typical cutscene.wav length)
-        delay(4300);
-
-        // Advance to next level or end game
-        advance_to_next_level();
     }
+
+    played_audio_cues_ = cues;
 }
 
-void Game::render()
+void Game::reset_scene()
 {
-    clear_screen(COLOR_BLACK);
-
-    // Draw game objects
-    maze_->draw();
-    game_state_->draw_tokens();
-    game_state_->draw_power_pellets();
-    fruit_->draw();
-    pacman_->draw();
-    ghost1_->draw();
-    ghost2_->draw();
-    game_state_->draw_score();
+    // Dirty lists and round results belong to the old level; the fresh snapshot replaces any unread one
+    pending_tokens_.clear();
+    pending_power_pellets_.clear();
+    round_over_.store(false, std::memory_order_relaxed);
+    scene_generation_++;
+    scene_renderer_->reset(simulation_.get_maze(), simulation_.get_game_state());
+    publish_snapshot();
 }
 
 void Game::initialize_game_entities()
 {
-    // Find optimal spawn positions for entities
-    const int pacman_target_row = MAZE_ROWS / 2 + 3;
-    const int pacman_target_col = MAZE_COLS / 2;
-    const auto [pacman_spawn_row, pacman_spawn_col] = Maze::find_spawn_position(*maze_, pacman_target_row, pacman_target_col);
-
-    const int ghost1_target_row = MAZE_ROWS / 2 - 3;
-    const int ghost1_target_col = MAZE_COLS / 2;
-    const auto [ghost1_spawn_row, ghost1_spawn_col] = Maze::find_spawn_position(*maze_, ghost1_target_row, ghost1_target_col);
-
-    const int ghost2_target_row = MAZE_ROWS / 2 + 1;
-    const int ghost2_target_col = MAZE_COLS / 2 + 5;
-    const auto [ghost2_spawn_row, ghost2_spawn_col] = Maze::find_spawn_position(*maze_, ghost2_target_row, ghost2_target_col);
-
-    // Create game entities
-    // Use the palette selected in the settings menu
-    const char *selected_palette = menu_->get_selected_pacman_palette();
-
-    // Get difficulty speed multiplier
-    double speed_multiplier = menu_->get_difficulty_speed_multiplier();
+    // Use the palette selected in the settings menu, at the difficulty's speed
+    SimulationSettings settings;
+    settings.palette = menu_->get_selected_pacman_palette();
+    settings.speed_multiplier = menu_->get_difficulty_speed_multiplier();
+    settings.ghost_tuning = ghost_tuning_;
+
+    // Every game is seeded afresh and recorded so it can be replayed tick for tick
+    if (!replay_playback_)
+    {
+        replay_ = Replay();
+        replay_.seed = std::random_device{}();
+        replay_.level = current_level_;
+        replay_.endless = menu_->is_endless_mode();
+        replay_.speed_multiplier = settings.speed_multiplier;
+        replay_.ghost_tuning = settings.ghost_tuning;
+        replay_.palette = settings.palette;
+    }
+    settings.seed = replay_.seed;
+    simulation_tick_ = 0;
 
     // Set sound base path based on Velentina Mode setting
     if (menu_->is_velentina_mode_enabled())
@@ -314,166 +813,64 @@ void Game::initialize_game_entities()
     sound_manager_->unload_all_sounds();
     sound_manager_->initialize();
 
-    pacman_ = std::make_unique<Pacman>(
-        Maze::get_cell_center_x(pacman_spawn_col),
-        Maze::get_cell_center_y(pacman_spawn_row),
-        sprite_sheet_.get(),
-        selected_palette);
-    pacman_->set_speed_multiplier(speed_multiplier);
-
-    ghost1_ = std::make_unique<Ghost>(
-        Maze::get_cell_center_x(ghost1_spawn_col),
-        Maze::get_cell_center_y(ghost1_spawn_row),
-        sprite_sheet_.get(),
-        "RED_BLUE_WHITE",
-        GhostAIType::RANDOM_PATROL);
-    ghost1_->set_speed_multiplier(speed_multiplier);
-
-    ghost2_ = std::make_unique<Ghost>(
-        Maze::get_cell_center_x(ghost2_spawn_col),
-        Maze::get_cell_center_y(ghost2_spawn_row),
-        sprite_sheet_.get(),
-        "PINK_BLUE_WHTE",
-        GhostAIType::AMBUSHER);
-    ghost2_->set_speed_multiplier(speed_multiplier);
-
-    // Initialize fruit
-    fruit_ = std::make_unique<Fruit>(sprite_sheet_.get());
-
-    // Initialize game elements
-    maze_->initialize_tokens(*game_state_, pacman_spawn_row, pacman_spawn_col);
-    maze_->initialize_power_pellets(*game_state_);
-
-    // Stop all background sounds to reset sound state
+    // Create the maze, entities and pellets for the starting level (a replay with its recorded settings)
+    if (replay_playback_)
+    {
+        replay_player_.start(replay_);
+    }
+    else
+    {
+        simulation_.new_game(current_level_, settings);
+    }
+
+    // Stop all background sounds to reset sound state, dropping any sounds the last game left unplayed
     sound_manager_->stop_all_background_sounds();
+    played_audio_cues_ = audio_cues_;
 
     // Reset game mode to STARTING
     current_game_mode_ = GameMode::STARTING;
     previous_game_mode_ = GameMode::STARTING;
+    start_sound_finished_.store(false, std::memory_order_relaxed);
 
+    reset_scene();
     game_initialized_ = true;
 }
 
 // === Helper Method Implementations ===
 
 /**
- * @brief Handle collisions between Pac-Man and ghosts
+ * @brief Play Pac-Man's dying animation over the current scene
  */
-void Game::handle_ghost_collisions()
+void Game::play_dying_animation()
 {
-    // Check collision with ghost1
-    double dx1 = pacman_->get_x() - ghost1_->get_x();
-    double dy1 = pacman_->get_y() - ghost1_->get_y();
-    double distance1 = sqrt(dx1 * dx1 + dy1 * dy1);
+    // Dying animation sprite coordinates
+    const int dying_coords[12][2] = {
+        {3, 0}, {3, 1}, {3, 2}, {3, 3}, {3, 4}, {3, 5}, {4, 0}, {4, 1}, {4, 2}, {4, 3}, {4, 4}, {4, 5}};
+
+    // The rest of the scene comes from a snapshot without Pac-Man and is composed once; Pac-Man is drawn by hand
+    Pacman &pacman = simulation_.get_pacman();
+    pacman.set_visible(false);
+    publish_snapshot();
+    overlay_compositor_->capture([this](const drawing_options &options) { present(options); });
 
-    if (distance1 <= COLLISION_DISTANCE && ghost1_->can_interact())
+    for (int i = 0; i < 12; ++i)
     {
-        if (ghost1_->is_scared())
+        // Draw the frozen scene behind the animation (a blit when it could be cached)
+        if (!overlay_compositor_->present())
         {
-            // Pac-Man catches scared ghost
-            ghost1_->set_caught_mode();
-            game_state_->add_score(400);
-            // Show 400-point popup at ghost's location
-            ghost1_->trigger_score_popup(ghost1_->get_x(), ghost1_->get_y());
-            sound_manager_->play_ghost_eat_sound();
-            sound_manager_->play_ghost_retreat_sound();
+            present();
         }
-        else if (!ghost1_->is_caught())
-        {
-            // Game over - Pacman caught by ghost
-            current_game_mode_ = GameMode::GAME_OVER;
-            sound_manager_->stop_all_background_sounds();
-            play_sound_effect(SoundConfig::DIE_SOUND_NAME);
-            pacman_->play_dying_animation(maze_.get(), game_state_.get(), ghost1_.get(), ghost2_.get());
-            draw_text("GAME OVER!", COLOR_RED, "Arial", 48,
-                      WINDOW_WIDTH / 2 - 120, WINDOW_HEIGHT / 2);
-            refresh_screen(TARGET_FPS);
-            delay(GAME_OVER_DISPLAY_TIME);
-
-            // Check if endless mode to trigger high score entry
-            if (menu_->is_endless_mode())
-            {
-                int final_score = game_state_->get_score();
-                menu_->start_name_entry(final_score);
-                game_initialized_ = false;
-            }
-            else
-            {
-                // Single level mode - just return to menu
-                menu_->reset_game_start_flag();
-                menu_->set_state(MenuState::MAIN_MENU);
-                game_initialized_ = false;
-            }
-            return;
-        }
-    }
 
-    // Check collision with ghost2
-    double dx2 = pacman_->get_x() - ghost2_->get_x();
-    double dy2 = pacman_->get_y() - ghost2_->get_y();
-    double distance2 = sqrt(dx2 * dx2 + dy2 * dy2);
+        // Draw Pacman dying frame
+        sprite_sheet_->draw_sprite_at_pixel(pacman.get_palette(), dying_coords[i][0], dying_coords[i][1],
+                                            pacman.get_x(), pacman.get_y(), SPRITE_SCALE, false, false, true);
 
-    if (distance2 <= COLLISION_DISTANCE && ghost2_->can_interact())
-    {
-        if (ghost2_->is_scared())
-        {
-            // Pac-Man catches scared ghost
-            ghost2_->set_caught_mode();
-            game_state_->add_score(400);
-            // Show 400-point popup at ghost's location
-            ghost2_->trigger_score_popup(ghost2_->get_x(), ghost2_->get_y());
-            sound_manager_->play_ghost_eat_sound();
-            sound_manager_->play_ghost_retreat_sound();
-        }
-        else if (!ghost2_->is_caught())
-        {
-            // Game over - Pacman caught by ghost
-            current_game_mode_ = GameMode::GAME_OVER;
-            sound_manager_->stop_all_background_sounds();
-            play_sound_effect(SoundConfig::DIE_SOUND_NAME);
-            pacman_->play_dying_animation(maze_.get(), game_state_.get(), ghost1_.get(), ghost2_.get());
-            draw_text("GAME OVER!", COLOR_RED, "Arial", 48,
-                      WINDOW_WIDTH / 2 - 120, WINDOW_HEIGHT / 2);
-            refresh_screen(TARGET_FPS);
-            delay(GAME_OVER_DISPLAY_TIME);
-
-            // Check if endless mode to trigger high score entry
-            if (menu_->is_endless_mode())
-            {
-                int final_score = game_state_->get_score();
-                menu_->start_name_entry(final_score);
-                game_initialized_ = false;
-            }
-            else
-            {
-                // Single level mode - just return to menu
-                menu_->reset_game_start_flag();
-                menu_->set_state(MenuState::MAIN_MENU);
-                game_initialized_ = false;
-            }
-            return;
-        }
+        refresh_screen(60);
+        delay(80); // ~80ms per frame for smooth animation
     }
-}
-
-/**
- * @brief Check if the win condition has been met
- * @return true if player has won, false otherwise
- */
-bool Game::check_win_condition()
-{
-    return game_state_->all_tokens_collected();
-}
 
-/**
- * @brief Calculate the percentage of pellets remaining
- * @return Percentage of pellets left (0-100)
- */
-double Game::calculate_pellet_percentage() const
-{
-    int total = game_state_->get_total_tokens();
-    int collected = game_state_->get_tokens_collected();
-    return total > 0 ? 100.0 * (total - collected) / total : 100.0;
+    overlay_compositor_->invalidate();
+    pacman.set_visible(true);
 }
 
 void Game::update_game_mode(double delta_time)
@@ -483,19 +880,18 @@ void Game::update_game_mode(double delta_time)
     // Handle STARTING state - wait for start.wav to finish playing
     if (current_game_mode_ == GameMode::STARTING)
     {
-        // Check if start sound is no longer playing (finished)
-        if (!sound_effect_playing(SoundConfig::START_SOUND_NAME))
+        if (start_sound_finished_.load(std::memory_order_acquire))
         {
+            // Start sound is no longer playing (finished)
             current_game_mode_ = GameMode::NORMAL;
+            AllocScope alloc_scope(AllocTag::REPLAY);
+            replay_.events.push_back({simulation_tick_, ReplayEventType::START, DIR_NONE});
         }
     }
     else
     {
         current_game_mode_ = determine_current_game_mode();
     }
-
-    // Update Pacman's power mode for speed boost
-    pacman_->set_power_mode(current_game_mode_ == GameMode::POWER_MODE);
 }
 
 GameMode Game::determine_current_game_mode() const
@@ -506,13 +902,13 @@ GameMode Game::determine_current_game_mode() const
         return GameMode::GAME_OVER;
     }
 
-    if (game_state_->all_tokens_collected())
+    if (simulation_.get_game_state().all_tokens_collected())
     {
         return GameMode::VICTORY;
     }
 
     // Check if any ghosts are scared (power mode active)
-    if (ghost1_->is_scared() || ghost2_->is_scared())
+    if (simulation_.any_ghost_scared())
     {
         return GameMode::POWER_MODE;
     }
@@ -522,19 +918,16 @@ GameMode Game::determine_current_game_mode() const
 }
 void Game::advance_to_next_level()
 {
-    // Save current score before clearing game state
-    int current_score = game_state_->get_score();
-
-    // Check if we're in endless mode or single level mode
-    if (!menu_->is_endless_mode())
+    // Check if we're in endless mode or single level mode (recorded with the game, so playback agrees)
+    if (!replay_.endless)
     {
         // Single level mode - return to menu after completing
         current_game_mode_ = GameMode::VICTORY;
         sound_manager_->stop_all_background_sounds();
 
-        // Show victory message briefly
-        draw_text("LEVEL COMPLETE!", COLOR_GREEN, "Arial", 48,
-                  WINDOW_WIDTH / 2 - 150, WINDOW_HEIGHT / 2);
+        // Show victory message briefly over the final scene
+        present();
+        text_renderer_->draw_text("LEVEL COMPLETE!", COLOR_GREEN, 48, WINDOW_WIDTH / 2 - 150, WINDOW_HEIGHT / 2);
         refresh_screen(TARGET_FPS);
         delay(2000); // 2 second delay
 
@@ -551,45 +944,13 @@ void Game::advance_to_next_level()
         current_level_ = 1; // Loop back to level 1
     }
 
-    // Create new maze for the next level
-    maze_ = std::make_unique<Maze>(current_level_);
-
-    // Find optimal spawn positions for entities
-    const int pacman_target_row = MAZE_ROWS / 2 + 3;
-    const int pacman_target_col = MAZE_COLS / 2;
-    const auto [pacman_spawn_row, pacman_spawn_col] = Maze::find_spawn_position(*maze_, pacman_target_row, pacman_target_col);
-
-    const int ghost1_target_row = MAZE_ROWS / 2 - 3;
-    const int ghost1_target_col = MAZE_COLS / 2;
-    const auto [ghost1_spawn_row, ghost1_spawn_col] = Maze::find_spawn_position(*maze_, ghost1_target_row, ghost1_target_col);
-
-    const int ghost2_target_row = MAZE_ROWS / 2 + 1;
-    const int ghost2_target_col = MAZE_COLS / 2 + 5;
-    const auto [ghost2_spawn_row, ghost2_spawn_col] = Maze::find_spawn_position(*maze_, ghost2_target_row, ghost2_target_col);
-
-    // Reset entities to their spawn positions
-    pacman_->set_position(Maze::get_cell_center_x(pacman_spawn_col), Maze::get_cell_center_y(pacman_spawn_row));
-    ghost1_->set_position(Maze::get_cell_center_x(ghost1_spawn_col), Maze::get_cell_center_y(ghost1_spawn_row));
-    ghost2_->set_position(Maze::get_cell_center_x(ghost2_spawn_col), Maze::get_cell_center_y(ghost2_spawn_row));
-
-    // Reset ghosts to chasing mode
-    ghost1_->set_chasing_mode();
-    ghost2_->set_chasing_mode();
-
-    // Recreate fruit for the new level
-    fruit_ = std::make_unique<Fruit>(sprite_sheet_.get());
-
-    // Clear and reinitialize game state for new level
-    game_state_ = std::make_unique<GameState>();
-
-    // Initialize tokens for the new level
-    maze_->initialize_tokens(*game_state_, pacman_spawn_row, pacman_spawn_col);
-    maze_->initialize_power_pellets(*game_state_);
-
-    // Restore the score from previous level
-    game_state_->add_score(current_score);
+    // New maze and pellets, with the entities back at their spawn points and the score kept
+    simulation_.next_level(current_level_);
 
     // Reset game mode to STARTING
     current_game_mode_ = GameMode::STARTING;
     previous_game_mode_ = GameMode::STARTING;
+    start_sound_finished_.store(false, std::memory_order_relaxed);
+
+    reset_scene();
 }
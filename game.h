@@ -1,13 +1,26 @@
 #pragma once
 
-#include "maze.h"
-#include "entities.h"
+#include "simulation.h"
 #include "spritesheet.h"
 #include "game_config.h"
 #include "sound_manager.h"
 #include "menu.h"
+#include "text_renderer.h"
+#include "bot.h"
+#include "render_snapshot.h"
+#include "scene_renderer.h"
+#include "triple_buffer.h"
+#include "input_queue.h"
+#include "overlay_compositor.h"
+#include "replay.h"
+#include "replay_player.h"
 #include "splashkit.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
 
 /**
  * @file game.h
@@ -22,11 +35,18 @@
  * @brief Main game class that orchestrates the entire Pac-Man game
  *
  * The Game class is responsible for:
- * - Managing all game objects (maze, entities, sprites)
+ * - Owning the Simulation and the window, sound and menu objects around it
  * - Controlling the main game loop (update, render, events)
  * - Tracking game state and mode transitions
  * - Coordinating sound effects and background audio
- * - Handling collisions and game logic
+ * - Reacting to collisions and level completion reported by the Simulation
+ *
+ * During normal play the simulation runs on its own thread at a fixed
+ * tick rate and publishes a RenderSnapshot after every tick. The main
+ * thread owns the window: it samples input, draws the newest snapshot and
+ * waits on refresh_screen, so a slow display never delays a tick. Menus,
+ * the pause screen, attract mode and end-of-round sequences run on the
+ * main thread with the simulation thread stopped.
  */
 class Game
 {
@@ -37,9 +57,9 @@ public:
     Game();
 
     /**
-     * @brief Destructor - ensures proper cleanup of resources
+     * @brief Destructor - stops the simulation thread if it is running
      */
-    ~Game() = default;
+    ~Game();
 
     /**
      * @brief Initialize all game systems and load resources
@@ -52,6 +72,36 @@ public:
      */
     void run();
 
+    // === Replay Playback ===
+
+    /**
+     * @brief Set up a recorded game to be stepped with step_replay()
+     * Use instead of run(), after initialize(). Menus, sound and the simulation thread are not used.
+     * @param replay Game to play back
+     */
+    void start_replay(const Replay &replay);
+
+    /**
+     * @brief Simulate the next tick of the replay and publish its snapshot
+     * @return false once the recorded game has ended (nothing was simulated)
+     */
+    bool step_replay();
+
+    /**
+     * @brief Snapshot published by the last step_replay()
+     */
+    const RenderSnapshot &replay_snapshot() const { return snapshots_.read_buffer(); }
+
+    /**
+     * @brief Maze of the level being played
+     */
+    const Maze &get_maze() const { return simulation_.get_maze(); }
+
+    /**
+     * @brief Score and pellets of the level being played
+     */
+    const GameState &get_game_state() const { return simulation_.get_game_state(); }
+
 private:
     // === Core Game Loop Methods ===
 
@@ -62,28 +112,104 @@ private:
     void update(double delta_time);
 
     /**
-     * @brief Render all game objects to the screen
+     * @brief Capture the world, pellets and HUD into the next render snapshot and publish it
+     * Called by whichever thread is currently running the simulation.
      */
-    void render();
+    void publish_snapshot();
+
+    /**
+     * @brief Draw the newest published snapshot (render thread)
+     * @param options Drawing options, such as option_to_bitmap() to draw into a cached frame
+     */
+    void present(const drawing_options &options = option_defaults());
+
+    /**
+     * @brief Take the newest published snapshot, if there is one, as the one to draw and hear
+     */
+    void acquire_snapshot();
+
+    /**
+     * @brief Play the background loop and sound effects of the newest acquired snapshot (main thread)
+     * SplashKit audio is only called from here, never from the simulation thread.
+     */
+    void play_audio_cues();
 
     /**
      * @brief Process input events and player input
+     * Queues each change of the held direction key, stamped with the time it was sampled,
+     * for the simulation thread to apply on the tick it falls in.
      */
     void handle_events();
 
+    /**
+     * @brief Present a gameplay frame and measure input-to-photon latency
+     * Called once per display frame; input keeps being sampled between frames.
+     */
+    void present_gameplay_frame();
+
+    /**
+     * @brief Sleep until the next gameplay frame is due
+     * Wakes once on the way, just before the simulation's next tick, so input held then is applied on that tick.
+     */
+    void wait_for_next_frame();
+
+    /**
+     * @brief Draw the latest snapshot dimmed, with the pause menu text over it
+     * @param options Drawing options, such as option_to_bitmap() to draw into a cached frame
+     */
+    void draw_pause_frame(const drawing_options &options);
+
+    // === Simulation Thread ===
+
+    /**
+     * @brief Start ticking the simulation on its own thread
+     */
+    void start_simulation();
+
+    /**
+     * @brief Stop the simulation thread and wait for it to finish its current tick
+     * Safe to call when the thread is not running.
+     */
+    void stop_simulation();
+
+    /**
+     * @brief Simulation thread body: fixed-rate update and publish until stopped or the round ends
+     */
+    void simulation_loop();
+
+    /**
+     * @brief Apply a direction change to Pac-Man's buffered turn and record it for the replay
+     * @param dir Direction now held, DIR_NONE once released
+     */
+    void apply_input(direction_t dir);
+
+    /**
+     * @brief Write the finished game's replay to ReplayConfig::LAST_REPLAY_PATH
+     */
+    void save_last_replay();
+
+    /**
+     * @brief Play out the end of a round (game over or level complete) on the main thread
+     */
+    void finish_round();
+
+    /**
+     * @brief Count a step's sound events into audio_cues_, for the main thread to play
+     */
+    void record_audio_cues(const StepEvents &events);
+
     // === Game Objects ===
-    std::unique_ptr<Maze> maze_;                  ///< Game maze and collision detection
-    std::unique_ptr<SpriteSheet> sprite_sheet_;   ///< Sprite graphics management
-    std::unique_ptr<Pacman> pacman_;              ///< Player character
-    std::unique_ptr<Ghost> ghost1_;               ///< First AI ghost
-    std::unique_ptr<Ghost> ghost2_;               ///< Second AI ghost
-    std::unique_ptr<Fruit> fruit_;                ///< Bonus fruit
-    std::unique_ptr<GameState> game_state_;       ///< Score, pellets, and game statistics
-    std::unique_ptr<SoundManager> sound_manager_; ///< Audio management
-    std::unique_ptr<Menu> menu_;                  ///< Menu system for navigation
+    Simulation simulation_;                                 ///< Maze, entities and score of the game being played
+    std::unique_ptr<SpriteSheet> sprite_sheet_;             ///< Sprite graphics management
+    std::unique_ptr<SoundManager> sound_manager_;           ///< Audio management
+    std::unique_ptr<Menu> menu_;                            ///< Menu system for navigation
+    std::unique_ptr<TextRenderer> text_renderer_;           ///< Glyph-cached text for HUD and menus
+    PacmanBot bot_;                                         ///< Computer player for attract mode
+    std::unique_ptr<SceneRenderer> scene_renderer_;         ///< Draws render snapshots
+    std::unique_ptr<OverlayCompositor> overlay_compositor_; ///< Cached frame for the pause screen and dying animation
 
     // === Game State ===
-    bool running_;                ///< Whether the game is currently running
+    std::atomic<bool> running_;   ///< Whether the game is currently running (read by the simulation thread)
     bool game_initialized_;       ///< Whether game entities have been created
     bool paused_;                 ///< Whether the game is currently paused
     double escape_key_cooldown_;  ///< Cooldown timer for escape key to prevent double-triggering
@@ -91,6 +217,46 @@ private:
     GameMode current_game_mode_;  ///< Current game mode (starting, normal, power, etc.)
     GameMode previous_game_mode_; ///< Previous mode for detecting transitions
     int current_level_;           ///< Current level (1-5)
+    bool attract_mode_;           ///< Whether the bot is playing a demo game
+    bool pause_frame_drawn_;      ///< Whether the pause screen has been presented since pausing
+    double last_activity_time_;   ///< Time of the last key press in the main menu (seconds)
+
+    // === Render Snapshots ===
+    TripleBuffer<RenderSnapshot> snapshots_;                           ///< Snapshots handed from the simulation to the renderer
+    std::uint64_t snapshot_sequence_;                                  ///< Sequence number of the last published snapshot
+    std::atomic<std::uint64_t> presented_sequence_;                    ///< Sequence number of the last snapshot the renderer took
+    std::vector<std::pair<std::uint64_t, int>> pending_tokens_;        ///< (sequence, index) of tokens not yet presented
+    std::vector<std::pair<std::uint64_t, int>> pending_power_pellets_; ///< (sequence, index) of power pellets not yet presented
+
+    // === Simulation Thread State ===
+    std::thread simulation_thread_;        ///< Runs simulation_loop during normal play
+    std::atomic<bool> simulation_running_; ///< Cleared to ask the simulation thread to stop
+    std::atomic<bool> round_over_;         ///< Set by the simulation thread on game over or level complete
+
+    // === Audio ===
+    AudioCues audio_cues_;                   ///< Sound events so far (whichever thread runs the simulation)
+    AudioCues played_audio_cues_;            ///< Sound events already played (main thread)
+    std::atomic<bool> start_sound_finished_; ///< Set by the main thread once start.wav has ended
+
+    // === Input ===
+    InputQueue input_queue_;                    ///< Direction changes from the main thread to the simulation thread
+    direction_t last_input_direction_;          ///< Direction held at the previous sample (main thread)
+    std::uint64_t applied_input_sequence_;      ///< Input events applied by the simulation (simulation thread)
+    InputClock::time_point applied_input_time_; ///< Sample time of the newest applied input (simulation thread)
+    InputLatencyMeter latency_meter_;           ///< Input-to-photon latency samples (main thread)
+    std::uint64_t measured_input_sequence_;     ///< Newest input already measured by latency_meter_
+    bool show_latency_;                         ///< Whether the latency readout is drawn (toggled with F1)
+    InputClock::time_point next_frame_time_;    ///< When the next gameplay frame is due
+    std::atomic<InputClock::rep> next_tick_;    ///< When the simulation thread next ticks (time_since_epoch count)
+
+    GhostTuning ghost_tuning_; ///< Ghost behaviour and difficulty speeds (GameConfig::GHOST_TUNING_PATH when present)
+
+    // === Replays ===
+    Replay replay_;                  ///< Game being recorded, or played back when replay_playback_ is set
+    bool replay_playback_;           ///< Whether replay_ drives the game instead of the player
+    ReplayPlayer replay_player_;     ///< Applies the playback rules to simulation_ during playback
+    std::uint32_t simulation_tick_;  ///< Ticks simulated since the game started
+    std::uint32_t scene_generation_; ///< Bumped every time the level is reset (RenderSnapshot::scene)
 
     // === Game Logic Helper Methods ===
 
@@ -99,6 +265,12 @@ private:
      */
     void initialize_game_entities();
 
+    /**
+     * @brief Point the renderer at the current maze and pellets and publish a fresh snapshot
+     * Call whenever the maze or GameState is replaced, with the simulation thread stopped.
+     */
+    void reset_scene();
+
     /**
      * @brief Update the current game mode based on game conditions
      * @param delta_time Time elapsed since last update (seconds)
@@ -112,24 +284,29 @@ private:
     GameMode determine_current_game_mode() const;
 
     /**
-     * @brief Handle collisions between Pac-Man and ghosts
+     * @brief Play Pac-Man's dying animation over the current scene
      */
-    void handle_ghost_collisions();
+    void play_dying_animation();
 
     /**
-     * @brief Check if the win condition has been met
-     * @return true if player has won, false otherwise
+     * @brief Advance to the next level
      */
-    bool check_win_condition();
+    void advance_to_next_level();
+
+    // === Attract Mode ===
 
     /**
-     * @brief Calculate the percentage of pellets remaining
-     * @return Percentage of pellets left (0-100)
+     * @brief Start the attract (demo) mode with the bot playing a random level
      */
-    double calculate_pellet_percentage() const;
+    void start_attract_mode();
 
     /**
-     * @brief Advance to the next level
+     * @brief Leave attract mode and return to the main menu
      */
-    void advance_to_next_level();
+    void end_attract_mode();
+
+    /**
+     * @brief Run one attract mode frame: several bot-driven simulation steps, then one draw
+     */
+    void run_attract_frame();
 };
\ No newline at end of file
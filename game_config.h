@@ -20,6 +20,11 @@ namespace GameConfig
     constexpr int WINDOW_WIDTH = MazeConfig::MAZE_COLS * MazeConfig::CELL_SIZE;
     constexpr int WINDOW_HEIGHT = MazeConfig::MAZE_ROWS * MazeConfig::CELL_SIZE;
     constexpr int TARGET_FPS = 60;
+    constexpr int IDLE_POLL_INTERVAL = 50; ///< Milliseconds between input polls while nothing on screen changes
+    constexpr int ATTRACT_FPS = 15;        ///< Frame rate of the attract (demo) mode
+    constexpr int SIMULATION_RATE = 60;    ///< Simulation ticks per second, independent of the display rate
+    constexpr int MAX_SIMULATION_LAG = 2;  ///< Ticks the simulation may fall behind before it skips ahead
+    constexpr int INPUT_SAMPLE_LEAD = 1;   ///< Milliseconds before each simulation tick that input is sampled for it
     constexpr const char *WINDOW_TITLE = "Pac-Man";
 
     // Graphics settings
@@ -30,4 +35,13 @@ namespace GameConfig
     constexpr double COLLISION_DISTANCE = 20.0;  ///< Distance for collision detection between entities (increased from 15 to prevent corner stuck bug)
     constexpr int GHOST_CATCH_POINTS = 200;      ///< Points awarded for catching a ghost
     constexpr int GAME_OVER_DISPLAY_TIME = 3000; ///< Time to display game over message (milliseconds)
+
+    // Difficulty settings
+    constexpr int DIFFICULTY_COUNT = 4; ///< EASY, MEDIUM, HARD, CRAZY
+    constexpr double DIFFICULTY_SPEED_MULTIPLIERS[DIFFICULTY_COUNT] = {0.75, 1.0, 1.25, 2.0}; ///< Speed per difficulty
+    constexpr const char *DIFFICULTY_NAMES[DIFFICULTY_COUNT] = {"easy", "medium", "hard", "crazy"}; ///< For tools and file names
+    constexpr const char *GHOST_TUNING_PATH = "Resources/ghost_tuning.txt"; ///< Optional ghost_tuner output the game plays with
+
+    // Attract mode settings
+    constexpr double ATTRACT_IDLE_TIMEOUT = 30.0; ///< Seconds of main menu inactivity before the demo starts
 }
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * @file game_mode.h
+ * @brief Phase of a round, shared by the game loop, render snapshots and the sound manager
+ */
+
+/**
+ * Game mode enumeration for sound management
+ * Determines which background sounds should be playing
+ */
+enum class GameMode
+{
+    STARTING,   ///< Game starting sequence (plays start.wav)
+    NORMAL,     ///< Ghosts chasing Pac-Man (plays ghost chase sounds)
+    POWER_MODE, ///< Pac-Man chasing scared ghosts (plays ghostblue.wav)
+    GAME_OVER,  ///< Game has ended (stops all sounds, plays die.wav)
+    VICTORY     ///< All pellets collected (stops all sounds)
+};
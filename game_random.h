@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @file game_random.h
+ * @brief Per-game random numbers, reproducing the sequence of the C library's srand()/rand()
+ *
+ * This file contains the GameRandom class. Each Simulation draws from its
+ * own generator instead of the process-wide rand(), so games can run side
+ * by side on several threads without sharing (or locking) random state.
+ * The algorithm is glibc's default additive feedback generator, so a seed
+ * produces exactly the numbers srand()/rand() gave it and replays recorded
+ * before the change still play back identically.
+ */
+
+/**
+ * @class GameRandom
+ * @brief Additive lagged Fibonacci generator (x[n] = x[n-3] + x[n-31]) seeded like srand()
+ */
+class GameRandom
+{
+public:
+    static constexpr std::uint32_t MAX = 0x7fffffff; ///< Largest value next() returns, as RAND_MAX
+
+    explicit GameRandom(std::uint32_t seed = 1) { reseed(seed); }
+
+    /**
+     * @brief Restart the sequence, as srand(seed) does
+     */
+    void reseed(std::uint32_t seed)
+    {
+        // Park-Miller minimal standard generator fills the table, computed without overflow (Schrage's method)
+        std::int32_t word = static_cast<std::int32_t>(seed == 0 ? 1 : seed);
+        state_[0] = static_cast<std::uint32_t>(word);
+        for (int i = 1; i < DEGREE; i++)
+        {
+            const std::int32_t hi = word / 127773;
+            const std::int32_t lo = word % 127773;
+            word = 16807 * lo - 2836 * hi;
+            if (word < 0)
+                word += 2147483647;
+            state_[i] = static_cast<std::uint32_t>(word);
+        }
+        front_ = SEPARATION;
+        rear_ = 0;
+
+        // The first values are poorly mixed and discarded
+        for (int i = 0; i < DEGREE * 10; i++)
+            next();
+    }
+
+    /**
+     * @brief Next number in [0, MAX], as rand() returns
+     */
+    std::uint32_t next()
+    {
+        state_[front_] += state_[rear_];
+        const std::uint32_t result = state_[front_] >> 1;
+        front_ = front_ + 1 == DEGREE ? 0 : front_ + 1;
+        rear_ = rear_ + 1 == DEGREE ? 0 : rear_ + 1;
+        return result;
+    }
+
+private:
+    static constexpr int DEGREE = 31;    ///< Length of the state table
+    static constexpr int SEPARATION = 3; ///< Distance between the two taps
+
+    std::array<std::uint32_t, DEGREE> state_{};
+    int front_ = SEPARATION;
+    int rear_ = 0;
+};
@@ -0,0 +1,93 @@
+#include "ghost_tuning.h"
+#include <cassert>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+/**
+ * @file ghost_tuning.cpp
+ * @brief Implementation of ghost tuning values and tuning files
+ */
+
+const double &ghost_tuning_value(const GhostTuning &tuning, int index)
+{
+    assert(index >= 0 && index < GHOST_TUNING_VALUE_COUNT);
+    switch (index)
+    {
+    case 0:
+        return tuning.lock_on_distance;
+    case 1:
+        return tuning.ambush_distance;
+    case 2:
+        return tuning.escape_distance;
+    case 3:
+        return tuning.random_dir_change_time;
+    case 4:
+        return tuning.scared_duration;
+    case 5:
+        return tuning.cooldown_duration;
+    default:
+        return tuning.speed_multipliers[index - GHOST_CONSTANT_COUNT];
+    }
+}
+
+double &ghost_tuning_value(GhostTuning &tuning, int index)
+{
+    return const_cast<double &>(ghost_tuning_value(std::as_const(tuning), index));
+}
+
+std::string ghost_tuning_value_name(int index)
+{
+    assert(index >= 0 && index < GHOST_TUNING_VALUE_COUNT);
+    static const char *const names[GHOST_CONSTANT_COUNT] = {"lock_on_distance", "ambush_distance", "escape_distance",
+                                                            "random_dir_change_time", "scared_duration",
+                                                            "cooldown_duration"};
+    if (index < GHOST_CONSTANT_COUNT)
+        return names[index];
+    return std::string("speed_") + GameConfig::DIFFICULTY_NAMES[index - GHOST_CONSTANT_COUNT];
+}
+
+bool save_ghost_tuning(const std::string &path, const GhostTuning &tuning)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+        return false;
+
+    // Enough digits that loading the file gives back exactly the same doubles
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (int i = 0; i < GHOST_TUNING_VALUE_COUNT; i++)
+    {
+        file << ghost_tuning_value_name(i) << " " << ghost_tuning_value(tuning, i) << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool load_ghost_tuning(const std::string &path, GhostTuning &tuning)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string name;
+        if (!(fields >> name) || name[0] == '#')
+            continue;
+
+        double value = 0.0;
+        if (!(fields >> value) || value <= 0.0)
+            return false;
+
+        int index = 0;
+        while (index < GHOST_TUNING_VALUE_COUNT && ghost_tuning_value_name(index) != name)
+            index++;
+        if (index == GHOST_TUNING_VALUE_COUNT)
+            return false;
+        ghost_tuning_value(tuning, index) = value;
+    }
+    return true;
+}
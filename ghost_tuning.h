@@ -0,0 +1,69 @@
+#pragma once
+
+#include "game_config.h"
+#include <array>
+#include <string>
+
+/**
+ * @file ghost_tuning.h
+ * @brief The ghost behaviour and difficulty constants as a runtime value that tools can vary
+ *
+ * How hard the game is comes down to a handful of numbers: how close a ghost
+ * must be to lock on, how far ahead the ambusher aims, how long ghosts stay
+ * scared or at home, and how fast each difficulty runs. GhostTuning holds
+ * them as plain fields so balancing tools can try other values in headless
+ * games; its defaults are the values the game has always used, so a default
+ * tuning plays exactly the games (and replays) it did before.
+ *
+ * Tunings are saved as text, one "name value" pair per line; names are
+ * listed by ghost_tuning_value_name. The game loads one from
+ * GameConfig::GHOST_TUNING_PATH at startup when the file exists.
+ */
+
+/**
+ * Ghost behaviour and difficulty speeds used by a game
+ */
+struct GhostTuning
+{
+    double lock_on_distance = 150.0;      ///< Chasing ghosts this close to Pac-Man head straight for him
+    double ambush_distance = 200.0;       ///< Distance ahead of Pac-Man the ambusher aims for
+    double escape_distance = 100.0;       ///< Scared ghosts flee when Pac-Man is this close
+    double random_dir_change_time = 2.0;  ///< Seconds between patrol direction changes
+    double scared_duration = 15.0;        ///< Seconds in scared mode (at 1x speed)
+    double cooldown_duration = 3.0;       ///< Seconds at home before chasing again
+    /// Speed multiplier per difficulty; callers pick one into SimulationSettings::speed_multiplier
+    std::array<double, GameConfig::DIFFICULTY_COUNT> speed_multipliers = {
+        GameConfig::DIFFICULTY_SPEED_MULTIPLIERS[0], GameConfig::DIFFICULTY_SPEED_MULTIPLIERS[1],
+        GameConfig::DIFFICULTY_SPEED_MULTIPLIERS[2], GameConfig::DIFFICULTY_SPEED_MULTIPLIERS[3]};
+};
+
+/// Number of ghost constants, which come before the speeds in GhostTuning value order
+constexpr int GHOST_CONSTANT_COUNT = 6;
+/// Number of values in a GhostTuning: the ghost constants, then one speed per difficulty
+constexpr int GHOST_TUNING_VALUE_COUNT = GHOST_CONSTANT_COUNT + GameConfig::DIFFICULTY_COUNT;
+
+/**
+ * @brief The index'th value of a tuning, for code that treats a tuning as a vector (such as a search)
+ * @param index 0 to GHOST_TUNING_VALUE_COUNT - 1 (asserted)
+ */
+const double &ghost_tuning_value(const GhostTuning &tuning, int index);
+double &ghost_tuning_value(GhostTuning &tuning, int index);
+
+/**
+ * @brief Name of the index'th value, as written in tuning files ("lock_on_distance", "speed_easy", ...)
+ * @param index 0 to GHOST_TUNING_VALUE_COUNT - 1 (asserted)
+ */
+std::string ghost_tuning_value_name(int index);
+
+/**
+ * @brief Write a tuning as "name value" lines
+ * @return false if the file could not be written
+ */
+bool save_ghost_tuning(const std::string &path, const GhostTuning &tuning);
+
+/**
+ * @brief Read a tuning written by save_ghost_tuning
+ * Values missing from the file keep the ones already in tuning; blank lines and lines starting with # are skipped.
+ * @return false if the file could not be read or has a line with an unknown name or a value that is not positive
+ */
+bool load_ghost_tuning(const std::string &path, GhostTuning &tuning);
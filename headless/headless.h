@@ -0,0 +1,74 @@
+#pragma once
+
+#include "splashkit.h"
+#include "software_rasterizer.h"
+#include <functional>
+#include <string>
+
+/**
+ * @file headless.h
+ * @brief Control and read-back API of the headless SplashKit backend
+ *
+ * Golden-image tests and render benchmarks use these functions to feed
+ * input to the game, control its clock and inspect the frames it draws.
+ * They exist only in the headless backend.
+ */
+
+/**
+ * @brief The window's framebuffer (empty until open_window is called)
+ */
+const Canvas &headless_screen();
+
+/**
+ * @brief Pixels of a bitmap created or loaded through the backend
+ * @return nullptr for a null bitmap
+ */
+const Canvas *headless_bitmap_canvas(bitmap bmp);
+
+/**
+ * @brief Number of refresh_screen calls since the window was opened
+ */
+unsigned int headless_frame_count();
+
+/**
+ * @brief Call a function with the framebuffer on every refresh_screen
+ * Pass an empty function to stop.
+ */
+void headless_set_present_callback(std::function<void(const Canvas &)> callback);
+
+/**
+ * @brief Write the framebuffer to a PNG file
+ * @return false if the file could not be written
+ */
+bool headless_save_screen(const std::string &path);
+
+/**
+ * @brief Hold a key down; it also reads as typed after the next process_events
+ */
+void headless_press_key(key_code key);
+
+/**
+ * @brief Release a held key
+ */
+void headless_release_key(key_code key);
+
+/**
+ * @brief Make window_close_requested return true
+ */
+void headless_request_close();
+
+/**
+ * @brief Switch between the real clock and a virtual one
+ *
+ * With the virtual clock current_ticks only moves when the game calls
+ * delay() or refresh_screen(fps), or through headless_advance_ticks(), and
+ * neither call sleeps. Runs are then reproducible and as fast as the CPU
+ * allows. The clock restarts from zero on every switch. Only SplashKit
+ * time is virtual: code that reads std::chrono clocks is unaffected.
+ */
+void headless_use_virtual_clock(bool enabled);
+
+/**
+ * @brief Move the virtual clock forward
+ */
+void headless_advance_ticks(unsigned int milliseconds);
@@ -0,0 +1,473 @@
+#include "software_rasterizer.h"
+#include "bitmap_font.h"
+#include <zlib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+/**
+ * @file software_rasterizer.cpp
+ * @brief Implementation of the Canvas primitives and PNG input/output
+ */
+
+using namespace BitmapFontConfig;
+
+namespace
+{
+    /**
+     * @brief First pixel whose centre is at or after a coordinate
+     */
+    int first_covered(double edge)
+    {
+        return static_cast<int>(std::ceil(edge - 0.5));
+    }
+
+    std::uint32_t read_u32_be(const unsigned char *bytes)
+    {
+        return static_cast<std::uint32_t>(bytes[0]) << 24 | static_cast<std::uint32_t>(bytes[1]) << 16 |
+               static_cast<std::uint32_t>(bytes[2]) << 8 | static_cast<std::uint32_t>(bytes[3]);
+    }
+
+    void append_u32_be(std::vector<unsigned char> &out, std::uint32_t value)
+    {
+        out.push_back(static_cast<unsigned char>(value >> 24));
+        out.push_back(static_cast<unsigned char>(value >> 16));
+        out.push_back(static_cast<unsigned char>(value >> 8));
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    void append_chunk(std::vector<unsigned char> &out, const char *type, const std::vector<unsigned char> &data)
+    {
+        append_u32_be(out, static_cast<std::uint32_t>(data.size()));
+        const std::size_t type_start = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        append_u32_be(out, static_cast<std::uint32_t>(crc32(0, out.data() + type_start, static_cast<uInt>(out.size() - type_start))));
+    }
+
+    int paeth(int a, int b, int c)
+    {
+        const int p = a + b - c;
+        const int pa = std::abs(p - a);
+        const int pb = std::abs(p - b);
+        const int pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc)
+            return a;
+        return pb <= pc ? b : c;
+    }
+
+    /**
+     * @brief Undo PNG scanline filters in place
+     * @return false on an unknown filter type
+     */
+    bool unfilter(std::vector<unsigned char> &data, int height, std::size_t stride, int bytes_per_pixel)
+    {
+        for (int y = 0; y < height; y++)
+        {
+            unsigned char *row = &data[y * (stride + 1)];
+            const unsigned char *prior = y > 0 ? &data[(y - 1) * (stride + 1) + 1] : nullptr;
+            const unsigned char filter = row[0];
+            unsigned char *line = row + 1;
+
+            for (std::size_t i = 0; i < stride; i++)
+            {
+                const int left = i >= static_cast<std::size_t>(bytes_per_pixel) ? line[i - bytes_per_pixel] : 0;
+                const int up = prior ? prior[i] : 0;
+                const int up_left = (prior && i >= static_cast<std::size_t>(bytes_per_pixel)) ? prior[i - bytes_per_pixel] : 0;
+
+                switch (filter)
+                {
+                case 0:
+                    break;
+                case 1:
+                    line[i] = static_cast<unsigned char>(line[i] + left);
+                    break;
+                case 2:
+                    line[i] = static_cast<unsigned char>(line[i] + up);
+                    break;
+                case 3:
+                    line[i] = static_cast<unsigned char>(line[i] + (left + up) / 2);
+                    break;
+                case 4:
+                    line[i] = static_cast<unsigned char>(line[i] + paeth(left, up, up_left));
+                    break;
+                default:
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+int bitmap_font_scale(int font_size)
+{
+    // One font pixel per 8 points keeps the line height equal to the font size
+    return std::max(1, font_size / CELL_HEIGHT);
+}
+
+// ============== Canvas Implementation ==============
+
+Canvas::Canvas(int width, int height)
+    : width_(std::max(0, width)), height_(std::max(0, height)),
+      pixels_(static_cast<std::size_t>(width_) * height_, make_pixel(0, 0, 0, 0)), clip_{0, 0, width_, height_}
+{
+}
+
+void Canvas::clear(Pixel colour)
+{
+    std::fill(pixels_.begin(), pixels_.end(), colour);
+}
+
+void Canvas::set_clip(const PixelRect &clip)
+{
+    const int left = std::clamp(clip.x, 0, width_);
+    const int top = std::clamp(clip.y, 0, height_);
+    const int right = std::clamp(clip.x + clip.w, left, width_);
+    const int bottom = std::clamp(clip.y + clip.h, top, height_);
+    clip_ = {left, top, right - left, bottom - top};
+}
+
+void Canvas::reset_clip()
+{
+    clip_ = {0, 0, width_, height_};
+}
+
+void Canvas::blend(int x, int y, Pixel colour)
+{
+    if (x < clip_.x || y < clip_.y || x >= clip_.x + clip_.w || y >= clip_.y + clip_.h)
+        return;
+
+    const int src_a = pixel_a(colour);
+    if (src_a == 0)
+        return;
+
+    Pixel &dst = pixels_[static_cast<std::size_t>(y) * width_ + x];
+    if (src_a == 255)
+    {
+        dst = colour;
+        return;
+    }
+
+    // Source-over with straight alpha
+    const int dst_a = pixel_a(dst) * (255 - src_a) / 255;
+    const int out_a = src_a + dst_a;
+    auto channel = [&](int src, int dest)
+    {
+        return static_cast<std::uint8_t>((src * src_a + dest * dst_a + out_a / 2) / out_a);
+    };
+    dst = make_pixel(channel(pixel_r(colour), pixel_r(dst)), channel(pixel_g(colour), pixel_g(dst)),
+                     channel(pixel_b(colour), pixel_b(dst)), static_cast<std::uint8_t>(out_a));
+}
+
+void Canvas::fill_rectangle(Pixel colour, double x, double y, double w, double h)
+{
+    if (w < 0)
+    {
+        x += w;
+        w = -w;
+    }
+    if (h < 0)
+    {
+        y += h;
+        h = -h;
+    }
+
+    const int left = std::max(first_covered(x), clip_.x);
+    const int right = std::min(first_covered(x + w), clip_.x + clip_.w);
+    const int top = std::max(first_covered(y), clip_.y);
+    const int bottom = std::min(first_covered(y + h), clip_.y + clip_.h);
+
+    for (int py = top; py < bottom; py++)
+    {
+        for (int px = left; px < right; px++)
+        {
+            blend(px, py, colour);
+        }
+    }
+}
+
+void Canvas::fill_circle(Pixel colour, double cx, double cy, double radius)
+{
+    if (radius <= 0)
+        return;
+
+    const int top = std::max(first_covered(cy - radius), clip_.y);
+    const int bottom = std::min(first_covered(cy + radius), clip_.y + clip_.h);
+
+    for (int py = top; py < bottom; py++)
+    {
+        const double dy = py + 0.5 - cy;
+        const double half_width = std::sqrt(std::max(0.0, radius * radius - dy * dy));
+        const int left = std::max(first_covered(cx - half_width), clip_.x);
+        const int right = std::min(first_covered(cx + half_width), clip_.x + clip_.w);
+        for (int px = left; px < right; px++)
+        {
+            blend(px, py, colour);
+        }
+    }
+}
+
+void Canvas::draw_circle(Pixel colour, double cx, double cy, double radius)
+{
+    if (radius <= 0)
+        return;
+
+    const int left = std::max(first_covered(cx - radius - 0.5), clip_.x);
+    const int right = std::min(first_covered(cx + radius + 0.5), clip_.x + clip_.w);
+    const int top = std::max(first_covered(cy - radius - 0.5), clip_.y);
+    const int bottom = std::min(first_covered(cy + radius + 0.5), clip_.y + clip_.h);
+
+    // A pixel is on the outline when its centre is within half a pixel of the circle
+    for (int py = top; py < bottom; py++)
+    {
+        const double dy = py + 0.5 - cy;
+        for (int px = left; px < right; px++)
+        {
+            const double dx = px + 0.5 - cx;
+            if (std::abs(std::sqrt(dx * dx + dy * dy) - radius) < 0.5)
+            {
+                blend(px, py, colour);
+            }
+        }
+    }
+}
+
+void Canvas::draw_canvas(const Canvas &source, PixelRect part, double x, double y, double scale_x, double scale_y,
+                         bool flip_x, bool flip_y)
+{
+    // Clamp the part to the source, moving the destination with its top-left corner
+    const int clamped_x = std::clamp(part.x, 0, source.width_);
+    const int clamped_y = std::clamp(part.y, 0, source.height_);
+    x += clamped_x - part.x;
+    y += clamped_y - part.y;
+    part.w = std::min(part.x + part.w, source.width_) - clamped_x;
+    part.h = std::min(part.y + part.h, source.height_) - clamped_y;
+    part.x = clamped_x;
+    part.y = clamped_y;
+    if (part.w <= 0 || part.h <= 0)
+        return;
+
+    scale_x = std::abs(scale_x);
+    scale_y = std::abs(scale_y);
+    const double dest_w = part.w * scale_x;
+    const double dest_h = part.h * scale_y;
+    if (dest_w <= 0 || dest_h <= 0)
+        return;
+
+    // Scale about the centre of the part
+    const double dest_x = x + (part.w - dest_w) / 2.0;
+    const double dest_y = y + (part.h - dest_h) / 2.0;
+
+    const int left = std::max(first_covered(dest_x), clip_.x);
+    const int right = std::min(first_covered(dest_x + dest_w), clip_.x + clip_.w);
+    const int top = std::max(first_covered(dest_y), clip_.y);
+    const int bottom = std::min(first_covered(dest_y + dest_h), clip_.y + clip_.h);
+
+    for (int py = top; py < bottom; py++)
+    {
+        int v = std::min(part.h - 1, static_cast<int>((py + 0.5 - dest_y) / scale_y));
+        if (flip_y)
+            v = part.h - 1 - v;
+
+        for (int px = left; px < right; px++)
+        {
+            int u = std::min(part.w - 1, static_cast<int>((px + 0.5 - dest_x) / scale_x));
+            if (flip_x)
+                u = part.w - 1 - u;
+
+            blend(px, py, source.pixel_at(part.x + u, part.y + v));
+        }
+    }
+}
+
+void Canvas::draw_text(const std::string &text, Pixel colour, int font_size, double x, double y)
+{
+    const int scale = bitmap_font_scale(font_size);
+    const int origin_x = static_cast<int>(std::lround(x));
+    const int origin_y = static_cast<int>(std::lround(y));
+
+    for (std::size_t i = 0; i < text.size(); i++)
+    {
+        const char c = text[i];
+        const int index = (c >= BITMAP_FONT_FIRST && c <= BITMAP_FONT_LAST) ? c - BITMAP_FONT_FIRST : '?' - BITMAP_FONT_FIRST;
+        const int glyph_x = origin_x + static_cast<int>(i) * CELL_WIDTH * scale;
+
+        for (int row = 0; row < GLYPH_HEIGHT; row++)
+        {
+            const std::uint8_t bits = BITMAP_FONT[index][row];
+            for (int col = 0; col < GLYPH_WIDTH; col++)
+            {
+                if (bits & (1 << (GLYPH_WIDTH - 1 - col)))
+                {
+                    fill_rectangle(colour, glyph_x + col * scale, origin_y + row * scale, scale, scale);
+                }
+            }
+        }
+    }
+}
+
+// ============== Image Utilities ==============
+
+ImageDiff compare_canvases(const Canvas &a, const Canvas &b, int tolerance)
+{
+    ImageDiff diff;
+    if (a.width() != b.width() || a.height() != b.height())
+        return diff;
+
+    diff.same_size = true;
+    const std::vector<Pixel> &pa = a.pixels();
+    const std::vector<Pixel> &pb = b.pixels();
+    for (std::size_t i = 0; i < pa.size(); i++)
+    {
+        const int delta = std::max({std::abs(pixel_r(pa[i]) - pixel_r(pb[i])), std::abs(pixel_g(pa[i]) - pixel_g(pb[i])),
+                                    std::abs(pixel_b(pa[i]) - pixel_b(pb[i])), std::abs(pixel_a(pa[i]) - pixel_a(pb[i]))});
+        diff.max_channel_delta = std::max(diff.max_channel_delta, delta);
+        if (delta > tolerance)
+            diff.differing_pixels++;
+    }
+    return diff;
+}
+
+bool load_png(const std::string &path, Canvas &canvas)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    const std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    static const unsigned char SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (bytes.size() < 8 || !std::equal(SIGNATURE, SIGNATURE + 8, bytes.begin()))
+        return false;
+
+    int width = 0, height = 0, bit_depth = 0, colour_type = 0, interlace = 0;
+    std::vector<unsigned char> compressed;
+    std::vector<Pixel> palette;
+
+    std::size_t pos = 8;
+    while (pos + 12 <= bytes.size())
+    {
+        const std::uint32_t length = read_u32_be(&bytes[pos]);
+        const std::string type(reinterpret_cast<const char *>(&bytes[pos + 4]), 4);
+        const unsigned char *data = &bytes[pos + 8];
+        if (pos + 12 + length > bytes.size())
+            return false;
+
+        if (type == "IHDR" && length >= 13)
+        {
+            width = static_cast<int>(read_u32_be(data));
+            height = static_cast<int>(read_u32_be(data + 4));
+            bit_depth = data[8];
+            colour_type = data[9];
+            interlace = data[12];
+        }
+        else if (type == "PLTE")
+        {
+            for (std::uint32_t i = 0; i + 2 < length; i += 3)
+            {
+                palette.push_back(make_pixel(data[i], data[i + 1], data[i + 2], 255));
+            }
+        }
+        else if (type == "tRNS" && colour_type == 3)
+        {
+            for (std::uint32_t i = 0; i < length && i < palette.size(); i++)
+            {
+                palette[i] = (palette[i] & 0x00FFFFFFu) | static_cast<Pixel>(data[i]) << 24;
+            }
+        }
+        else if (type == "IDAT")
+        {
+            compressed.insert(compressed.end(), data, data + length);
+        }
+        else if (type == "IEND")
+        {
+            break;
+        }
+        pos += 12 + length;
+    }
+
+    int channels = 0;
+    switch (colour_type)
+    {
+    case 0: channels = 1; break;
+    case 2: channels = 3; break;
+    case 3: channels = 1; break;
+    case 4: channels = 2; break;
+    case 6: channels = 4; break;
+    default: return false;
+    }
+    if (width <= 0 || height <= 0 || bit_depth != 8 || interlace != 0 || (colour_type == 3 && palette.empty()))
+        return false;
+
+    const std::size_t stride = static_cast<std::size_t>(width) * channels;
+    std::vector<unsigned char> raw((stride + 1) * height);
+    uLongf raw_size = static_cast<uLongf>(raw.size());
+    if (uncompress(raw.data(), &raw_size, compressed.data(), static_cast<uLong>(compressed.size())) != Z_OK ||
+        raw_size != raw.size())
+        return false;
+    if (!unfilter(raw, height, stride, channels))
+        return false;
+
+    canvas = Canvas(width, height);
+    std::vector<Pixel> &pixels = canvas.pixels();
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *line = &raw[y * (stride + 1) + 1];
+        for (int x = 0; x < width; x++)
+        {
+            const unsigned char *p = line + x * channels;
+            Pixel &out = pixels[static_cast<std::size_t>(y) * width + x];
+            switch (colour_type)
+            {
+            case 0: out = make_pixel(p[0], p[0], p[0], 255); break;
+            case 2: out = make_pixel(p[0], p[1], p[2], 255); break;
+            case 3: out = p[0] < palette.size() ? palette[p[0]] : make_pixel(0, 0, 0, 255); break;
+            case 4: out = make_pixel(p[0], p[0], p[0], p[1]); break;
+            case 6: out = make_pixel(p[0], p[1], p[2], p[3]); break;
+            }
+        }
+    }
+    return true;
+}
+
+bool save_png(const std::string &path, const Canvas &canvas)
+{
+    const int width = canvas.width();
+    const int height = canvas.height();
+
+    // Every scanline uses filter type 0 followed by raw RGBA
+    const std::size_t stride = static_cast<std::size_t>(width) * 4;
+    std::vector<unsigned char> raw;
+    raw.reserve((stride + 1) * height);
+    for (int y = 0; y < height; y++)
+    {
+        raw.push_back(0);
+        for (int x = 0; x < width; x++)
+        {
+            const Pixel p = canvas.pixel_at(x, y);
+            raw.insert(raw.end(), {pixel_r(p), pixel_g(p), pixel_b(p), pixel_a(p)});
+        }
+    }
+
+    std::vector<unsigned char> compressed(compressBound(static_cast<uLong>(raw.size())));
+    uLongf compressed_size = static_cast<uLongf>(compressed.size());
+    if (compress2(compressed.data(), &compressed_size, raw.data(), static_cast<uLong>(raw.size()), Z_BEST_SPEED) != Z_OK)
+        return false;
+    compressed.resize(compressed_size);
+
+    std::vector<unsigned char> header;
+    append_u32_be(header, static_cast<std::uint32_t>(width));
+    append_u32_be(header, static_cast<std::uint32_t>(height));
+    header.insert(header.end(), {8, 6, 0, 0, 0}); // 8-bit RGBA, deflate, no filter set, no interlace
+
+    std::vector<unsigned char> out = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    append_chunk(out, "IHDR", header);
+    append_chunk(out, "IDAT", compressed);
+    append_chunk(out, "IEND", {});
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(out.data()), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
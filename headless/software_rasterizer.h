@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file software_rasterizer.h
+ * @brief CPU framebuffer and the drawing primitives the game uses
+ *
+ * This file contains the Canvas class and the primitives the headless
+ * SplashKit backend draws with: rectangles, filled and outlined circles,
+ * bitmap blits (part, scale and flip) and fixed-size bitmap-font text.
+ * Every primitive is deterministic so rendered frames can be compared
+ * pixel for pixel against golden images.
+ */
+
+/**
+ * Packed 8-bit RGBA colour, red in the lowest byte (R, G, B, A in memory)
+ */
+using Pixel = std::uint32_t;
+
+/**
+ * @brief Pack 8-bit channels into a Pixel
+ */
+constexpr Pixel make_pixel(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a)
+{
+    return static_cast<Pixel>(r) | static_cast<Pixel>(g) << 8 | static_cast<Pixel>(b) << 16 | static_cast<Pixel>(a) << 24;
+}
+
+constexpr std::uint8_t pixel_r(Pixel p) { return static_cast<std::uint8_t>(p); }
+constexpr std::uint8_t pixel_g(Pixel p) { return static_cast<std::uint8_t>(p >> 8); }
+constexpr std::uint8_t pixel_b(Pixel p) { return static_cast<std::uint8_t>(p >> 16); }
+constexpr std::uint8_t pixel_a(Pixel p) { return static_cast<std::uint8_t>(p >> 24); }
+
+/**
+ * Integer pixel rectangle (half-open: covers x <= px < x + w)
+ */
+struct PixelRect
+{
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+};
+
+/**
+ * Bitmap font constants
+ * Glyphs are 5x7 in a 6x8 cell and are scaled up by whole pixels per font size.
+ */
+namespace BitmapFontConfig
+{
+    constexpr int GLYPH_WIDTH = 5;
+    constexpr int GLYPH_HEIGHT = 7;
+    constexpr int CELL_WIDTH = 6;  ///< Advance of one glyph at scale 1
+    constexpr int CELL_HEIGHT = 8; ///< Line height at scale 1
+}
+
+/**
+ * @brief Pixel scale used to draw text of a given font size
+ */
+int bitmap_font_scale(int font_size);
+
+/**
+ * @class Canvas
+ * @brief A width x height RGBA image that can be drawn into
+ *
+ * Drawing blends source-over with straight alpha and is clipped to the
+ * canvas and to the current clip rectangle. Shapes cover the pixels whose
+ * centres fall inside them, so results do not depend on drawing order
+ * within a shape.
+ */
+class Canvas
+{
+public:
+    Canvas() = default;
+
+    /**
+     * @brief Create a canvas filled with transparent black
+     */
+    Canvas(int width, int height);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    const std::vector<Pixel> &pixels() const { return pixels_; }
+    std::vector<Pixel> &pixels() { return pixels_; }
+
+    Pixel pixel_at(int x, int y) const { return pixels_[static_cast<std::size_t>(y) * width_ + x]; }
+
+    /**
+     * @brief Overwrite every pixel (no blending, ignores the clip)
+     */
+    void clear(Pixel colour);
+
+    /**
+     * @brief Restrict drawing to a rectangle (intersected with the canvas)
+     */
+    void set_clip(const PixelRect &clip);
+
+    /**
+     * @brief Allow drawing anywhere on the canvas again
+     */
+    void reset_clip();
+
+    /**
+     * @brief Fill an axis-aligned rectangle
+     */
+    void fill_rectangle(Pixel colour, double x, double y, double w, double h);
+
+    /**
+     * @brief Fill a circle
+     */
+    void fill_circle(Pixel colour, double cx, double cy, double radius);
+
+    /**
+     * @brief Draw a one-pixel circle outline
+     */
+    void draw_circle(Pixel colour, double cx, double cy, double radius);
+
+    /**
+     * @brief Blit part of another canvas
+     *
+     * The part is scaled about its own centre, as SplashKit does, so a
+     * scaled blit stays centred on the same point as an unscaled one.
+     * Sampling is nearest-neighbour.
+     *
+     * @param source Canvas to read from
+     * @param part Source rectangle (clamped to the source)
+     * @param x Left edge of the unscaled destination
+     * @param y Top edge of the unscaled destination
+     * @param scale_x Horizontal scale
+     * @param scale_y Vertical scale
+     * @param flip_x Mirror horizontally
+     * @param flip_y Mirror vertically
+     */
+    void draw_canvas(const Canvas &source, PixelRect part, double x, double y, double scale_x, double scale_y,
+                     bool flip_x, bool flip_y);
+
+    /**
+     * @brief Draw text in the built-in bitmap font
+     * Characters outside printable ASCII are drawn as '?'.
+     */
+    void draw_text(const std::string &text, Pixel colour, int font_size, double x, double y);
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<Pixel> pixels_;
+    PixelRect clip_; ///< Drawable area, always inside the canvas
+
+    void blend(int x, int y, Pixel colour);
+};
+
+/**
+ * Result of comparing two images
+ */
+struct ImageDiff
+{
+    bool same_size = false;   ///< false if the dimensions differ (nothing else is filled in)
+    int differing_pixels = 0; ///< Pixels with any channel further apart than the tolerance
+    int max_channel_delta = 0;
+};
+
+/**
+ * @brief Compare two canvases channel by channel
+ * @param tolerance Largest per-channel difference that still counts as equal
+ */
+ImageDiff compare_canvases(const Canvas &a, const Canvas &b, int tolerance = 0);
+
+/**
+ * @brief Decode an 8-bit non-interlaced PNG (greyscale, RGB, palette or with alpha)
+ * @return false if the file is missing or uses a format outside that subset
+ */
+bool load_png(const std::string &path, Canvas &canvas);
+
+/**
+ * @brief Encode a canvas as an RGBA PNG
+ * @return false if the file could not be written
+ */
+bool save_png(const std::string &path, const Canvas &canvas);
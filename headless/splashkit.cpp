@@ -0,0 +1,596 @@
+#include "headless.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file splashkit.cpp
+ * @brief Headless implementation of the SplashKit subset in splashkit.h
+ *
+ * All drawing goes through Canvas. The window is a canvas like any other
+ * bitmap; the render target (or a drawing option's dest) picks which
+ * canvas a call draws into.
+ *
+ * The render target and clip stack are per thread, and creating, loading
+ * and freeing bitmaps and sounds is locked. Threads that each draw into
+ * their own target bitmap can therefore render at the same time, sharing
+ * loaded bitmaps read-only. Everything else belongs to the main thread.
+ */
+
+struct _bitmap_data
+{
+    std::string name;
+    Canvas canvas;
+};
+
+struct _sound_data
+{
+    std::string name;
+};
+
+const color COLOR_BLACK = {0.0f, 0.0f, 0.0f, 1.0f};
+const color COLOR_WHITE = {1.0f, 1.0f, 1.0f, 1.0f};
+const color COLOR_YELLOW = {1.0f, 1.0f, 0.0f, 1.0f};
+const color COLOR_RED = {1.0f, 0.0f, 0.0f, 1.0f};
+const color COLOR_GREEN = {0.0f, 128.0f / 255.0f, 0.0f, 1.0f};
+const color COLOR_BLUE = {0.0f, 0.0f, 1.0f, 1.0f};
+const color COLOR_PURPLE = {128.0f / 255.0f, 0.0f, 128.0f / 255.0f, 1.0f};
+const color COLOR_ORANGE = {1.0f, 165.0f / 255.0f, 0.0f, 1.0f};
+const color COLOR_GRAY = {128.0f / 255.0f, 128.0f / 255.0f, 128.0f / 255.0f, 1.0f};
+const color COLOR_TRANSPARENT = {1.0f, 1.0f, 1.0f, 0.0f};
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Everything the backend keeps between calls
+     */
+    struct HeadlessState
+    {
+        _bitmap_data window;
+
+        std::mutex resources_mutex; ///< Guards bitmaps, named_bitmaps and sounds
+        std::map<bitmap, std::unique_ptr<_bitmap_data>> bitmaps;
+        std::map<std::string, bitmap> named_bitmaps;
+        std::map<std::string, std::unique_ptr<_sound_data>> sounds;
+
+        bool held[KEY_CODE_COUNT] = {};
+        bool typed[KEY_CODE_COUNT] = {};
+        bool pending_typed[KEY_CODE_COUNT] = {};
+        bool close_requested = false;
+
+        bool virtual_clock = false;
+        unsigned int virtual_ticks = 0;
+        Clock::time_point clock_start = Clock::now();
+        unsigned int last_refresh_ticks = 0;
+
+        unsigned int frame_count = 0;
+        std::function<void(const Canvas &)> present_callback;
+    };
+
+    /**
+     * Drawing state kept separately by every thread
+     */
+    struct ThreadTarget
+    {
+        bitmap render_target = nullptr; ///< nullptr draws to the window
+        std::vector<PixelRect> clip_stack;
+    };
+
+    HeadlessState &state()
+    {
+        static HeadlessState instance;
+        return instance;
+    }
+
+    ThreadTarget &thread_target()
+    {
+        thread_local ThreadTarget target;
+        return target;
+    }
+
+    Pixel to_pixel(const color &clr)
+    {
+        auto channel = [](float value)
+        {
+            return static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+        };
+        return make_pixel(channel(clr.r), channel(clr.g), channel(clr.b), channel(clr.a));
+    }
+
+    Canvas &target_canvas()
+    {
+        bitmap target = thread_target().render_target;
+        return target ? target->canvas : state().window.canvas;
+    }
+
+    Canvas &destination_canvas(const drawing_options &opts)
+    {
+        return opts.dest ? opts.dest->canvas : target_canvas();
+    }
+
+    bool valid_key(key_code key)
+    {
+        return key > UNKNOWN_KEY && key < KEY_CODE_COUNT;
+    }
+
+    void sleep_ms(unsigned int milliseconds)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    }
+}
+
+color rgba_color(int red, int green, int blue, int alpha)
+{
+    return {red / 255.0f, green / 255.0f, blue / 255.0f, alpha / 255.0f};
+}
+
+color rgb_color(int red, int green, int blue)
+{
+    return rgba_color(red, green, blue, 255);
+}
+
+// ============== Window and Events ==============
+
+void open_window(const string &caption, int width, int height)
+{
+    HeadlessState &s = state();
+    s.window.name = caption;
+    s.window.canvas = Canvas(width, height);
+    s.window.canvas.clear(make_pixel(0, 0, 0, 255));
+    s.frame_count = 0;
+}
+
+bool window_close_requested(const string &)
+{
+    return state().close_requested;
+}
+
+void process_events()
+{
+    HeadlessState &s = state();
+    std::copy(std::begin(s.pending_typed), std::end(s.pending_typed), std::begin(s.typed));
+    std::fill(std::begin(s.pending_typed), std::end(s.pending_typed), false);
+}
+
+bool key_down(key_code key)
+{
+    return valid_key(key) && state().held[key];
+}
+
+bool key_typed(key_code key)
+{
+    return valid_key(key) && state().typed[key];
+}
+
+bool any_key_pressed()
+{
+    const HeadlessState &s = state();
+    return std::any_of(std::begin(s.typed), std::end(s.typed), [](bool typed) { return typed; });
+}
+
+// ============== Timing ==============
+
+unsigned int current_ticks()
+{
+    const HeadlessState &s = state();
+    if (s.virtual_clock)
+        return s.virtual_ticks;
+
+    return static_cast<unsigned int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - s.clock_start).count());
+}
+
+void delay(int milliseconds)
+{
+    if (milliseconds <= 0)
+        return;
+
+    HeadlessState &s = state();
+    if (s.virtual_clock)
+        s.virtual_ticks += static_cast<unsigned int>(milliseconds);
+    else
+        sleep_ms(static_cast<unsigned int>(milliseconds));
+}
+
+// ============== Screen ==============
+
+void refresh_screen()
+{
+    HeadlessState &s = state();
+    s.frame_count++;
+    s.last_refresh_ticks = current_ticks();
+    if (s.present_callback)
+        s.present_callback(s.window.canvas);
+}
+
+void refresh_screen(unsigned int target_fps)
+{
+    // Hold frames to the target rate, as SplashKit does
+    HeadlessState &s = state();
+    if (target_fps > 0)
+    {
+        const unsigned int due = s.last_refresh_ticks + 1000 / target_fps;
+        const unsigned int now = current_ticks();
+        if (now < due)
+            delay(static_cast<int>(due - now));
+    }
+    refresh_screen();
+}
+
+void clear_screen()
+{
+    clear_screen(COLOR_WHITE);
+}
+
+void clear_screen(const color &clr)
+{
+    target_canvas().clear(to_pixel(clr));
+}
+
+void push_clip(const rectangle &r)
+{
+    // Each clip is intersected with the one it is pushed over
+    ThreadTarget &s = thread_target();
+    Canvas &canvas = target_canvas();
+    const PixelRect outer = s.clip_stack.empty() ? PixelRect{0, 0, canvas.width(), canvas.height()} : s.clip_stack.back();
+
+    const int left = std::max(outer.x, static_cast<int>(std::lround(r.x)));
+    const int top = std::max(outer.y, static_cast<int>(std::lround(r.y)));
+    const int right = std::min(outer.x + outer.w, static_cast<int>(std::lround(r.x + r.width)));
+    const int bottom = std::min(outer.y + outer.h, static_cast<int>(std::lround(r.y + r.height)));
+    s.clip_stack.push_back({left, top, std::max(0, right - left), std::max(0, bottom - top)});
+    canvas.set_clip(s.clip_stack.back());
+}
+
+void pop_clip()
+{
+    ThreadTarget &s = thread_target();
+    if (!s.clip_stack.empty())
+        s.clip_stack.pop_back();
+
+    if (s.clip_stack.empty())
+        target_canvas().reset_clip();
+    else
+        target_canvas().set_clip(s.clip_stack.back());
+}
+
+// ============== Shapes ==============
+
+void fill_rectangle(const color &clr, double x, double y, double width, double height)
+{
+    target_canvas().fill_rectangle(to_pixel(clr), x, y, width, height);
+}
+
+void fill_rectangle(const color &clr, double x, double y, double width, double height, const drawing_options &opts)
+{
+    destination_canvas(opts).fill_rectangle(to_pixel(clr), x, y, width, height);
+}
+
+void fill_rectangle(const color &clr, const rectangle &r)
+{
+    fill_rectangle(clr, r.x, r.y, r.width, r.height);
+}
+
+void fill_circle(const color &clr, double x, double y, double radius)
+{
+    target_canvas().fill_circle(to_pixel(clr), x, y, radius);
+}
+
+void fill_circle(const color &clr, double x, double y, double radius, const drawing_options &opts)
+{
+    destination_canvas(opts).fill_circle(to_pixel(clr), x, y, radius);
+}
+
+void draw_circle(const color &clr, double x, double y, double radius)
+{
+    target_canvas().draw_circle(to_pixel(clr), x, y, radius);
+}
+
+void draw_circle(const color &clr, double x, double y, double radius, const drawing_options &opts)
+{
+    destination_canvas(opts).draw_circle(to_pixel(clr), x, y, radius);
+}
+
+rectangle rectangle_from(double x, double y, double width, double height)
+{
+    return {x, y, width, height};
+}
+
+bool rectangles_intersect(const rectangle &rect1, const rectangle &rect2)
+{
+    return rect1.x < rect2.x + rect2.width && rect2.x < rect1.x + rect1.width && rect1.y < rect2.y + rect2.height &&
+           rect2.y < rect1.y + rect1.height;
+}
+
+// ============== Bitmaps ==============
+
+bitmap load_bitmap(const string &name, const string &filename)
+{
+    HeadlessState &s = state();
+    std::lock_guard<std::mutex> lock(s.resources_mutex);
+    auto existing = s.named_bitmaps.find(name);
+    if (existing != s.named_bitmaps.end())
+        return existing->second;
+
+    auto data = std::make_unique<_bitmap_data>();
+    if (!load_png(filename, data->canvas))
+        return nullptr;
+
+    data->name = name;
+    bitmap bmp = data.get();
+    s.bitmaps.emplace(bmp, std::move(data));
+    s.named_bitmaps.emplace(name, bmp);
+    return bmp;
+}
+
+bitmap create_bitmap(const string &name, int width, int height)
+{
+    HeadlessState &s = state();
+    std::lock_guard<std::mutex> lock(s.resources_mutex);
+    auto data = std::make_unique<_bitmap_data>();
+    data->name = name;
+    data->canvas = Canvas(width, height);
+
+    bitmap bmp = data.get();
+    s.bitmaps.emplace(bmp, std::move(data));
+    if (!name.empty())
+        s.named_bitmaps[name] = bmp;
+    return bmp;
+}
+
+bitmap create_bitmap(int width, int height)
+{
+    return create_bitmap("", width, height);
+}
+
+void free_bitmap(bitmap bmp)
+{
+    HeadlessState &s = state();
+    std::lock_guard<std::mutex> lock(s.resources_mutex);
+    auto it = s.bitmaps.find(bmp);
+    if (it == s.bitmaps.end())
+        return;
+
+    auto named = s.named_bitmaps.find(bmp->name);
+    if (named != s.named_bitmaps.end() && named->second == bmp)
+        s.named_bitmaps.erase(named);
+    if (thread_target().render_target == bmp)
+        thread_target().render_target = nullptr;
+    s.bitmaps.erase(it);
+}
+
+void clear_bitmap(bitmap bmp, const color &clr)
+{
+    if (bmp)
+        bmp->canvas.clear(to_pixel(clr));
+}
+
+int bitmap_width(bitmap bmp)
+{
+    return bmp ? bmp->canvas.width() : 0;
+}
+
+int bitmap_height(bitmap bmp)
+{
+    return bmp ? bmp->canvas.height() : 0;
+}
+
+void draw_bitmap(bitmap bmp, double x, double y)
+{
+    draw_bitmap(bmp, x, y, option_defaults());
+}
+
+void draw_bitmap(bitmap bmp, double x, double y, const drawing_options &opts)
+{
+    if (bmp == nullptr)
+        return;
+
+    PixelRect part{0, 0, bmp->canvas.width(), bmp->canvas.height()};
+    if (opts.is_part)
+    {
+        part = {static_cast<int>(std::lround(opts.part.x)), static_cast<int>(std::lround(opts.part.y)),
+                static_cast<int>(std::lround(opts.part.width)), static_cast<int>(std::lround(opts.part.height))};
+    }
+
+    destination_canvas(opts).draw_canvas(bmp->canvas, part, x, y, opts.scale_x, opts.scale_y, opts.flip_x, opts.flip_y);
+}
+
+bitmap get_render_target()
+{
+    return thread_target().render_target;
+}
+
+void set_render_target(bitmap bmp)
+{
+    // Clips are kept by each canvas, so switching targets leaves the window's clip in place
+    thread_target().render_target = bmp;
+}
+
+drawing_options option_defaults()
+{
+    return drawing_options();
+}
+
+drawing_options option_part_bmp(double x, double y, double width, double height)
+{
+    return option_part_bmp(x, y, width, height, option_defaults());
+}
+
+drawing_options option_part_bmp(double x, double y, double width, double height, drawing_options opts)
+{
+    opts.is_part = true;
+    opts.part = {x, y, width, height};
+    return opts;
+}
+
+drawing_options option_flip_x(drawing_options opts)
+{
+    opts.flip_x = true;
+    return opts;
+}
+
+drawing_options option_flip_y(drawing_options opts)
+{
+    opts.flip_y = true;
+    return opts;
+}
+
+drawing_options option_scale_bmp(double scale_x, double scale_y, drawing_options opts)
+{
+    opts.scale_x = static_cast<float>(scale_x);
+    opts.scale_y = static_cast<float>(scale_y);
+    return opts;
+}
+
+drawing_options option_to_bitmap(bitmap destination)
+{
+    return option_to_bitmap(destination, option_defaults());
+}
+
+drawing_options option_to_bitmap(bitmap destination, drawing_options opts)
+{
+    opts.dest = destination;
+    return opts;
+}
+
+// ============== Text ==============
+
+void draw_text(const string &text, const color &clr, const string &, int font_size, double x, double y)
+{
+    target_canvas().draw_text(text, to_pixel(clr), font_size, x, y);
+}
+
+void draw_text(const string &text, const color &clr, const string &, int font_size, double x, double y,
+               const drawing_options &opts)
+{
+    destination_canvas(opts).draw_text(text, to_pixel(clr), font_size, x, y);
+}
+
+void draw_text_on_bitmap(bitmap bmp, const string &text, const color &clr, const string &, int font_size, double x, double y)
+{
+    if (bmp)
+        bmp->canvas.draw_text(text, to_pixel(clr), font_size, x, y);
+}
+
+int text_width(const string &text, const string &, int font_size)
+{
+    return static_cast<int>(text.size()) * BitmapFontConfig::CELL_WIDTH * bitmap_font_scale(font_size);
+}
+
+int text_height(const string &, const string &, int font_size)
+{
+    return BitmapFontConfig::CELL_HEIGHT * bitmap_font_scale(font_size);
+}
+
+// ============== Sound ==============
+
+sound_effect load_sound_effect(const string &name, const string &)
+{
+    std::lock_guard<std::mutex> lock(state().resources_mutex);
+    std::unique_ptr<_sound_data> &effect = state().sounds[name];
+    if (!effect)
+        effect = std::make_unique<_sound_data>(_sound_data{name});
+    return effect.get();
+}
+
+bool has_sound_effect(const string &name)
+{
+    std::lock_guard<std::mutex> lock(state().resources_mutex);
+    return state().sounds.count(name) > 0;
+}
+
+sound_effect sound_effect_named(const string &name)
+{
+    std::lock_guard<std::mutex> lock(state().resources_mutex);
+    auto it = state().sounds.find(name);
+    return it != state().sounds.end() ? it->second.get() : nullptr;
+}
+
+void free_sound_effect(sound_effect effect)
+{
+    std::lock_guard<std::mutex> lock(state().resources_mutex);
+    if (effect)
+        state().sounds.erase(effect->name);
+}
+
+void play_sound_effect(const string &) {}
+void play_sound_effect(const string &, int) {}
+void play_sound_effect(const string &, int, double) {}
+void play_sound_effect(sound_effect) {}
+void play_sound_effect(sound_effect, int) {}
+
+bool sound_effect_playing(const string &)
+{
+    return false;
+}
+
+void stop_sound_effect(const string &) {}
+void stop_sound_effect(sound_effect) {}
+
+// ============== Headless Control ==============
+
+const Canvas &headless_screen()
+{
+    return state().window.canvas;
+}
+
+const Canvas *headless_bitmap_canvas(bitmap bmp)
+{
+    return bmp ? &bmp->canvas : nullptr;
+}
+
+unsigned int headless_frame_count()
+{
+    return state().frame_count;
+}
+
+void headless_set_present_callback(std::function<void(const Canvas &)> callback)
+{
+    state().present_callback = std::move(callback);
+}
+
+bool headless_save_screen(const std::string &path)
+{
+    return save_png(path, state().window.canvas);
+}
+
+void headless_press_key(key_code key)
+{
+    if (!valid_key(key))
+        return;
+
+    state().held[key] = true;
+    state().pending_typed[key] = true;
+}
+
+void headless_release_key(key_code key)
+{
+    if (valid_key(key))
+        state().held[key] = false;
+}
+
+void headless_request_close()
+{
+    state().close_requested = true;
+}
+
+void headless_use_virtual_clock(bool enabled)
+{
+    HeadlessState &s = state();
+    s.virtual_clock = enabled;
+    s.virtual_ticks = 0;
+    s.clock_start = Clock::now();
+    s.last_refresh_ticks = 0;
+}
+
+void headless_advance_ticks(unsigned int milliseconds)
+{
+    state().virtual_ticks += milliseconds;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <string>
+
+/**
+ * @file splashkit.h
+ * @brief Headless stand-in for the part of the SplashKit API the game uses
+ *
+ * Building with this directory on the include path (instead of linking
+ * SplashKit) renders every frame into a CPU framebuffer: no window,
+ * display or audio device is needed. Signatures match SplashKit so the
+ * game sources compile unchanged. Tests and tools drive the backend and
+ * read frames back through headless.h.
+ *
+ * Differences from SplashKit:
+ * - Text is drawn in a built-in 5x7 bitmap font whatever font is named
+ * - Sounds are silent and finish as soon as they start
+ * - get_render_target()/set_render_target() are provided, and the CMake
+ *   build defines SPLASHKIT_RENDER_TARGETS with this backend so the
+ *   sprite sheet's trimmed-frame cache is used (the overlay compositor
+ *   draws through option_to_bitmap and needs no render targets)
+ */
+
+using std::string;
+
+struct color
+{
+    float r;
+    float g;
+    float b;
+    float a;
+};
+
+struct rectangle
+{
+    double x;
+    double y;
+    double width;
+    double height;
+};
+
+struct _bitmap_data;
+typedef _bitmap_data *bitmap;
+
+struct _sound_data;
+typedef _sound_data *sound_effect;
+
+/**
+ * Drawing options (the fields the game reads or writes)
+ */
+struct drawing_options
+{
+    bitmap dest = nullptr; ///< Bitmap to draw onto, nullptr for the current render target
+    float scale_x = 1.0f;
+    float scale_y = 1.0f;
+    bool flip_x = false;
+    bool flip_y = false;
+    bool is_part = false;
+    rectangle part = {0, 0, 0, 0};
+};
+
+enum key_code
+{
+    UNKNOWN_KEY = 0,
+    RETURN_KEY,
+    ESCAPE_KEY,
+    SPACE_KEY,
+    UP_KEY,
+    DOWN_KEY,
+    LEFT_KEY,
+    RIGHT_KEY,
+    F1_KEY,
+    KEY_CODE_COUNT
+};
+
+extern const color COLOR_BLACK;
+extern const color COLOR_WHITE;
+extern const color COLOR_YELLOW;
+extern const color COLOR_RED;
+extern const color COLOR_GREEN;
+extern const color COLOR_BLUE;
+extern const color COLOR_PURPLE;
+extern const color COLOR_ORANGE;
+extern const color COLOR_GRAY;
+extern const color COLOR_TRANSPARENT;
+
+color rgba_color(int red, int green, int blue, int alpha);
+color rgb_color(int red, int green, int blue);
+
+// === Window and events ===
+void open_window(const string &caption, int width, int height);
+bool window_close_requested(const string &name);
+void process_events();
+bool key_down(key_code key);
+bool key_typed(key_code key);
+bool any_key_pressed();
+
+// === Timing ===
+unsigned int current_ticks();
+void delay(int milliseconds);
+
+// === Screen ===
+void refresh_screen();
+void refresh_screen(unsigned int target_fps);
+void clear_screen();
+void clear_screen(const color &clr);
+void push_clip(const rectangle &r);
+void pop_clip();
+
+// === Shapes ===
+void fill_rectangle(const color &clr, double x, double y, double width, double height);
+void fill_rectangle(const color &clr, const rectangle &r);
+void fill_rectangle(const color &clr, double x, double y, double width, double height, const drawing_options &opts);
+void fill_circle(const color &clr, double x, double y, double radius);
+void fill_circle(const color &clr, double x, double y, double radius, const drawing_options &opts);
+void draw_circle(const color &clr, double x, double y, double radius);
+void draw_circle(const color &clr, double x, double y, double radius, const drawing_options &opts);
+
+rectangle rectangle_from(double x, double y, double width, double height);
+bool rectangles_intersect(const rectangle &rect1, const rectangle &rect2);
+
+// === Bitmaps ===
+bitmap load_bitmap(const string &name, const string &filename);
+bitmap create_bitmap(const string &name, int width, int height);
+bitmap create_bitmap(int width, int height);
+void free_bitmap(bitmap bmp);
+void clear_bitmap(bitmap bmp, const color &clr);
+int bitmap_width(bitmap bmp);
+int bitmap_height(bitmap bmp);
+void draw_bitmap(bitmap bmp, double x, double y);
+void draw_bitmap(bitmap bmp, double x, double y, const drawing_options &opts);
+bitmap get_render_target();
+void set_render_target(bitmap bmp);
+
+drawing_options option_defaults();
+drawing_options option_part_bmp(double x, double y, double width, double height);
+drawing_options option_part_bmp(double x, double y, double width, double height, drawing_options opts);
+drawing_options option_flip_x(drawing_options opts);
+drawing_options option_flip_y(drawing_options opts);
+drawing_options option_scale_bmp(double scale_x, double scale_y, drawing_options opts);
+drawing_options option_to_bitmap(bitmap destination);
+drawing_options option_to_bitmap(bitmap destination, drawing_options opts);
+
+// === Text ===
+void draw_text(const string &text, const color &clr, const string &fnt, int font_size, double x, double y);
+void draw_text(const string &text, const color &clr, const string &fnt, int font_size, double x, double y, const drawing_options &opts);
+void draw_text_on_bitmap(bitmap bmp, const string &text, const color &clr, const string &fnt, int font_size, double x, double y);
+int text_width(const string &text, const string &fnt, int font_size);
+int text_height(const string &text, const string &fnt, int font_size);
+
+// === Sound ===
+sound_effect load_sound_effect(const string &name, const string &path);
+bool has_sound_effect(const string &name);
+sound_effect sound_effect_named(const string &name);
+void free_sound_effect(sound_effect effect);
+void play_sound_effect(const string &name);
+void play_sound_effect(const string &name, int times);
+void play_sound_effect(const string &name, int times, double volume);
+void play_sound_effect(sound_effect effect);
+void play_sound_effect(sound_effect effect, int times);
+bool sound_effect_playing(const string &name);
+void stop_sound_effect(const string &name);
+void stop_sound_effect(sound_effect effect);
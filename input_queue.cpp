@@ -0,0 +1,67 @@
+#include "input_queue.h"
+#include <algorithm>
+
+using namespace InputConfig;
+
+// ============== InputQueue Implementation ==============
+
+bool InputQueue::push(const InputEvent &event)
+{
+    const std::uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == QUEUE_CAPACITY)
+        return false;
+
+    events_[tail & (QUEUE_CAPACITY - 1)] = event;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool InputQueue::pop_until(InputClock::time_point time, InputEvent &event)
+{
+    const std::uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire))
+        return false;
+
+    const InputEvent &oldest = events_[head & (QUEUE_CAPACITY - 1)];
+    if (oldest.time > time)
+        return false;
+
+    event = oldest;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void InputQueue::clear()
+{
+    head_.store(tail_.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+// ============== InputLatencyMeter Implementation ==============
+
+InputLatencyMeter::InputLatencyMeter() : samples_{}, count_(0), next_(0), last_ms_(0.0) {}
+
+void InputLatencyMeter::record(InputClock::duration latency)
+{
+    last_ms_ = std::chrono::duration<double, std::milli>(latency).count();
+    samples_[next_] = last_ms_;
+    next_ = (next_ + 1) % LATENCY_WINDOW;
+    count_ = std::min(count_ + 1, LATENCY_WINDOW);
+}
+
+double InputLatencyMeter::average_ms() const
+{
+    if (count_ == 0)
+        return 0.0;
+
+    double total = 0.0;
+    for (int i = 0; i < count_; i++)
+    {
+        total += samples_[i];
+    }
+    return total / count_;
+}
+
+double InputLatencyMeter::max_ms() const
+{
+    return count_ == 0 ? 0.0 : *std::max_element(samples_.begin(), samples_.begin() + count_);
+}
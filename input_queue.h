@@ -0,0 +1,124 @@
+#pragma once
+
+#include "direction.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @file input_queue.h
+ * @brief Timestamped player input handed from the main thread to the simulation
+ *
+ * This file contains the InputQueue class, which carries direction changes
+ * to the simulation thread in order with the time they were sampled, and
+ * the InputLatencyMeter used for the input-to-photon readout.
+ */
+
+using InputClock = std::chrono::steady_clock;
+
+/**
+ * Input configuration constants
+ */
+namespace InputConfig
+{
+    constexpr std::uint32_t QUEUE_CAPACITY = 64; ///< Pending direction changes (power of two)
+    constexpr int LATENCY_WINDOW = 60;           ///< Latency samples averaged by the readout
+}
+
+/**
+ * A direction change and the time it was sampled
+ */
+struct InputEvent
+{
+    direction_t dir = DIR_NONE;  ///< Direction key now held, DIR_NONE once all are released
+    InputClock::time_point time; ///< When the change was sampled
+};
+
+/**
+ * @class InputQueue
+ * @brief Lock-free single-producer, single-consumer queue of input events
+ *
+ * The main thread pushes each direction change as soon as it is sampled;
+ * the simulation thread pops, at the start of each tick, every event
+ * stamped no later than that tick's scheduled time. An input therefore
+ * lands on the tick it happened in, even when the simulation is catching
+ * up on several ticks at once, and taps shorter than a tick are not lost.
+ */
+class InputQueue
+{
+public:
+    InputQueue() = default;
+
+    InputQueue(const InputQueue &) = delete;
+    InputQueue &operator=(const InputQueue &) = delete;
+
+    /**
+     * @brief Producer: append an event
+     * @return false if the queue is full and the event was dropped
+     */
+    bool push(const InputEvent &event);
+
+    /**
+     * @brief Consumer: take the oldest event if it was sampled at or before the given time
+     * @param time Scheduled time of the tick being simulated
+     * @param event Receives the event
+     * @return true if an event was taken
+     */
+    bool pop_until(InputClock::time_point time, InputEvent &event);
+
+    /**
+     * @brief Drop every pending event
+     * Call only while the consumer is stopped.
+     */
+    void clear();
+
+private:
+    static_assert((InputConfig::QUEUE_CAPACITY & (InputConfig::QUEUE_CAPACITY - 1)) == 0,
+                  "QUEUE_CAPACITY must be a power of two");
+
+    std::array<InputEvent, InputConfig::QUEUE_CAPACITY> events_;
+    std::atomic<std::uint32_t> head_{0}; ///< Next event to pop (written by the consumer)
+    std::atomic<std::uint32_t> tail_{0}; ///< Next free slot (written by the producer)
+};
+
+/**
+ * @class InputLatencyMeter
+ * @brief Rolling statistics of input-to-photon latency
+ *
+ * A sample is the time from a direction change being sampled to the
+ * return of the first refresh_screen that presented a frame simulated
+ * with it.
+ */
+class InputLatencyMeter
+{
+public:
+    InputLatencyMeter();
+
+    /**
+     * @brief Add a latency sample
+     * @param latency Time from input sample to presentation
+     */
+    void record(InputClock::duration latency);
+
+    /**
+     * @brief Latest sample (milliseconds), 0 before the first sample
+     */
+    double last_ms() const { return last_ms_; }
+
+    /**
+     * @brief Mean of the last LATENCY_WINDOW samples (milliseconds)
+     */
+    double average_ms() const;
+
+    /**
+     * @brief Largest of the last LATENCY_WINDOW samples (milliseconds)
+     */
+    double max_ms() const;
+
+private:
+    std::array<double, InputConfig::LATENCY_WINDOW> samples_; ///< Ring of recent samples (milliseconds)
+    int count_;                                               ///< Samples stored, up to LATENCY_WINDOW
+    int next_;                                                ///< Slot the next sample is written to
+    double last_ms_;
+};
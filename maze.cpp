@@ -18,7 +18,7 @@ Maze::Maze(int level) : level_(level)
     {
         // Fallback to hardcoded layout if CSV loading fails
         std::cerr << "Failed to load level " << level << ", using fallback layout" << std::endl;
-        maze_layout_ = {
+        set_layout({
             // row 0
             {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
             // row 1
@@ -44,7 +44,30 @@ Maze::Maze(int level) : level_(level)
             // row 11
             {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
             // row 12
-            {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}};
+            {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}});
+    }
+}
+
+void Maze::set_layout(const std::vector<std::vector<int>> &rows)
+{
+    for (int row = 0; row < MAZE_ROWS; row++)
+    {
+        for (int col = 0; col < MAZE_COLS; col++)
+        {
+            maze_layout_[row][col] = rows[row][col];
+        }
+    }
+
+    walkable_cells_.clear();
+    for (int row = 0; row < MAZE_ROWS; row++)
+    {
+        for (int col = 0; col < MAZE_COLS; col++)
+        {
+            if (is_empty(row, col))
+            {
+                walkable_cells_.push_back({row, col});
+            }
+        }
     }
 }
 
@@ -64,7 +87,7 @@ bool Maze::load_from_csv(const std::string &filename)
 
     debug << "File opened successfully!" << std::endl;
 
-    maze_layout_.clear();
+    std::vector<std::vector<int>> rows;
     std::string line;
     int line_number = 0;
 
@@ -164,29 +187,29 @@ bool Maze::load_from_csv(const std::string &filename)
         {
             debug << "Line " << line_number << ": parsed " << row.size() << " columns" << std::endl;
             debug.flush();
-            maze_layout_.push_back(row);
+            rows.push_back(row);
         }
     }
 
-    debug << "Finished reading. Total rows parsed: " << maze_layout_.size() << std::endl;
+    debug << "Finished reading. Total rows parsed: " << rows.size() << std::endl;
     debug.flush();
 
     file.close();
 
     // Validate maze dimensions
-    if (maze_layout_.size() != MAZE_ROWS)
+    if (rows.size() != MAZE_ROWS)
     {
-        debug << "Invalid maze row count: " << maze_layout_.size() << " (expected " << MAZE_ROWS << ")" << std::endl;
+        debug << "Invalid maze row count: " << rows.size() << " (expected " << MAZE_ROWS << ")" << std::endl;
         debug.flush();
         debug.close();
         return false;
     }
 
-    for (size_t i = 0; i < maze_layout_.size(); i++)
+    for (size_t i = 0; i < rows.size(); i++)
     {
-        if (maze_layout_[i].size() != MAZE_COLS)
+        if (rows[i].size() != MAZE_COLS)
         {
-            debug << "Invalid maze column count on row " << i << ": " << maze_layout_[i].size() << " (expected " << MAZE_COLS << ")" << std::endl;
+            debug << "Invalid maze column count on row " << i << ": " << rows[i].size() << " (expected " << MAZE_COLS << ")" << std::endl;
             debug.flush();
             debug.close();
             return false;
@@ -196,6 +219,8 @@ bool Maze::load_from_csv(const std::string &filename)
     debug << "Maze loaded successfully!" << std::endl;
     debug.flush();
     debug.close();
+
+    set_layout(rows);
     return true;
 }
 
@@ -213,14 +238,6 @@ double Token::get_y() const
     return Maze::get_cell_center_y(row_);
 }
 
-void Token::draw() const
-{
-    if (!collected_)
-    {
-        fill_circle(COLOR_YELLOW, get_x(), get_y(), TOKEN_RADIUS);
-    }
-}
-
 // ============== PowerPellet Implementation ==============
 
 PowerPellet::PowerPellet(int row, int col) : row_(row), col_(col), collected_(false) {}
@@ -235,24 +252,10 @@ double PowerPellet::get_y() const
     return Maze::get_cell_center_y(row_);
 }
 
-void PowerPellet::draw() const
-{
-    if (!collected_)
-    {
-        // Draw pulsing power pellet
-        static int pulse_timer = 0;
-        pulse_timer++;
-        double pulse = 1.0 + 0.3 * sin(pulse_timer * 0.2);
-        double radius = POWER_PELLET_RADIUS * pulse;
-
-        fill_circle(COLOR_YELLOW, get_x(), get_y(), radius);
-        draw_circle(COLOR_WHITE, get_x(), get_y(), radius + 1);
-    }
-}
-
 // ============== GameState Implementation ==============
 
-GameState::GameState() : score_(0), tokens_collected_(0), total_tokens_(0), token_just_collected_(false) {}
+GameState::GameState()
+    : score_(0), tokens_collected_(0), total_tokens_(0), token_just_collected_(false) {}
 
 void GameState::add_token(int row, int col)
 {
@@ -265,23 +268,13 @@ void GameState::add_power_pellet(int row, int col)
     power_pellets_.emplace_back(row, col);
 }
 
-int GameState::count_collected_power_pellets() const
-{
-    int count = 0;
-    for (const auto &power_pellet : power_pellets_)
-    {
-        if (power_pellet.is_collected())
-            count++;
-    }
-    return count;
-}
-
 bool GameState::check_token_collection(double pacman_x, double pacman_y)
 {
     bool collected_any = false;
 
-    for (auto &token : tokens_)
+    for (size_t i = 0; i < tokens_.size(); i++)
     {
+        Token &token = tokens_[i];
         if (!token.is_collected())
         {
             double dx = pacman_x - token.get_x();
@@ -293,6 +286,7 @@ bool GameState::check_token_collection(double pacman_x, double pacman_y)
                 token.collect();
                 add_score(TOKEN_POINTS);
                 tokens_collected_++;
+                newly_collected_tokens_.push_back(static_cast<int>(i));
                 collected_any = true;
                 token_just_collected_ = true; // Set flag for sound effect
             }
@@ -306,8 +300,9 @@ bool GameState::check_power_pellet_collection(double pacman_x, double pacman_y)
 {
     bool collected_any = false;
 
-    for (auto &power_pellet : power_pellets_)
+    for (size_t i = 0; i < power_pellets_.size(); i++)
     {
+        PowerPellet &power_pellet = power_pellets_[i];
         if (!power_pellet.is_collected())
         {
             double dx = pacman_x - power_pellet.get_x();
@@ -318,7 +313,8 @@ bool GameState::check_power_pellet_collection(double pacman_x, double pacman_y)
             {
                 power_pellet.collect();
                 add_score(POWER_PELLET_POINTS);
-                // Power pellet collected - ghosts will be set to scared in game loop
+                newly_collected_power_pellets_.push_back(static_cast<int>(i));
+                // The caller scares the ghosts when this returns true
                 collected_any = true;
             }
         }
@@ -327,70 +323,24 @@ bool GameState::check_power_pellet_collection(double pacman_x, double pacman_y)
     return collected_any;
 }
 
-void GameState::draw_tokens() const
-{
-    for (const auto &token : tokens_)
-    {
-        token.draw();
-    }
-}
-
-void GameState::draw_power_pellets() const
+void GameState::drain_collected_pellets(std::vector<int> &tokens, std::vector<int> &power_pellets)
 {
-    for (const auto &power_pellet : power_pellets_)
-    {
-        power_pellet.draw();
-    }
-}
-
-void GameState::draw_score() const
-{
-    std::string score_text = "SCORE: " + std::to_string(score_);
-    draw_text(score_text, COLOR_WHITE, "Arial", 24, 10, 10);
-
-    std::string tokens_text = "PELLETS: " + std::to_string(tokens_collected_) + "/" + std::to_string(total_tokens_);
-    draw_text(tokens_text, COLOR_WHITE, "Arial", 16, 10, 40);
+    tokens.insert(tokens.end(), newly_collected_tokens_.begin(), newly_collected_tokens_.end());
+    power_pellets.insert(power_pellets.end(), newly_collected_power_pellets_.begin(), newly_collected_power_pellets_.end());
+    newly_collected_tokens_.clear();
+    newly_collected_power_pellets_.clear();
 }
 
 // ============== Maze Implementation ==============
 
-color Maze::get_level_color() const
-{
-    switch (level_)
-    {
-    case 1:
-        return COLOR_BLUE;
-    case 2:
-        return COLOR_GREEN;
-    case 3:
-        return COLOR_PURPLE;
-    case 4:
-        return COLOR_RED;
-    case 5:
-        return COLOR_ORANGE; // Using orange for level 5
-    default:
-        return COLOR_BLUE; // Default fallback
-    }
-}
-
-void Maze::draw() const
+bool Maze::is_empty(int row, int col) const
 {
-    color wall_color = get_level_color();
-    for (int r = 0; r < MAZE_ROWS; r++)
-    {
-        for (int c = 0; c < MAZE_COLS; c++)
-        {
-            if (maze_layout_[r][c] == 1)
-            {
-                fill_rectangle(wall_color, c * CELL_SIZE, r * CELL_SIZE, CELL_SIZE, CELL_SIZE);
-            }
-        }
-    }
+    return is_valid_position(row, col) && maze_layout_[row][col] == 0;
 }
 
-bool Maze::is_empty(int row, int col) const
+bool Maze::is_wall(int row, int col) const
 {
-    return is_valid_position(row, col) && maze_layout_[row][col] == 0;
+    return is_valid_position(row, col) && maze_layout_[row][col] == 1;
 }
 
 bool Maze::can_move_to(double x, double y) const
@@ -442,7 +392,7 @@ void Maze::initialize_tokens(GameState &game_state, int spawn_row, int spawn_col
 void Maze::initialize_power_pellets(GameState &game_state) const
 {
     // Place power pellets in the four corners of open areas
-    std::vector<std::pair<int, int>> power_pellet_positions = {
+    constexpr std::pair<int, int> power_pellet_positions[] = {
         {1, 1}, {1, MAZE_COLS - 2}, {MAZE_ROWS - 2, 1}, {MAZE_ROWS - 2, MAZE_COLS - 2}};
 
     for (const auto &pos : power_pellet_positions)
@@ -1,7 +1,8 @@
 #pragma once
 
-#include "splashkit.h"
 #include "direction.h"
+#include "fixed_vector.h"
+#include <array>
 #include <vector>
 #include <string>
 #include <cmath>
@@ -16,6 +17,7 @@ namespace MazeConfig
 {
     constexpr int MAZE_ROWS = 13;
     constexpr int MAZE_COLS = 25;
+    constexpr int MAZE_CELLS = MAZE_ROWS * MAZE_COLS;
     constexpr int CELL_SIZE = 40;
     constexpr double SPEED = 120.0;            // pixels per second (was 2.0 pixels per frame at 60fps)
     constexpr double ANIMATION_DURATION = 0.2; // seconds per animation frame (was 12 frames at 60fps)
@@ -32,7 +34,8 @@ namespace MazeConfig
     constexpr int POWER_PELLET_POINTS = 50;
     constexpr double POWER_PELLET_RADIUS = 8.0;
     constexpr double POWER_PELLET_COLLECTION_DISTANCE = 20.0;
-    // Power mode duration removed - using individual ghost SCARED_DURATION
+    constexpr int MAX_POWER_PELLETS = 4; // One per corner
+    // Power mode duration removed - using individual ghost GhostTuning::scared_duration
 }
 
 /**
@@ -41,6 +44,7 @@ namespace MazeConfig
 class Token
 {
 public:
+    Token() = default;
     Token(int row, int col);
 
     // Getters
@@ -52,11 +56,10 @@ public:
 
     // Actions
     void collect() { collected_ = true; }
-    void draw() const;
 
 private:
-    int row_, col_;
-    bool collected_;
+    int row_ = 0, col_ = 0;
+    bool collected_ = false;
 };
 
 /**
@@ -65,6 +68,7 @@ private:
 class PowerPellet
 {
 public:
+    PowerPellet() = default;
     PowerPellet(int row, int col);
 
     // Getters
@@ -76,15 +80,15 @@ public:
 
     // Actions
     void collect() { collected_ = true; }
-    void draw() const;
 
 private:
-    int row_, col_;
-    bool collected_;
+    int row_ = 0, col_ = 0;
+    bool collected_ = false;
 };
 
 /**
  * GameState class - Manages score, tokens, and game statistics
+ * Pellets are stored inline (a level has at most one per cell), so a GameState never allocates
  */
 class GameState
 {
@@ -102,17 +106,21 @@ public:
     int get_total_tokens() const { return total_tokens_; }
     bool all_tokens_collected() const { return tokens_collected_ >= total_tokens_; }
 
-    // Power pellet tracking (for ghost management)
-    int count_collected_power_pellets() const;
+    const FixedVector<Token, MazeConfig::MAZE_CELLS> &get_tokens() const { return tokens_; }
+    const FixedVector<PowerPellet, MazeConfig::MAX_POWER_PELLETS> &get_power_pellets() const { return power_pellets_; }
 
-    // Game operations
+    // Game operations (each returns whether anything was collected this call)
     bool check_token_collection(double pacman_x, double pacman_y);
     bool check_power_pellet_collection(double pacman_x, double pacman_y);
-    void draw_tokens() const;
-    void draw_power_pellets() const;
-    void draw_score() const;
     void update(double delta_time);
 
+    // Move the indices of pellets collected since the last call onto the given lists (the renderer's dirty lists)
+    void drain_collected_pellets(std::vector<int> &tokens, std::vector<int> &power_pellets);
+
+    // Indices of pellets collected since the last drain, oldest first, without draining them
+    const FixedVector<int, MazeConfig::MAZE_CELLS> &get_newly_collected_tokens() const { return newly_collected_tokens_; }
+    const FixedVector<int, MazeConfig::MAX_POWER_PELLETS> &get_newly_collected_power_pellets() const { return newly_collected_power_pellets_; }
+
     // Sound-related methods
     bool was_token_just_collected() const { return token_just_collected_; }
     void reset_token_collection_flag() { token_just_collected_ = false; }
@@ -121,10 +129,14 @@ private:
     int score_;
     int tokens_collected_;
     int total_tokens_;
-    std::vector<Token> tokens_;
-    std::vector<PowerPellet> power_pellets_;
+    FixedVector<Token, MazeConfig::MAZE_CELLS> tokens_;
+    FixedVector<PowerPellet, MazeConfig::MAX_POWER_PELLETS> power_pellets_;
     bool token_just_collected_; // Flag for sound effects
 
+    // Pellets collected since the last drain_collected_pellets call
+    FixedVector<int, MazeConfig::MAZE_CELLS> newly_collected_tokens_;
+    FixedVector<int, MazeConfig::MAX_POWER_PELLETS> newly_collected_power_pellets_;
+
     // Power mode state
     // Power mode removed - using individual ghost timers only
 };
@@ -132,18 +144,20 @@ private:
 /**
  * Maze class - Represents the game maze with walls and empty spaces
  * Walls are represented by 1, empty spaces by 0
+ * The layout is stored inline, so a loaded Maze is copied without allocating
  */
 class Maze
 {
 public:
     Maze(int level = 1);
 
-    // Rendering
-    void draw() const;
+    // Level number (1-5), which also picks the wall colour when drawn
+    int get_level() const { return level_; }
 
     // Collision and movement
     bool can_move_to(double x, double y) const;
     bool is_empty(int row, int col) const;
+    bool is_wall(int row, int col) const;
     bool is_empty_or_tunnel(int row, int col) const;
 
     // Utility methods
@@ -157,17 +171,16 @@ public:
     // Helper function
     static std::pair<int, int> find_spawn_position(const Maze &maze, int target_row, int target_col);
 
+    // Every empty (row, col) cell in row-major order, built once when the layout is loaded
+    const FixedVector<std::pair<int, int>, MazeConfig::MAZE_CELLS> &get_walkable_cells() const { return walkable_cells_; }
+
     // Load maze from CSV file
     bool load_from_csv(const std::string &filename);
 
 private:
-    std::vector<std::vector<int>> maze_layout_;
-    int level_; ///< Current level number (1-5)
+    std::array<std::array<int, MazeConfig::MAZE_COLS>, MazeConfig::MAZE_ROWS> maze_layout_{};
+    FixedVector<std::pair<int, int>, MazeConfig::MAZE_CELLS> walkable_cells_; ///< Empty cells, rebuilt whenever the layout changes
+    int level_;                                                               ///< Current level number (1-5)
     bool is_valid_position(int row, int col) const;
-
-    /**
-     * @brief Get the wall color for the current level
-     * @return The color to use for drawing walls
-     */
-    color get_level_color() const;
+    void set_layout(const std::vector<std::vector<int>> &rows); // rows must be MAZE_ROWS x MAZE_COLS
 };
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include "menu.h"
 #include "maze.h"
+#include "game_config.h"
 #include "spritesheet.h"
 #include "sound_manager.h"
+#include "text_renderer.h"
+#include "ghost_tuning.h"
+#include <cstdio>
 #include <string>
 #include <fstream>
 #include <algorithm>
@@ -15,10 +19,20 @@
 
 using namespace MazeConfig;
 
-// Helper: approximate center X position for text drawn with draw_text
-static int center_text_x(const std::string &text, int font_size, int window_width)
+namespace
 {
-    return window_width / 2 - static_cast<int>(text.length()) * font_size / 4;
+    // Pac-Man colour palettes offered on the settings screen
+    constexpr PaletteId PACMAN_PALETTES[] = {
+        PaletteId::YELLOW_PINK_SKY, // Default yellow
+        PaletteId::RED_BLUE_WHITE,
+        PaletteId::PINK_BLUE_WHITE,
+        PaletteId::ORANGE_BLUE_WHITE,
+        PaletteId::SKY_BLUE_WHITE,
+        PaletteId::PEACH_BLUE_GREEN,
+        PaletteId::WHITE_ORANGE_RED,
+        PaletteId::WHITE_GREEN_RED,
+        PaletteId::TAN_GREEN_ORANGE};
+    constexpr int PACMAN_PALETTE_COUNT = sizeof(PACMAN_PALETTES) / sizeof(PACMAN_PALETTES[0]);
 }
 
 /**
@@ -33,6 +47,8 @@ Menu::Menu()
       selected_palette_index_(0),
       sprite_sheet_(nullptr),
       sound_manager_(nullptr),
+      text_renderer_(nullptr),
+      ghost_tuning_(nullptr),
       velentina_mode_(false),
       difficulty_level_(DifficultyLevel::MEDIUM),
       selected_difficulty_option_(1), // Default to MEDIUM (index 1)
@@ -40,7 +56,10 @@ Menu::Menu()
       selected_level_(1),
       name_entry_complete_(false),
       pending_score_(0),
-      name_cursor_position_(0)
+      name_cursor_position_(0),
+      scene_dirty_(true),
+      full_redraw_(true),
+      rendered_state_(MenuState::IN_GAME)
 {
     name_letters_[0] = 'A';
     name_letters_[1] = 'A';
@@ -168,6 +187,7 @@ void Menu::handle_main_menu_input()
     if (input_handled)
     {
         last_input_time_ = current_ticks() / 1000.0;
+        scene_dirty_ = true;
     }
 }
 
@@ -233,6 +253,7 @@ void Menu::handle_difficulty_input()
     if (input_handled)
     {
         last_input_time_ = current_ticks() / 1000.0;
+        scene_dirty_ = true;
     }
 }
 
@@ -253,6 +274,7 @@ void Menu::handle_high_scores_input()
         current_state_ = MenuState::MAIN_MENU;
         selected_option_ = static_cast<int>(MainMenuOption::HIGH_SCORES);
         last_input_time_ = current_ticks() / 1000.0;
+        scene_dirty_ = true;
     }
 }
 
@@ -318,38 +340,201 @@ void Menu::handle_level_select_input()
     if (input_handled)
     {
         last_input_time_ = current_ticks() / 1000.0;
+        scene_dirty_ = true;
     }
 }
 
 /**
  * @brief Render the current menu screen
+ * @return true if anything was drawn and presented, false if the screen was unchanged
  */
-void Menu::render()
+bool Menu::render()
 {
+    if (current_state_ == MenuState::IN_GAME)
+    {
+        // Don't render menu while in game
+        return false;
+    }
+
+    // Switching screens always repaints everything
+    if (current_state_ != rendered_state_)
+    {
+        full_redraw_ = true;
+    }
+
+    if (!scene_dirty_ && !full_redraw_)
+    {
+        return false;
+    }
+
+    // Rebuild the retained scene for the current screen
+    next_scene_.clear();
     switch (current_state_)
     {
     case MenuState::MAIN_MENU:
-        render_main_menu();
+        build_main_menu();
         break;
     case MenuState::LEVEL_SELECT:
-        render_level_select_screen();
+        build_level_select_screen();
         break;
     case MenuState::DIFFICULTY:
-        render_difficulty_screen();
+        build_difficulty_screen();
         break;
     case MenuState::HIGH_SCORES:
-        render_high_scores_screen();
+        build_high_scores_screen();
         break;
     case MenuState::SETTINGS:
-        render_settings_screen();
+        build_settings_screen();
         break;
     case MenuState::NAME_ENTRY:
-        render_name_entry_screen();
+        build_name_entry_screen();
         break;
     case MenuState::IN_GAME:
-        // Don't render menu while in game
         break;
     }
+
+    if (full_redraw_)
+    {
+        clear_screen(COLOR_BLACK);
+        for (const MenuItem &item : next_scene_)
+        {
+            draw_item(item);
+        }
+    }
+    else
+    {
+        redraw_changed_items();
+    }
+
+    scene_.swap(next_scene_);
+    rendered_state_ = current_state_;
+    scene_dirty_ = false;
+    full_redraw_ = false;
+
+    refresh_screen(60);
+    return true;
+}
+
+/**
+ * @brief Repaint only the screen regions covered by items that changed
+ */
+void Menu::redraw_changed_items()
+{
+    std::vector<rectangle> dirty_regions;
+    const size_t item_count = std::max(scene_.size(), next_scene_.size());
+
+    for (size_t i = 0; i < item_count; i++)
+    {
+        const MenuItem *old_item = i < scene_.size() ? &scene_[i] : nullptr;
+        const MenuItem *new_item = i < next_scene_.size() ? &next_scene_[i] : nullptr;
+
+        if (old_item && new_item && same_item(*old_item, *new_item))
+            continue;
+
+        if (old_item)
+            dirty_regions.push_back(item_bounds(*old_item));
+        if (new_item)
+            dirty_regions.push_back(item_bounds(*new_item));
+    }
+
+    // Clear each region and redraw everything that overlaps it, clipped to the region
+    for (const rectangle &region : dirty_regions)
+    {
+        push_clip(region);
+        fill_rectangle(COLOR_BLACK, region.x, region.y, region.width, region.height);
+        for (const MenuItem &item : next_scene_)
+        {
+            if (rectangles_intersect(item_bounds(item), region))
+            {
+                draw_item(item);
+            }
+        }
+        pop_clip();
+    }
+}
+
+/**
+ * @brief Draw a single retained item
+ */
+void Menu::draw_item(const MenuItem &item)
+{
+    if (item.palette != PaletteId::NONE)
+    {
+        // Pac-Man preview sprite (open mouth, facing right)
+        sprite_sheet_->draw_sprite_at_pixel(item.palette, 3, 6, item.x, item.y, 3.0, false, false, true);
+        return;
+    }
+
+    text_renderer_->draw_text(item.text, item.clr, item.font_size, item.x, item.y);
+}
+
+/**
+ * @brief Append a text item at a fixed position to the scene being built
+ */
+void Menu::add_text(std::string_view text, const color &clr, int font_size, int x, int y)
+{
+    MenuItem item;
+    item.text.assign(text.data(), text.size());
+    item.clr = clr;
+    item.font_size = font_size;
+    item.x = x;
+    item.y = y;
+    item.palette = PaletteId::NONE;
+    item.bounds = rectangle_from(x, y, text_renderer_->text_width(text, font_size), text_renderer_->line_height(font_size));
+    next_scene_.push_back(std::move(item));
+}
+
+/**
+ * @brief Append a horizontally centred text item to the scene being built
+ */
+void Menu::add_centered_text(std::string_view text, const color &clr, int font_size, int y)
+{
+    const int window_width = MAZE_COLS * CELL_SIZE;
+    add_text(text, clr, font_size, window_width / 2 - text_renderer_->text_width(text, font_size) / 2, y);
+}
+
+/**
+ * @brief Append the Pac-Man preview sprite to the scene being built
+ */
+void Menu::add_sprite(PaletteId palette, int x, int y)
+{
+    if (sprite_sheet_ == nullptr)
+        return;
+
+    MenuItem item;
+    item.clr = COLOR_BLACK;
+    item.font_size = 0;
+    item.x = x;
+    item.y = y;
+    item.palette = palette;
+
+    // The sprite is scaled about the centre of its frame
+    const double scaled_w = sprite_sheet_->frame_width() * 3.0;
+    const double scaled_h = sprite_sheet_->frame_height() * 3.0;
+    item.bounds = rectangle_from(x + sprite_sheet_->frame_width() / 2.0 - scaled_w / 2,
+                                 y + sprite_sheet_->frame_height() / 2.0 - scaled_h / 2,
+                                 scaled_w, scaled_h);
+    next_scene_.push_back(std::move(item));
+}
+
+/**
+ * @brief Screen rectangle covered by an item, padded for glyph overhang
+ */
+rectangle Menu::item_bounds(const MenuItem &item)
+{
+    const double padding = 4;
+    return rectangle_from(item.bounds.x - padding, item.bounds.y - padding,
+                          item.bounds.width + 2 * padding, item.bounds.height + 2 * padding);
+}
+
+/**
+ * @brief Whether two items would draw identically
+ */
+bool Menu::same_item(const MenuItem &a, const MenuItem &b)
+{
+    return a.x == b.x && a.y == b.y && a.font_size == b.font_size && a.palette == b.palette &&
+           a.clr.r == b.clr.r && a.clr.g == b.clr.g && a.clr.b == b.clr.b && a.clr.a == b.clr.a &&
+           a.text == b.text;
 }
 
 /**
@@ -359,17 +544,6 @@ void Menu::handle_settings_input()
 {
     bool input_handled = false;
 
-    // Available Pac-Man color palettes
-    static const char *pacman_palettes[] = {
-        "YELLOW_PINK_SKY", // Default yellow
-        "RED_BLUE_WHITE",
-        "PINK_BLUE_WHITE",
-        "ORANGE_BLUE_WHITE",
-        "SKY_BLUE_WHITE",
-        "PEACH_BLUE_GREEN",
-        "WHITE_GREEN_RED",
-        "TAN_GREEN_ORANGE"};
-    static const int num_palettes = 9;
 
     // Navigate left - previous palette
     if (key_typed(LEFT_KEY))
@@ -377,7 +551,7 @@ void Menu::handle_settings_input()
         selected_palette_index_--;
         if (selected_palette_index_ < 0)
         {
-            selected_palette_index_ = num_palettes - 1;
+            selected_palette_index_ = PACMAN_PALETTE_COUNT - 1;
         }
         // Play navigation sound
         if (sound_manager_)
@@ -390,7 +564,7 @@ void Menu::handle_settings_input()
     else if (key_typed(RIGHT_KEY))
     {
         selected_palette_index_++;
-        if (selected_palette_index_ >= num_palettes)
+        if (selected_palette_index_ >= PACMAN_PALETTE_COUNT)
         {
             selected_palette_index_ = 0;
         }
@@ -429,291 +603,221 @@ void Menu::handle_settings_input()
     if (input_handled)
     {
         last_input_time_ = current_ticks() / 1000.0;
+        scene_dirty_ = true;
     }
 }
 
 /**
- * @brief Render the settings screen
+ * @brief Build the settings screen
  */
-void Menu::render_settings_screen()
+void Menu::build_settings_screen()
 {
-    // Available Pac-Man color palettes (must match handle_settings_input)
-    static const char *pacman_palettes[] = {
-        "YELLOW_PINK_SKY", // Default yellow
-        "RED_BLUE_WHITE",
-        "PINK_BLUE_WHITE",
-        "ORANGE_BLUE_WHITE",
-        "SKY_BLUE_WHITE",
-        "PEACH_BLUE_GREEN",
-        "WHITE_ORANGE_RED",
-        "WHITE_GREEN_RED",
-        "TAN_GREEN_ORANGE"};
-    static const int num_palettes = 9;
-
     const int window_width = MAZE_COLS * CELL_SIZE;
     const int window_height = MAZE_ROWS * CELL_SIZE;
 
-    clear_screen(COLOR_BLACK);
-
     // Title
-    const std::string title = "SETTINGS";
+    const char *title = "SETTINGS";
     const int title_size = 40;
-    draw_text(title, COLOR_YELLOW, "Arial", title_size,
-              center_text_x(title, title_size, window_width),
-              window_height / 5 - 15);
+    add_centered_text(title, COLOR_YELLOW, title_size, window_height / 5 - 15);
 
     // Color selector section
-    const std::string color_label = "PAC-MAN COLOR:";
+    const char *color_label = "PAC-MAN COLOR:";
     const int label_size = 25;
-    draw_text(color_label, COLOR_WHITE, "Arial", label_size,
-              center_text_x(color_label, label_size, window_width),
-              window_height / 2 - 95);
+    add_centered_text(color_label, COLOR_WHITE, label_size, window_height / 2 - 95);
 
     // Draw Pac-Man sprite preview if sprite sheet is available
     if (sprite_sheet_ != nullptr)
     {
-        const char *current_palette = pacman_palettes[selected_palette_index_];
+        const PaletteId current_palette = PACMAN_PALETTES[selected_palette_index_];
 
-        // Draw Pac-Man sprite (open mouth, facing right)
-        sprite_sheet_->draw_sprite_at_pixel(current_palette, 3, 6,
-                                            window_width / 2,
-                                            window_height / 2 - 15,
-                                            3.0, false, false, true);
+        // Pac-Man sprite (open mouth, facing right)
+        add_sprite(current_palette, window_width / 2, window_height / 2 - 15);
 
         // Draw left arrow
-        draw_text("<", COLOR_YELLOW, "Arial", 40,
-                  center_text_x(std::string("<"), 40, window_width) - 80,
-                  window_height / 2 - 35);
+        const int arrow_size = 40;
+        const int arrow_half_width = text_renderer_->text_width("<", arrow_size) / 2;
+        add_text("<", COLOR_YELLOW, arrow_size,
+                 window_width / 2 - arrow_half_width - 80,
+                 window_height / 2 - 35);
 
         // Draw right arrow
-        draw_text(">", COLOR_YELLOW, "Arial", 40,
-                  center_text_x(std::string(">"), 40, window_width) + 60,
-                  window_height / 2 - 35);
+        add_text(">", COLOR_YELLOW, arrow_size,
+                 window_width / 2 - arrow_half_width + 60,
+                 window_height / 2 - 35);
     }
 
     // Velentina Mode toggle section
-    const std::string velentina_label = "VELENTINA MODE:";
+    const char *velentina_label = "VELENTINA MODE:";
     const int velentina_label_size = 25;
-    draw_text(velentina_label, COLOR_WHITE, "Arial", velentina_label_size,
-              center_text_x(velentina_label, velentina_label_size, window_width),
-              window_height / 2 + 85);
+    add_centered_text(velentina_label, COLOR_WHITE, velentina_label_size, window_height / 2 + 85);
 
     // Display toggle state
-    std::string toggle_state = velentina_mode_ ? "ON" : "OFF";
+    const char *toggle_state = velentina_mode_ ? "ON" : "OFF";
     color toggle_color = velentina_mode_ ? COLOR_GREEN : COLOR_RED;
     const int toggle_size = 30;
-    draw_text(toggle_state, toggle_color, "Arial", toggle_size,
-              center_text_x(toggle_state, toggle_size, window_width),
-              window_height / 2 + 125);
+    add_centered_text(toggle_state, toggle_color, toggle_size, window_height / 2 + 125);
 
     // Navigation instructions
-    const std::string nav_text = "LEFT/RIGHT: Change color  |  UP/DOWN: Toggle Velentina Mode";
+    const char *nav_text = "LEFT/RIGHT: Change color  |  UP/DOWN: Toggle Velentina Mode";
     const int nav_size = 14;
-    draw_text(nav_text, COLOR_GRAY, "Arial", nav_size,
-              center_text_x(nav_text, nav_size, window_width),
-              window_height - 115);
+    add_centered_text(nav_text, COLOR_GRAY, nav_size, window_height - 115);
 
     // Back instruction
-    const std::string back_text = "Press RED or YELLOW to go back";
+    const char *back_text = "Press RED or YELLOW to go back";
     const int back_size = 16;
-    draw_text(back_text, COLOR_GRAY, "Arial", back_size,
-              center_text_x(back_text, back_size, window_width),
-              window_height - 85);
-
-    refresh_screen(60);
+    add_centered_text(back_text, COLOR_GRAY, back_size, window_height - 85);
 }
 
 /**
- * @brief Render the main menu
+ * @brief Build the main menu
  */
-void Menu::render_main_menu()
+void Menu::build_main_menu()
 {
-    const int window_width = MAZE_COLS * CELL_SIZE;
     const int window_height = MAZE_ROWS * CELL_SIZE;
 
-    // Clear screen with black background
-    clear_screen(COLOR_BLACK);
-
     // Title
-    const std::string title = "PAC-MAN";
+    const char *title = "PAC-MAN";
     const int title_size = 60;
     const int title_y = window_height / 4 - 15;
-    draw_text(title, COLOR_YELLOW, "Arial", title_size,
-              center_text_x(title, title_size, window_width), title_y);
+    add_centered_text(title, COLOR_YELLOW, title_size, title_y);
 
     // Menu options
     const int option_size = 30;
     const int option_start_y = window_height / 2 - 35; // Shifted up by 10 pixels
     const int option_spacing = 50;
 
-    const char *options[] = {"PLAY ENDLESS", "PLAY LEVEL SELECT", "CHANGE DIFFICULTY", "VIEW HIGH SCORES", "SETTINGS", "QUIT"};
+    // Labels are stored with their selection prefix so no strings are built per frame
+    const char *options[] = {"  PLAY ENDLESS", "  PLAY LEVEL SELECT", "  CHANGE DIFFICULTY", "  VIEW HIGH SCORES", "  SETTINGS", "  QUIT"};
+    const char *selected_options[] = {"> PLAY ENDLESS", "> PLAY LEVEL SELECT", "> CHANGE DIFFICULTY", "> VIEW HIGH SCORES", "> SETTINGS", "> QUIT"};
 
     for (int i = 0; i < static_cast<int>(MainMenuOption::COUNT); i++)
     {
         color option_color = (i == selected_option_) ? COLOR_YELLOW : COLOR_WHITE;
-        std::string prefix = (i == selected_option_) ? "> " : "  ";
-        std::string option_text = prefix + options[i];
+        const char *option_text = (i == selected_option_) ? selected_options[i] : options[i];
 
         int y_pos = option_start_y + i * option_spacing;
-        draw_text(option_text, option_color, "Arial", option_size,
-                  center_text_x(option_text, option_size, window_width), y_pos);
+        add_centered_text(option_text, option_color, option_size, y_pos);
     }
 
     // Instructions
-    const std::string instructions = "Use JOYSTICK to navigate, YELLOW to select";
+    const char *instructions = "Use JOYSTICK to navigate, YELLOW to select";
     const int instr_size = 15;
-    draw_text(instructions, COLOR_GRAY, "Arial", instr_size,
-              center_text_x(instructions, instr_size, window_width),
-              window_height - 20);
-
-    refresh_screen(60);
+    add_centered_text(instructions, COLOR_GRAY, instr_size, window_height - 20);
 }
 
 /**
- * @brief Render the difficulty selection screen
+ * @brief Build the difficulty selection screen
  */
-void Menu::render_difficulty_screen()
+void Menu::build_difficulty_screen()
 {
-    const int window_width = MAZE_COLS * CELL_SIZE;
     const int window_height = MAZE_ROWS * CELL_SIZE;
 
-    clear_screen(COLOR_BLACK);
-
     // Title
-    const std::string title = "SELECT DIFFICULTY";
+    const char *title = "SELECT DIFFICULTY";
     const int title_size = 40;
-    draw_text(title, COLOR_YELLOW, "Arial", title_size,
-              center_text_x(title, title_size, window_width),
-              window_height / 5 - 15);
+    add_centered_text(title, COLOR_YELLOW, title_size, window_height / 5 - 15);
 
     // Difficulty options
     const int option_size = 30;
     const int option_start_y = window_height / 2 - 75;
     const int option_spacing = 50;
 
-    const char *difficulty_names[] = {"EASY", "MEDIUM", "HARD", "CRAZY"};
+    const char *difficulty_names[] = {"  EASY", "  MEDIUM", "  HARD", "  CRAZY"};
+    const char *selected_difficulty_names[] = {"> EASY", "> MEDIUM", "> HARD", "> CRAZY"};
     const char *difficulty_speeds[] = {"(75% Speed)", "(100% Speed)", "(125% Speed)", "(200% Speed)"};
+    const char *current_difficulty_text[] = {"Current: EASY", "Current: MEDIUM", "Current: HARD", "Current: CRAZY"};
 
     for (int i = 0; i < static_cast<int>(DifficultyLevel::COUNT); i++)
     {
         color option_color = (i == selected_difficulty_option_) ? COLOR_YELLOW : COLOR_WHITE;
-        std::string prefix = (i == selected_difficulty_option_) ? "> " : "  ";
-        std::string option_text = prefix + difficulty_names[i];
+        const char *option_text = (i == selected_difficulty_option_) ? selected_difficulty_names[i] : difficulty_names[i];
 
         int y_pos = option_start_y + i * option_spacing;
-        draw_text(option_text, option_color, "Arial", option_size,
-                  center_text_x(option_text, option_size, window_width), y_pos);
+        add_centered_text(option_text, option_color, option_size, y_pos);
 
         // Draw speed description
         const int speed_size = 18;
-        std::string speed_text = difficulty_speeds[i];
+        const char *speed_text = difficulty_speeds[i];
         color speed_color = (i == selected_difficulty_option_) ? COLOR_YELLOW : COLOR_GRAY;
-        draw_text(speed_text, speed_color, "Arial", speed_size,
-                  center_text_x(speed_text, speed_size, window_width), y_pos + 28);
+        add_centered_text(speed_text, speed_color, speed_size, y_pos + 28);
     }
 
     // Current difficulty indicator
-    const std::string current_text = "Current: " + std::string(difficulty_names[static_cast<int>(difficulty_level_)]);
+    const char *current_text = current_difficulty_text[static_cast<int>(difficulty_level_)];
     const int current_size = 20;
-    draw_text(current_text, COLOR_GREEN, "Arial", current_size,
-              center_text_x(current_text, current_size, window_width),
-              window_height - 135);
+    add_centered_text(current_text, COLOR_GREEN, current_size, window_height - 135);
 
     // Instructions
-    const std::string nav_text = "Use UP/DOWN arrows to select, YELLOW to confirm";
+    const char *nav_text = "Use UP/DOWN arrows to select, YELLOW to confirm";
     const int nav_size = 16;
-    draw_text(nav_text, COLOR_GRAY, "Arial", nav_size,
-              center_text_x(nav_text, nav_size, window_width),
-              window_height - 95);
+    add_centered_text(nav_text, COLOR_GRAY, nav_size, window_height - 95);
 
     // Back instruction
-    const std::string back_text = "Press RED to go back without changing";
+    const char *back_text = "Press RED to go back without changing";
     const int back_size = 16;
-    draw_text(back_text, COLOR_GRAY, "Arial", back_size,
-              center_text_x(back_text, back_size, window_width),
-              window_height - 65);
-
-    refresh_screen(60);
+    add_centered_text(back_text, COLOR_GRAY, back_size, window_height - 65);
 }
 
 /**
- * @brief Render the level selection screen
+ * @brief Build the level selection screen
  */
-void Menu::render_level_select_screen()
+void Menu::build_level_select_screen()
 {
-    const int window_width = MAZE_COLS * CELL_SIZE;
     const int window_height = MAZE_ROWS * CELL_SIZE;
 
-    clear_screen(COLOR_BLACK);
-
     // Title
-    const std::string title = "SELECT LEVEL";
+    const char *title = "SELECT LEVEL";
     const int title_size = 40;
-    draw_text(title, COLOR_YELLOW, "Arial", title_size,
-              center_text_x(title, title_size, window_width),
-              window_height / 5 - 15);
+    add_centered_text(title, COLOR_YELLOW, title_size, window_height / 5 - 15);
 
     // Level options with colors
     const int option_size = 30;
     const int option_start_y = window_height / 2 - 95;
     const int option_spacing = 50;
 
-    const char *level_names[] = {"LEVEL 1", "LEVEL 2", "LEVEL 3", "LEVEL 4", "LEVEL 5"};
+    const char *level_names[] = {"  LEVEL 1", "  LEVEL 2", "  LEVEL 3", "  LEVEL 4", "  LEVEL 5"};
+    const char *selected_level_names[] = {"> LEVEL 1", "> LEVEL 2", "> LEVEL 3", "> LEVEL 4", "> LEVEL 5"};
     const color level_colors[] = {COLOR_BLUE, COLOR_GREEN, COLOR_PURPLE, COLOR_RED, COLOR_YELLOW};
 
     for (int i = 0; i < 5; i++)
     {
         color option_color = (i == selected_option_) ? level_colors[i] : COLOR_WHITE;
-        std::string prefix = (i == selected_option_) ? "> " : "  ";
-        std::string option_text = prefix + level_names[i];
+        const char *option_text = (i == selected_option_) ? selected_level_names[i] : level_names[i];
 
         int y_pos = option_start_y + i * option_spacing;
-        draw_text(option_text, option_color, "Arial", option_size,
-                  center_text_x(option_text, option_size, window_width), y_pos);
+        add_centered_text(option_text, option_color, option_size, y_pos);
     }
 
     // Instructions
-    const std::string nav_text = "Use UP/DOWN arrows to select, YELLOW to confirm";
+    const char *nav_text = "Use UP/DOWN arrows to select, YELLOW to confirm";
     const int nav_size = 16;
-    draw_text(nav_text, COLOR_GRAY, "Arial", nav_size,
-              center_text_x(nav_text, nav_size, window_width),
-              window_height - 95);
+    add_centered_text(nav_text, COLOR_GRAY, nav_size, window_height - 95);
 
     // Back instruction
-    const std::string back_text = "Press RED to go back";
+    const char *back_text = "Press RED to go back";
     const int back_size = 16;
-    draw_text(back_text, COLOR_GRAY, "Arial", back_size,
-              center_text_x(back_text, back_size, window_width),
-              window_height - 65);
-
-    refresh_screen(60);
+    add_centered_text(back_text, COLOR_GRAY, back_size, window_height - 65);
 }
 
 /**
- * @brief Render the high scores screen
+ * @brief Build the high scores screen
  */
-void Menu::render_high_scores_screen()
+void Menu::build_high_scores_screen()
 {
     const int window_width = MAZE_COLS * CELL_SIZE;
     const int window_height = MAZE_ROWS * CELL_SIZE;
 
-    clear_screen(COLOR_BLACK);
-
     // Title
-    const std::string title = "HIGH SCORES";
+    const char *title = "HIGH SCORES";
     const int title_size = 40;
-    draw_text(title, COLOR_YELLOW, "Arial", title_size,
-              center_text_x(title, title_size, window_width),
-              80);
+    add_centered_text(title, COLOR_YELLOW, title_size, 80);
 
     // Display top 10 scores
     if (high_scores_.empty())
     {
-        const std::string message = "No scores yet!";
+        const char *message = "No scores yet!";
         const int msg_size = 25;
-        draw_text(message, COLOR_WHITE, "Arial", msg_size,
-                  center_text_x(message, msg_size, window_width),
-                  window_height / 2 - 15);
+        add_centered_text(message, COLOR_WHITE, msg_size, window_height / 2 - 15);
     }
     else
     {
@@ -724,85 +828,58 @@ void Menu::render_high_scores_screen()
         const int score_x = window_width / 2 + 50;
 
         // Header
-        draw_text("RANK", COLOR_YELLOW, "Arial", entry_size,
-                  name_x - 80, start_y);
-        draw_text("NAME", COLOR_YELLOW, "Arial", entry_size,
-                  name_x, start_y);
-        draw_text("SCORE", COLOR_YELLOW, "Arial", entry_size,
-                  score_x, start_y);
+        add_text("RANK", COLOR_YELLOW, entry_size, name_x - 80, start_y);
+        add_text("NAME", COLOR_YELLOW, entry_size, name_x, start_y);
+        add_text("SCORE", COLOR_YELLOW, entry_size, score_x, start_y);
 
         // Entries
+        const char *ranks[] = {"1.", "2.", "3.", "4.", "5.", "6.", "7.", "8.", "9.", "10."};
+        char score_buffer[16];
+
         for (size_t i = 0; i < high_scores_.size() && i < 10; i++)
         {
             int y_pos = start_y + (i + 1) * entry_spacing;
             color entry_color = (i < 3) ? COLOR_YELLOW : COLOR_WHITE;
 
             // Rank
-            std::string rank = std::to_string(i + 1) + ".";
-            draw_text(rank, entry_color, "Arial", entry_size,
-                      name_x - 80, y_pos);
+            add_text(ranks[i], entry_color, entry_size, name_x - 80, y_pos);
 
             // Name
-            draw_text(high_scores_[i].name, entry_color, "Arial", entry_size,
-                      name_x, y_pos);
+            add_text(high_scores_[i].name, entry_color, entry_size, name_x, y_pos);
 
             // Score
-            std::string score_str = std::to_string(high_scores_[i].score);
-            draw_text(score_str, entry_color, "Arial", entry_size,
-                      score_x, y_pos);
+            int score_length = snprintf(score_buffer, sizeof(score_buffer), "%d", high_scores_[i].score);
+            add_text(std::string_view(score_buffer, score_length), entry_color, entry_size, score_x, y_pos);
         }
     }
 
     // Back instruction
-    const std::string back_text = "Press RED or YELLOW to go back";
+    const char *back_text = "Press RED or YELLOW to go back";
     const int back_size = 16;
-    draw_text(back_text, COLOR_GRAY, "Arial", back_size,
-              center_text_x(back_text, back_size, window_width),
-              window_height - 20);
-
-    refresh_screen(60);
+    add_centered_text(back_text, COLOR_GRAY, back_size, window_height - 20);
 }
 
 /**
- * @brief Get the selected Pac-Man palette name
- * @return The currently selected palette name
+ * @brief Get the selected Pac-Man palette
+ * @return The currently selected palette
  */
-const char *Menu::get_selected_pacman_palette() const
+PaletteId Menu::get_selected_pacman_palette() const
 {
-    // Available Pac-Man color palettes (must match render/input)
-    static const char *pacman_palettes[] = {
-        "YELLOW_PINK_SKY",
-        "RED_BLUE_WHITE",
-        "PINK_BLUE_WHITE",
-        "ORANGE_BLUE_WHITE",
-        "SKY_BLUE_WHITE",
-        "PEACH_BLUE_GREEN",
-        "WHITE_ORANGE_RED",
-        "WHITE_GREEN_RED",
-        "TAN_GREEN_ORANGE"};
-
-    return pacman_palettes[selected_palette_index_];
+    return PACMAN_PALETTES[selected_palette_index_];
 }
 
 /**
  * @brief Get the speed multiplier for the current difficulty
- * @return Speed multiplier (0.75, 1.0, 1.25, or 2.0)
+ * @return The ghost tuning's speed multiplier for the difficulty (by default 0.75, 1.0, 1.25, or 2.0)
  */
 double Menu::get_difficulty_speed_multiplier() const
 {
-    switch (difficulty_level_)
-    {
-    case DifficultyLevel::EASY:
-        return 0.75;
-    case DifficultyLevel::MEDIUM:
-        return 1.0;
-    case DifficultyLevel::HARD:
-        return 1.25;
-    case DifficultyLevel::CRAZY:
-        return 2.0;
-    default:
+    const int index = static_cast<int>(difficulty_level_);
+    if (index < 0 || index >= GameConfig::DIFFICULTY_COUNT)
         return 1.0;
-    }
+    if (ghost_tuning_ == nullptr)
+        return GameConfig::DIFFICULTY_SPEED_MULTIPLIERS[index];
+    return ghost_tuning_->speed_multipliers[index];
 }
 
 /**
@@ -899,6 +976,7 @@ void Menu::start_name_entry(int score)
     name_entry_complete_ = false;
     current_state_ = MenuState::NAME_ENTRY;
     selected_option_ = 0;
+    full_redraw_ = true;
 }
 
 /**
@@ -991,39 +1069,33 @@ void Menu::handle_name_entry_input()
     if (input_handled)
     {
         last_input_time_ = current_ticks() / 1000.0;
+        scene_dirty_ = true;
     }
 }
 
 /**
- * @brief Render the name entry screen
+ * @brief Build the name entry screen
  */
-void Menu::render_name_entry_screen()
+void Menu::build_name_entry_screen()
 {
     const int window_width = MAZE_COLS * CELL_SIZE;
     const int window_height = MAZE_ROWS * CELL_SIZE;
 
-    clear_screen(COLOR_BLACK);
-
     // Title
-    const std::string title = "NEW HIGH SCORE!";
+    const char *title = "NEW HIGH SCORE!";
     const int title_size = 40;
-    draw_text(title, COLOR_YELLOW, "Arial", title_size,
-              center_text_x(title, title_size, window_width),
-              window_height / 5 - 15);
+    add_centered_text(title, COLOR_YELLOW, title_size, window_height / 5 - 15);
 
     // Score display
-    const std::string score_text = "SCORE: " + std::to_string(pending_score_);
+    char score_text[32];
+    snprintf(score_text, sizeof(score_text), "SCORE: %d", pending_score_);
     const int score_size = 30;
-    draw_text(score_text, COLOR_WHITE, "Arial", score_size,
-              center_text_x(score_text, score_size, window_width),
-              window_height / 3);
+    add_centered_text(score_text, COLOR_WHITE, score_size, window_height / 3);
 
     // Instruction
-    const std::string instruction = "ENTER YOUR NAME:";
+    const char *instruction = "ENTER YOUR NAME:";
     const int instr_size = 25;
-    draw_text(instruction, COLOR_WHITE, "Arial", instr_size,
-              center_text_x(instruction, instr_size, window_width),
-              window_height / 2 - 60);
+    add_centered_text(instruction, COLOR_WHITE, instr_size, window_height / 2 - 60);
 
     // Draw the three letters with cursor
     const int letter_size = 60;
@@ -1033,35 +1105,27 @@ void Menu::render_name_entry_screen()
 
     for (int i = 0; i < 3; i++)
     {
-        std::string letter(1, name_letters_[i]);
+        std::string_view letter(&name_letters_[i], 1);
         color letter_color = (i == name_cursor_position_) ? COLOR_YELLOW : COLOR_WHITE;
 
         int x_pos = start_x + i * letter_spacing;
-        draw_text(letter, letter_color, "Arial", letter_size,
-                  x_pos, letter_y);
+        add_text(letter, letter_color, letter_size, x_pos, letter_y);
 
         // Draw cursor indicator under current letter
         if (i == name_cursor_position_)
         {
-            const std::string cursor = "^";
-            draw_text(cursor, COLOR_YELLOW, "Arial", 40,
-                      x_pos + 10, letter_y + 60);
+            const char *cursor = "^";
+            add_text(cursor, COLOR_YELLOW, 40, x_pos + 10, letter_y + 60);
         }
     }
 
     // Instructions
-    const std::string nav_text = "UP/DOWN: Change letter  |  LEFT/RIGHT: Move cursor";
+    const char *nav_text = "UP/DOWN: Change letter  |  LEFT/RIGHT: Move cursor";
     const int nav_size = 14;
-    draw_text(nav_text, COLOR_GRAY, "Arial", nav_size,
-              center_text_x(nav_text, nav_size, window_width),
-              window_height - 50);
+    add_centered_text(nav_text, COLOR_GRAY, nav_size, window_height - 50);
 
     // Confirm instruction
-    const std::string confirm_text = "Press RED or YELLOW to confirm";
+    const char *confirm_text = "Press RED or YELLOW to confirm";
     const int confirm_size = 16;
-    draw_text(confirm_text, COLOR_GRAY, "Arial", confirm_size,
-              center_text_x(confirm_text, confirm_size, window_width),
-              window_height - 20);
-
-    refresh_screen(60);
+    add_centered_text(confirm_text, COLOR_GRAY, confirm_size, window_height - 20);
 }
@@ -1,12 +1,17 @@
 #pragma once
 
 #include "splashkit.h"
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
 
 // Forward declaration
 class SpriteSheet;
+enum class PaletteId : std::uint8_t;
 class SoundManager;
+class TextRenderer;
+struct GhostTuning;
 
 /**
  * @file menu.h
@@ -54,7 +59,7 @@ enum class DifficultyLevel
     MEDIUM = 1, ///< 100% speed (default)
     HARD = 2,   ///< 125% speed
     CRAZY = 3,  ///< 200% speed
-    COUNT = 4   ///< Total number of difficulty levels
+    COUNT = 4   ///< Total number of difficulty levels (GameConfig::DIFFICULTY_COUNT)
 };
 
 /**
@@ -66,12 +71,28 @@ struct HighScoreEntry
     int score;        ///< Score achieved
 };
 
+/**
+ * A single retained menu element: a line of text or the Pac-Man preview sprite
+ * Menu screens are rebuilt as a list of items and compared against the list
+ * that is currently on screen, so only items that changed are repainted.
+ */
+struct MenuItem
+{
+    std::string text;    ///< Text to draw (empty for sprites)
+    color clr;           ///< Text colour
+    int font_size;       ///< Font size (0 for sprites)
+    int x;               ///< Draw position x (pixels)
+    int y;               ///< Draw position y (pixels)
+    PaletteId palette;   ///< Sprite palette, or PaletteId::NONE for text
+    rectangle bounds;    ///< Screen area covered by the item
+};
+
 /**
  * @class Menu
  * @brief Manages menu navigation and rendering
  *
  * The Menu class handles:
- * - Rendering menu screens
+ * - Rendering menu screens, repainting only the items that changed
  * - Processing keyboard input for navigation
  * - Tracking selected menu option
  * - State transitions between menu screens
@@ -80,9 +101,9 @@ class Menu
 {
 public:
     /**
-     * @brief Render the settings screen
+     * @brief Build the settings screen
      */
-    void render_settings_screen();
+    void build_settings_screen();
     /**
      * @brief Handle input for the settings screen
      */
@@ -90,7 +111,11 @@ public:
     /**
      * @brief Set the current menu state
      */
-    void set_state(MenuState state) { current_state_ = state; }
+    void set_state(MenuState state)
+    {
+        current_state_ = state;
+        full_redraw_ = true;
+    }
     /**
      * @brief Constructor - initializes menu with default state
      */
@@ -108,6 +133,18 @@ public:
      */
     void set_sound_manager(SoundManager *sound_manager) { sound_manager_ = sound_manager; }
 
+    /**
+     * @brief Set the text renderer used to draw menu text
+     * @param text_renderer Pointer to the text renderer
+     */
+    void set_text_renderer(TextRenderer *text_renderer) { text_renderer_ = text_renderer; }
+
+    /**
+     * @brief Set the ghost tuning whose speed_multipliers the difficulties use
+     * @param ghost_tuning Pointer to the tuning (nullptr for GameConfig::DIFFICULTY_SPEED_MULTIPLIERS)
+     */
+    void set_ghost_tuning(const GhostTuning *ghost_tuning) { ghost_tuning_ = ghost_tuning; }
+
     /**
      * @brief Process keyboard input for menu navigation
      * Arrow keys to navigate, spacebar to select
@@ -116,8 +153,11 @@ public:
 
     /**
      * @brief Render the current menu screen
+     * Nothing is drawn or presented when the screen has not changed since the
+     * previous call.
+     * @return true if the screen was redrawn, false if it was left untouched
      */
-    void render();
+    bool render();
 
     /**
      * @brief Get the current menu state
@@ -143,10 +183,10 @@ public:
     bool should_quit_game() const { return should_quit_; }
 
     /**
-     * @brief Get the selected Pac-Man palette name
-     * @return The currently selected palette name
+     * @brief Get the selected Pac-Man palette
+     * @return The currently selected palette
      */
-    const char *get_selected_pacman_palette() const;
+    PaletteId get_selected_pacman_palette() const;
 
     /**
      * @brief Check if Velentina Mode is enabled
@@ -162,7 +202,7 @@ public:
 
     /**
      * @brief Get the speed multiplier for the current difficulty
-     * @return Speed multiplier (0.75, 1.0, 1.25, or 2.0)
+     * @return The ghost tuning's speed multiplier for the difficulty (by default 0.75, 1.0, 1.25, or 2.0)
      */
     double get_difficulty_speed_multiplier() const;
 
@@ -203,6 +243,8 @@ private:
     int selected_palette_index_;       ///< Index of the selected Pac-Man color palette
     SpriteSheet *sprite_sheet_;        ///< Pointer to sprite sheet for rendering preview
     SoundManager *sound_manager_;      ///< Pointer to sound manager for menu sounds
+    TextRenderer *text_renderer_;      ///< Pointer to text renderer for menu text
+    const GhostTuning *ghost_tuning_;  ///< Pointer to the tuning the difficulty speeds come from
     bool velentina_mode_;              ///< Velentina Mode toggle flag
     DifficultyLevel difficulty_level_; ///< Current difficulty level
     int selected_difficulty_option_;   ///< Currently selected difficulty option in menu
@@ -220,20 +262,62 @@ private:
     double last_input_time_;                       ///< Time of last input
     static constexpr double INPUT_COOLDOWN = 0.15; ///< Seconds between inputs
 
+    // Retained scene
+    std::vector<MenuItem> scene_;      ///< Items currently on screen
+    std::vector<MenuItem> next_scene_; ///< Items being built for this frame
+    bool scene_dirty_;                 ///< Input changed something on the current screen
+    bool full_redraw_;                 ///< Whole screen must be cleared and redrawn
+    MenuState rendered_state_;         ///< Screen that scene_ was built for
+
+    /**
+     * @brief Append a text item to the scene being built
+     */
+    void add_text(std::string_view text, const color &clr, int font_size, int x, int y);
+
+    /**
+     * @brief Append a horizontally centred text item to the scene being built
+     */
+    void add_centered_text(std::string_view text, const color &clr, int font_size, int y);
+
+    /**
+     * @brief Append the Pac-Man preview sprite to the scene being built
+     */
+    void add_sprite(PaletteId palette, int x, int y);
+
+    /**
+     * @brief Draw a single retained item
+     */
+    void draw_item(const MenuItem &item);
+
+    /**
+     * @brief Repaint only the screen regions covered by items that changed
+     */
+    void redraw_changed_items();
+
+    /**
+     * @brief Screen rectangle covered by an item, padded for glyph overhang
+     */
+    static rectangle item_bounds(const MenuItem &item);
+
+    /**
+     * @brief Whether two items would draw identically
+     */
+    static bool same_item(const MenuItem &a, const MenuItem &b);
+
     /**
-     * @brief Render the main menu
+     * @brief Build the main menu
      */
-    void render_main_menu();
+    void build_main_menu();
 
     /**
-     * @brief Render the difficulty selection screen
+     * @brief Build the difficulty selection screen
      */
-    void render_difficulty_screen();
+    void build_difficulty_screen();
 
     /**
-     * @brief Render the high scores screen
+     * @brief Build the high scores screen
      */
-    void render_high_scores_screen();
+    void build_high_scores_screen();
 
     /**
      * @brief Handle input for the main menu
@@ -251,9 +335,9 @@ private:
     void handle_high_scores_input();
 
     /**
-     * @brief Render the level selection screen
+     * @brief Build the level selection screen
      */
-    void render_level_select_screen();
+    void build_level_select_screen();
 
     /**
      * @brief Handle input for the level selection screen
@@ -261,9 +345,9 @@ private:
     void handle_level_select_input();
 
     /**
-     * @brief Render the name entry screen
+     * @brief Build the name entry screen
      */
-    void render_name_entry_screen();
+    void build_name_entry_screen();
 
     /**
      * @brief Handle input for the name entry screen
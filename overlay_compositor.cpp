@@ -0,0 +1,33 @@
+#include "overlay_compositor.h"
+
+OverlayCompositor::OverlayCompositor(int width, int height)
+    : width_(width), height_(height), frame_cache_(nullptr), cached_(false)
+{
+}
+
+OverlayCompositor::~OverlayCompositor()
+{
+    if (frame_cache_)
+        free_bitmap(frame_cache_);
+}
+
+void OverlayCompositor::capture(const std::function<void(const drawing_options &)> &draw_frame)
+{
+    if (frame_cache_ == nullptr)
+    {
+        frame_cache_ = create_bitmap(width_, height_);
+    }
+
+    // The frame's drawing calls target the cache instead of the window
+    cached_ = frame_cache_ != nullptr;
+    draw_frame(cached_ ? option_to_bitmap(frame_cache_) : option_defaults());
+}
+
+bool OverlayCompositor::present() const
+{
+    if (!cached_)
+        return false;
+
+    draw_bitmap(frame_cache_, 0, 0);
+    return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "splashkit.h"
+#include <functional>
+
+/**
+ * @file overlay_compositor.h
+ * @brief Cached full-window frames for screens that hold still
+ *
+ * This file contains the OverlayCompositor class, which bakes an
+ * expensive frame (the scene plus its overlays) into a bitmap once so it
+ * can be shown again with a single blit.
+ */
+
+/**
+ * @class OverlayCompositor
+ * @brief Captures a drawn frame into a window-sized bitmap and replays it
+ *
+ * Used where the scene stops changing but the window still has to be
+ * presented: the pause screen (scene, dimming and pause text baked into
+ * one frame) and the dying animation (scene without Pac-Man, with only the
+ * dying sprite drawn over it each frame).
+ *
+ * The frame is drawn into the cache through SplashKit's bitmap
+ * destination option (option_to_bitmap), so it is cached with every
+ * backend, not only those with render targets.
+ */
+class OverlayCompositor
+{
+public:
+    /**
+     * @brief Constructor - the cache bitmap is created on first capture
+     * @param width Window width (pixels)
+     * @param height Window height (pixels)
+     */
+    OverlayCompositor(int width, int height);
+
+    /**
+     * @brief Destructor - frees the cache bitmap
+     */
+    ~OverlayCompositor();
+
+    OverlayCompositor(const OverlayCompositor &) = delete;
+    OverlayCompositor &operator=(const OverlayCompositor &) = delete;
+
+    /**
+     * @brief Draw a frame into the cache, replacing any previous capture
+     * @param draw_frame Draws the whole frame (clearing included) with the options it is given
+     */
+    void capture(const std::function<void(const drawing_options &)> &draw_frame);
+
+    /**
+     * @brief Blit the cached frame to the screen
+     * @return false if nothing is cached (nothing captured, or the cache could not be created)
+     */
+    bool present() const;
+
+    /**
+     * @brief Forget the cached frame
+     */
+    void invalidate() { cached_ = false; }
+
+private:
+    int width_;
+    int height_;
+    bitmap frame_cache_; ///< Window-sized capture (nullptr until first capture)
+    bool cached_;        ///< Whether frame_cache_ holds a current frame
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// Palette cells on the sprite sheet, in PALETTE_CELL_MAP order. Palettes are
+// passed around as ids, so drawing a sprite never builds or compares a string.
+enum class PaletteId : std::uint8_t
+{
+    RED_BLUE_WHITE,
+    RED_WHITE_GREEN,
+    RED_PEACH_WHITE,
+    WHITE_GREEN_TEAL,
+    PINK_BLUE_WHTE,
+    BLACK_BLUE_WHITE,
+    PINK_BLUE_WHITE,
+    YELLOW_RED_BLUE,
+    SKY_BLUE_WHITE,
+    YELLOW_PINK_SKY,
+    WHITE_ORANGE_RED,
+    WHITE_BLUE_YELLOW,
+    ORANGE_BLUE_WHITE,
+    BLUE_BLACK_PEACH,
+    WHITE_GREEN_RED,
+    PEACH_BLACK_WHITE,
+    PEACH_BLUE_GREEN,
+    WHITE_BLACK_PEACH,
+    TAN_GREEN_ORANGE,
+    COUNT,       // Number of palettes
+    NONE = COUNT // No palette
+};
+
+constexpr PaletteId PACMAN_PALETTE = PaletteId::YELLOW_PINK_SKY;
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "game_mode.h"
+#include "palette.h"
+#include "sprite_frames.h"
+#include "input_queue.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file render_snapshot.h
+ * @brief Immutable description of one simulated frame, as handed to the renderer
+ *
+ * The simulation thread fills a RenderSnapshot after every tick and
+ * publishes it through a TripleBuffer. The render thread draws only from
+ * snapshots, so it never reads the World or GameState while they change.
+ */
+
+/**
+ * A sprite to draw, with its sheet cell already resolved
+ */
+struct RenderSprite
+{
+    double x = 0.0;
+    double y = 0.0;
+    PaletteId palette = PaletteId::NONE;
+    SpriteFrame frame;   ///< Sheet cell and flips
+    bool scaled = false; ///< Drawn at SPRITE_SCALE and trimmed rather than 1:1
+};
+
+/**
+ * A score popup to draw over the sprites
+ */
+struct RenderPopup
+{
+    double x = 0.0;
+    double y = 0.0;
+    int sprite_col = 0;
+    int sprite_row = 0;
+};
+
+/**
+ * Running totals of the events that play a sound, counted by the simulation thread
+ *
+ * The main thread plays the difference from the totals it last heard, so a
+ * snapshot that is skipped never loses its sounds.
+ */
+struct AudioCues
+{
+    std::uint32_t tokens_collected = 0;
+    std::uint32_t fruits_collected = 0;
+    std::uint32_t ghosts_caught = 0;
+    std::uint32_t pacman_caught = 0;
+    std::uint32_t levels_cleared = 0;
+};
+
+/**
+ * Everything the renderer needs to draw one frame
+ */
+struct RenderSnapshot
+{
+    std::uint64_t sequence = 0; ///< Increases with every publish
+    std::uint32_t scene = 0;    ///< Changes whenever the level is reset (new maze and pellets)
+
+    std::vector<RenderSprite> sprites; ///< Visible sprites in draw order
+    std::vector<RenderPopup> popups;   ///< Visible score popups
+
+    // Pellets collected since the last snapshot the renderer presented (indices into GameState)
+    std::vector<int> collected_tokens;
+    std::vector<int> collected_power_pellets;
+
+    // HUD values
+    int score = 0;
+    int tokens_collected = 0;
+    int total_tokens = 0;
+
+    // Newest input applied by the simulation at or before this snapshot, for latency measurement
+    std::uint64_t input_sequence = 0;  ///< Count of input events applied so far
+    InputClock::time_point input_time; ///< When the newest applied input was sampled
+
+    // Audio, played by the main thread since SplashKit audio is not called from the simulation thread
+    GameMode game_mode = GameMode::STARTING; ///< Picks the background loop
+    double pellet_percentage = 100.0;        ///< Pellets remaining (0-100), picks the chase sound
+    AudioCues audio;                         ///< Sound events so far
+};
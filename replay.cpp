@@ -0,0 +1,122 @@
+#include "replay.h"
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+/**
+ * @file replay.cpp
+ * @brief Reading and writing replay files
+ *
+ * Format (one record per line):
+ *   PACMAN_REPLAY <version>
+ *   seed <n>, level <n>, endless <0|1>, speed <multiplier>, palette <id>, ticks <n>
+ *   tuning <name> <value> - one line per ghost constant (since version 2)
+ *   start <tick>         - play began after the start jingle
+ *   input <tick> <dir>   - direction change (direction_t value)
+ */
+
+bool save_replay(const std::string &path, const Replay &replay)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+        return false;
+
+    file.precision(std::numeric_limits<double>::max_digits10);
+    file << "PACMAN_REPLAY " << ReplayConfig::FORMAT_VERSION << "\n";
+    file << "seed " << replay.seed << "\n";
+    file << "level " << replay.level << "\n";
+    file << "endless " << (replay.endless ? 1 : 0) << "\n";
+    file << "speed " << replay.speed_multiplier << "\n";
+    file << "palette " << static_cast<int>(replay.palette) << "\n";
+    file << "ticks " << replay.tick_count << "\n";
+    for (int i = 0; i < GHOST_CONSTANT_COUNT; i++)
+    {
+        file << "tuning " << ghost_tuning_value_name(i) << " " << ghost_tuning_value(replay.ghost_tuning, i) << "\n";
+    }
+
+    for (const ReplayEvent &event : replay.events)
+    {
+        if (event.type == ReplayEventType::START)
+            file << "start " << event.tick << "\n";
+        else
+            file << "input " << event.tick << " " << static_cast<int>(event.dir) << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool load_replay(const std::string &path, Replay &replay)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    std::string magic;
+    int version = 0;
+    if (!(file >> magic >> version) || magic != "PACMAN_REPLAY" || version < 1 || version > ReplayConfig::FORMAT_VERSION)
+        return false;
+
+    Replay loaded;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string key;
+        if (!(fields >> key))
+            continue;
+
+        bool ok = true;
+        if (key == "seed")
+            ok = static_cast<bool>(fields >> loaded.seed);
+        else if (key == "level")
+            ok = static_cast<bool>(fields >> loaded.level) && loaded.level >= 1 && loaded.level <= 5;
+        else if (key == "endless")
+        {
+            int endless = 0;
+            ok = static_cast<bool>(fields >> endless);
+            loaded.endless = endless != 0;
+        }
+        else if (key == "speed")
+            ok = static_cast<bool>(fields >> loaded.speed_multiplier);
+        else if (key == "palette")
+        {
+            int palette = 0;
+            ok = static_cast<bool>(fields >> palette) && palette >= 0 && palette < static_cast<int>(PaletteId::COUNT);
+            loaded.palette = static_cast<PaletteId>(palette);
+        }
+        else if (key == "ticks")
+            ok = static_cast<bool>(fields >> loaded.tick_count);
+        else if (key == "tuning")
+        {
+            std::string name;
+            double value = 0.0;
+            ok = static_cast<bool>(fields >> name >> value) && value > 0.0;
+            int index = 0;
+            while (index < GHOST_CONSTANT_COUNT && ghost_tuning_value_name(index) != name)
+                index++;
+            ok = ok && index < GHOST_CONSTANT_COUNT;
+            if (ok)
+                ghost_tuning_value(loaded.ghost_tuning, index) = value;
+        }
+        else if (key == "start")
+        {
+            ReplayEvent event;
+            event.type = ReplayEventType::START;
+            ok = static_cast<bool>(fields >> event.tick);
+            loaded.events.push_back(event);
+        }
+        else if (key == "input")
+        {
+            ReplayEvent event;
+            int dir = 0;
+            ok = static_cast<bool>(fields >> event.tick >> dir) && dir >= DIR_NONE && dir <= DIR_DOWN;
+            event.dir = static_cast<direction_t>(dir);
+            loaded.events.push_back(event);
+        }
+
+        if (!ok)
+            return false;
+    }
+
+    replay = std::move(loaded);
+    return true;
+}
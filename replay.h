@@ -0,0 +1,73 @@
+#pragma once
+
+#include "direction.h"
+#include "ghost_tuning.h"
+#include "palette.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file replay.h
+ * @brief Recorded games that can be simulated again tick for tick
+ *
+ * The simulation is deterministic given its settings, the random seed and
+ * the tick each input was applied on, so that is all a replay stores.
+ * Replays are plain text, one record per line.
+ */
+
+/**
+ * Replay configuration constants
+ */
+namespace ReplayConfig
+{
+    constexpr const char *LAST_REPLAY_PATH = "Resources/last_replay.txt"; ///< Written at the end of every game
+    constexpr int FORMAT_VERSION = 2; ///< Version 2 added the ghost tuning; version 1 files still load
+}
+
+/**
+ * Kinds of recorded event
+ */
+enum class ReplayEventType
+{
+    START, ///< The level's start jingle finished; play began on this tick
+    INPUT  ///< A direction change was applied before this tick
+};
+
+/**
+ * One recorded event
+ */
+struct ReplayEvent
+{
+    std::uint32_t tick = 0; ///< Simulation tick counted from the start of the game
+    ReplayEventType type = ReplayEventType::INPUT;
+    direction_t dir = DIR_NONE; ///< Direction held (INPUT only), DIR_NONE once released
+};
+
+/**
+ * A whole game: the settings it started with and every event, in tick order
+ */
+struct Replay
+{
+    std::uint32_t seed = 0;        ///< Seeds the game's random numbers before the first entity is created
+    int level = 1;                 ///< Starting level (1-5)
+    bool endless = false;          ///< Whether clearing a level moves on to the next
+    double speed_multiplier = 1.0; ///< Difficulty speed multiplier
+    GhostTuning ghost_tuning;      ///< Ghost constants played with (its speed_multipliers are not recorded)
+    PaletteId palette = PaletteId::YELLOW_RED_BLUE;
+    std::uint32_t tick_count = 0; ///< Ticks simulated before the game ended
+    std::vector<ReplayEvent> events;
+};
+
+/**
+ * @brief Write a replay to a file
+ * @return false if the file could not be written
+ */
+bool save_replay(const std::string &path, const Replay &replay);
+
+/**
+ * @brief Read a replay written by save_replay
+ * Version 1 files have no ghost tuning and load with the default one.
+ * @return false if the file is missing, from an unknown format version or malformed
+ */
+bool load_replay(const std::string &path, Replay &replay);
@@ -0,0 +1,78 @@
+#include "replay_player.h"
+#include "game_config.h"
+
+/**
+ * @file replay_player.cpp
+ * @brief Implementation of the ReplayPlayer class
+ */
+
+ReplayPlayer::ReplayPlayer(Simulation &simulation)
+    : simulation_(&simulation), replay_(nullptr), cursor_(0), tick_(0), level_(1), starting_(true),
+      finished_(true), level_cleared_(false)
+{
+}
+
+void ReplayPlayer::start(const Replay &replay)
+{
+    replay_ = &replay;
+    cursor_ = 0;
+    tick_ = 0;
+    level_ = replay.level;
+    starting_ = true;
+    finished_ = false;
+    level_cleared_ = false;
+    events_ = StepEvents();
+
+    SimulationSettings settings;
+    settings.seed = replay.seed;
+    settings.palette = replay.palette;
+    settings.speed_multiplier = replay.speed_multiplier;
+    settings.ghost_tuning = replay.ghost_tuning;
+    simulation_->new_game(level_, settings);
+}
+
+bool ReplayPlayer::step()
+{
+    if (finished_ || tick_ >= replay_->tick_count)
+        return false;
+
+    // A level cleared on the previous tick leads to the next one, as Game::finish_round does
+    if (level_cleared_)
+    {
+        level_cleared_ = false;
+        if (!replay_->endless)
+        {
+            finished_ = true;
+            return false;
+        }
+        level_ = level_ % 5 + 1;
+        simulation_->next_level(level_);
+        starting_ = true;
+    }
+
+    const std::vector<ReplayEvent> &events = replay_->events;
+    while (cursor_ < events.size() && events[cursor_].type == ReplayEventType::INPUT && events[cursor_].tick == tick_)
+    {
+        simulation_->apply_input(events[cursor_].dir);
+        cursor_++;
+    }
+
+    // Play begins on the recorded tick, when the start jingle finished
+    if (starting_ && cursor_ < events.size() && events[cursor_].type == ReplayEventType::START &&
+        events[cursor_].tick == tick_)
+    {
+        cursor_++;
+        starting_ = false;
+    }
+
+    events_ = StepEvents();
+    if (!starting_)
+    {
+        events_ = simulation_->step(1.0 / GameConfig::SIMULATION_RATE);
+        finished_ = events_.pacman_caught;
+        level_cleared_ = events_.level_cleared;
+    }
+
+    tick_++;
+    return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "replay.h"
+#include "simulation.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file replay_player.h
+ * @brief Plays a recorded game through a Simulation, without a window
+ *
+ * This file contains the ReplayPlayer class, which re-simulates a Replay
+ * tick by tick exactly as Game does during playback, so headless tools
+ * (profile training, benchmarks, analysis) see the same game the player
+ * played.
+ */
+
+/**
+ * @class ReplayPlayer
+ * @brief Steps a Simulation through a Replay
+ *
+ * Each tick applies the inputs recorded for it, then steps the simulation
+ * at GameConfig::SIMULATION_RATE once the recorded START event has passed.
+ * An endless game moves on to the next level after a clear. Playback ends
+ * with the recording, when Pac-Man is caught, or when a single-level game
+ * is cleared.
+ */
+class ReplayPlayer
+{
+public:
+    /**
+     * @brief Constructor
+     * @param simulation Simulation to play into; restarted by start()
+     */
+    explicit ReplayPlayer(Simulation &simulation);
+
+    /**
+     * @brief Start a new game with the replay's seed, level and settings
+     * @param replay Game to play back; must outlive the player
+     */
+    void start(const Replay &replay);
+
+    /**
+     * @brief Simulate the next recorded tick
+     * @return false once the recorded game has ended (nothing was simulated)
+     */
+    bool step();
+
+    /**
+     * @brief Events of the last simulated step (empty while the start jingle plays)
+     */
+    const StepEvents &get_events() const { return events_; }
+
+    /**
+     * @brief Ticks played since start(), including those spent waiting for the start jingle
+     */
+    std::uint32_t get_tick() const { return tick_; }
+
+    /**
+     * @brief Level being played (1-5)
+     */
+    int get_level() const { return level_; }
+
+    /**
+     * @brief Whether the level is still waiting for its recorded START event (the start jingle)
+     */
+    bool is_starting() const { return starting_; }
+
+private:
+    Simulation *simulation_; ///< Simulation being played into
+    const Replay *replay_;   ///< Game being played back
+    std::size_t cursor_;     ///< Next replay_ event to apply
+    std::uint32_t tick_;     ///< Ticks played so far
+    int level_;              ///< Level being played
+    bool starting_;          ///< Waiting for the START event before the level begins
+    bool finished_;          ///< Pac-Man was caught or a single-level game was cleared
+    bool level_cleared_;     ///< The last step cleared the level
+    StepEvents events_;      ///< What the last step did
+};
@@ -0,0 +1,222 @@
+#include "scene_renderer.h"
+#include "systems.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+using namespace MazeConfig;
+
+namespace
+{
+    /**
+     * @brief Wall colour of a level
+     */
+    color level_wall_color(int level)
+    {
+        switch (level)
+        {
+        case 1:
+            return COLOR_BLUE;
+        case 2:
+            return COLOR_GREEN;
+        case 3:
+            return COLOR_PURPLE;
+        case 4:
+            return COLOR_RED;
+        case 5:
+            return COLOR_ORANGE; // Using orange for level 5
+        default:
+            return COLOR_BLUE; // Default fallback
+        }
+    }
+}
+
+SceneRenderer::SceneRenderer(SpriteSheet &sprite_sheet, TextRenderer &text_renderer)
+    : sprite_sheet_(&sprite_sheet), text_renderer_(&text_renderer), maze_(nullptr),
+      hud_score_(-1), hud_tokens_collected_(-1), hud_total_tokens_(-1), latency_last_tenths_(-1),
+      latency_average_tenths_(-1), latency_max_tenths_(-1)
+{
+}
+
+void SceneRenderer::reset(const Maze &maze, const GameState &game_state)
+{
+    maze_ = &maze;
+
+    tokens_.clear();
+    for (const Token &token : game_state.get_tokens())
+    {
+        tokens_.push_back({token.get_x(), token.get_y(), token.is_collected()});
+    }
+
+    power_pellets_.clear();
+    for (const PowerPellet &power_pellet : game_state.get_power_pellets())
+    {
+        power_pellets_.push_back({power_pellet.get_x(), power_pellet.get_y(), power_pellet.is_collected()});
+    }
+}
+
+void SceneRenderer::draw(const RenderSnapshot &snapshot, const drawing_options &options)
+{
+    apply_collected(snapshot);
+
+    // A fill rather than clear_screen, so drawing into a bitmap clears that bitmap
+    fill_rectangle(COLOR_BLACK, 0, 0, MAZE_COLS * CELL_SIZE, MAZE_ROWS * CELL_SIZE, options);
+
+    if (maze_)
+        draw_maze(options);
+    draw_pellets(snapshot, options);
+    draw_sprites(snapshot, options);
+    draw_hud(snapshot, options);
+}
+
+void SceneRenderer::apply_collected(const RenderSnapshot &snapshot)
+{
+    // Dirty lists may repeat pellets from earlier snapshots; marking one twice is harmless
+    for (int index : snapshot.collected_tokens)
+    {
+        tokens_[index].collected = true;
+    }
+    for (int index : snapshot.collected_power_pellets)
+    {
+        power_pellets_[index].collected = true;
+    }
+}
+
+void SceneRenderer::draw_latency_readout(const InputLatencyMeter &meter)
+{
+    const int last_tenths = static_cast<int>(meter.last_ms() * 10.0 + 0.5);
+    const int average_tenths = static_cast<int>(meter.average_ms() * 10.0 + 0.5);
+    const int max_tenths = static_cast<int>(meter.max_ms() * 10.0 + 0.5);
+
+    if (last_tenths != latency_last_tenths_ || average_tenths != latency_average_tenths_ || max_tenths != latency_max_tenths_)
+    {
+        char buffer[64];
+        int length = snprintf(buffer, sizeof(buffer), "INPUT LAG: %d.%d ms (avg %d.%d, max %d.%d)",
+                              last_tenths / 10, last_tenths % 10, average_tenths / 10, average_tenths % 10,
+                              max_tenths / 10, max_tenths % 10);
+        text_renderer_->layout_text(std::string_view(buffer, length), 16, latency_layout_);
+        latency_last_tenths_ = last_tenths;
+        latency_average_tenths_ = average_tenths;
+        latency_max_tenths_ = max_tenths;
+    }
+
+    // Backing box keeps the text readable over walls and pellets
+    const double y = MAZE_ROWS * CELL_SIZE - latency_layout_.height - 6;
+    fill_rectangle(COLOR_BLACK, 6, y - 2, latency_layout_.width + 8, latency_layout_.height + 4);
+    text_renderer_->draw_layout(latency_layout_, COLOR_WHITE, 10, y);
+}
+
+void SceneRenderer::draw_heatmap(const HeatGrid &grid) const
+{
+    std::uint64_t highest = 0;
+    for (const auto &row : grid)
+    {
+        for (std::uint64_t count : row)
+            highest = std::max(highest, count);
+    }
+    if (highest == 0)
+        return;
+
+    // Square root scaling keeps rarely visited cells visible next to the hottest one
+    for (int r = 0; r < MAZE_ROWS; r++)
+    {
+        for (int c = 0; c < MAZE_COLS; c++)
+        {
+            if (grid[r][c] == 0)
+                continue;
+            const double heat = std::sqrt(static_cast<double>(grid[r][c]) / highest);
+            const int alpha = 48 + static_cast<int>(heat * 160.0);
+            fill_rectangle(rgba_color(255, static_cast<int>(200.0 * (1.0 - heat)), 0, alpha), c * CELL_SIZE,
+                           r * CELL_SIZE, CELL_SIZE, CELL_SIZE);
+        }
+    }
+}
+
+void SceneRenderer::draw_maze(const drawing_options &options) const
+{
+    color wall_color = level_wall_color(maze_->get_level());
+    for (int r = 0; r < MAZE_ROWS; r++)
+    {
+        for (int c = 0; c < MAZE_COLS; c++)
+        {
+            if (maze_->is_wall(r, c))
+            {
+                fill_rectangle(wall_color, c * CELL_SIZE, r * CELL_SIZE, CELL_SIZE, CELL_SIZE, options);
+            }
+        }
+    }
+}
+
+void SceneRenderer::draw_pellets(const RenderSnapshot &snapshot, const drawing_options &options)
+{
+    for (const PelletView &token : tokens_)
+    {
+        if (!token.collected)
+            fill_circle(COLOR_YELLOW, token.x, token.y, TOKEN_RADIUS, options);
+    }
+
+    // The pulse follows the snapshot rather than a draw counter, so a snapshot always looks the same
+    // however often (or on whichever renderer) it is drawn
+    std::uint64_t pulse_step = snapshot.sequence * power_pellets_.size();
+    for (const PelletView &power_pellet : power_pellets_)
+    {
+        if (power_pellet.collected)
+            continue;
+
+        // Draw pulsing power pellet
+        pulse_step++;
+        double pulse = 1.0 + 0.3 * sin(static_cast<double>(pulse_step) * 0.2);
+        double radius = POWER_PELLET_RADIUS * pulse;
+
+        fill_circle(COLOR_YELLOW, power_pellet.x, power_pellet.y, radius, options);
+        draw_circle(COLOR_WHITE, power_pellet.x, power_pellet.y, radius + 1, options);
+    }
+}
+
+void SceneRenderer::draw_sprites(const RenderSnapshot &snapshot, const drawing_options &options)
+{
+    for (const RenderSprite &sprite : snapshot.sprites)
+    {
+        const SpriteFrame &cell = sprite.frame;
+        if (sprite.scaled)
+        {
+            sprite_sheet_->draw_sprite_at_pixel(sprite.palette, cell.col, cell.row,
+                                                sprite.x, sprite.y, SPRITE_SCALE, cell.flip_x, cell.flip_y, true, options);
+        }
+        else
+        {
+            sprite_sheet_->draw_sprite_at_pixel(sprite.palette, cell.col, cell.row, sprite.x, sprite.y, 1.0, false,
+                                                false, false, options);
+        }
+    }
+
+    // Score popups are drawn over every sprite
+    for (const RenderPopup &popup : snapshot.popups)
+    {
+        sprite_sheet_->draw_sprite_at_pixel(PaletteId::WHITE_GREEN_RED, popup.sprite_col, popup.sprite_row, popup.x, popup.y,
+                                            1.0, false, false, false, options);
+    }
+}
+
+void SceneRenderer::draw_hud(const RenderSnapshot &snapshot, const drawing_options &options)
+{
+    // Only re-lay out the HUD strings when the numbers behind them change
+    char buffer[48];
+    if (hud_score_ != snapshot.score)
+    {
+        int length = snprintf(buffer, sizeof(buffer), "SCORE: %d", snapshot.score);
+        text_renderer_->layout_text(std::string_view(buffer, length), 24, score_layout_);
+        hud_score_ = snapshot.score;
+    }
+
+    if (hud_tokens_collected_ != snapshot.tokens_collected || hud_total_tokens_ != snapshot.total_tokens)
+    {
+        int length = snprintf(buffer, sizeof(buffer), "PELLETS: %d/%d", snapshot.tokens_collected, snapshot.total_tokens);
+        text_renderer_->layout_text(std::string_view(buffer, length), 16, pellets_layout_);
+        hud_tokens_collected_ = snapshot.tokens_collected;
+        hud_total_tokens_ = snapshot.total_tokens;
+    }
+
+    text_renderer_->draw_layout(score_layout_, COLOR_WHITE, 10, 10, options);
+    text_renderer_->draw_layout(pellets_layout_, COLOR_WHITE, 10, 40, options);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "maze.h"
+#include "danger_map.h"
+#include "render_snapshot.h"
+#include "spritesheet.h"
+#include "text_renderer.h"
+#include "input_queue.h"
+#include <vector>
+
+/**
+ * @file scene_renderer.h
+ * @brief Draws the in-game scene from render snapshots
+ *
+ * This file contains the SceneRenderer class, which runs on the render
+ * thread and owns everything needed to draw a frame without reading the
+ * live simulation state.
+ */
+
+/**
+ * @class SceneRenderer
+ * @brief Draws the maze, pellets, sprites and HUD described by a RenderSnapshot
+ *
+ * The SceneRenderer is responsible for:
+ * - Keeping its own copy of the level's pellets, updated from each
+ *   snapshot's dirty lists rather than by scanning GameState
+ * - Drawing the maze walls in the level's colour
+ * - Drawing the snapshot's sprites, then its popups, from the sprite sheet
+ * - Re-laying out the HUD text only when the values it shows change
+ *
+ * The maze is drawn directly: its layout never changes while the
+ * simulation thread is running.
+ */
+class SceneRenderer
+{
+public:
+    /**
+     * @brief Constructor
+     * @param sprite_sheet Sprite sheet used for entities and popups
+     * @param text_renderer Glyph-cached text renderer used for the HUD
+     */
+    SceneRenderer(SpriteSheet &sprite_sheet, TextRenderer &text_renderer);
+
+    /**
+     * @brief Start drawing a new level
+     * Call only while the simulation thread is stopped.
+     * @param maze Maze to draw (must outlive its use by the renderer)
+     * @param game_state Source of the level's pellet positions and collected state
+     */
+    void reset(const Maze &maze, const GameState &game_state);
+
+    /**
+     * @brief Apply a snapshot's collected pellets and draw the full scene
+     * @param snapshot Snapshot to draw
+     * @param options Drawing options, such as option_to_bitmap() to draw into a cached frame
+     */
+    void draw(const RenderSnapshot &snapshot, const drawing_options &options = option_defaults());
+
+    /**
+     * @brief Apply a snapshot's collected pellets without drawing
+     * Used to catch up on snapshots that are skipped rather than drawn.
+     * @param snapshot Snapshot whose dirty lists to apply
+     */
+    void apply_collected(const RenderSnapshot &snapshot);
+
+    /**
+     * @brief Draw the input-to-photon latency readout in the bottom-left corner
+     * @param meter Latency statistics to show
+     */
+    void draw_latency_readout(const InputLatencyMeter &meter);
+
+    /**
+     * @brief Shade each cell over the maze in proportion to its count
+     * Draw after draw() so walls and pellets show through; empty cells stay clear.
+     * @param grid Counts per cell, such as a DangerMap layer
+     */
+    void draw_heatmap(const HeatGrid &grid) const;
+
+private:
+    /**
+     * A pellet as seen by the renderer
+     */
+    struct PelletView
+    {
+        double x;
+        double y;
+        bool collected;
+    };
+
+    SpriteSheet *sprite_sheet_;
+    TextRenderer *text_renderer_;
+    const Maze *maze_;
+
+    std::vector<PelletView> tokens_;
+    std::vector<PelletView> power_pellets_;
+
+    // HUD text layouts, rebuilt only when the values they show change
+    TextLayout score_layout_;
+    TextLayout pellets_layout_;
+    int hud_score_;
+    int hud_tokens_collected_;
+    int hud_total_tokens_;
+
+    // Latency readout, re-laid out only when its value (in tenths of a millisecond) changes
+    TextLayout latency_layout_;
+    int latency_last_tenths_;
+    int latency_average_tenths_;
+    int latency_max_tenths_;
+
+    void draw_maze(const drawing_options &options) const;
+    void draw_pellets(const RenderSnapshot &snapshot, const drawing_options &options);
+    void draw_sprites(const RenderSnapshot &snapshot, const drawing_options &options);
+    void draw_hud(const RenderSnapshot &snapshot, const drawing_options &options);
+};
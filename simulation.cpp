@@ -0,0 +1,308 @@
+#include "simulation.h"
+#include "alloc_tracker.h"
+#include "analytics.h"
+#include "systems.h"
+#include "game_config.h"
+#include <cmath>
+
+/**
+ * @file simulation.cpp
+ * @brief Implementation of the Simulation class
+ */
+
+using namespace GameConfig;
+using namespace MazeConfig;
+
+namespace
+{
+    constexpr int GHOST_EAT_POINTS = 400; ///< Points for catching a scared ghost (matches the popup)
+
+    /**
+     * Cells where Pac-Man and the two ghosts start a level
+     */
+    struct SpawnCells
+    {
+        std::pair<int, int> pacman;
+        std::pair<int, int> ghost1;
+        std::pair<int, int> ghost2;
+    };
+
+    /**
+     * @brief Find the open cells nearest to each character's preferred start
+     */
+    SpawnCells find_spawn_cells(const Maze &maze)
+    {
+        SpawnCells cells;
+        cells.pacman = Maze::find_spawn_position(maze, MAZE_ROWS / 2 + 3, MAZE_COLS / 2);
+        cells.ghost1 = Maze::find_spawn_position(maze, MAZE_ROWS / 2 - 3, MAZE_COLS / 2);
+        cells.ghost2 = Maze::find_spawn_position(maze, MAZE_ROWS / 2 + 1, MAZE_COLS / 2 + 5);
+        return cells;
+    }
+}
+
+Simulation::Simulation()
+    : world_(&timer_wheel_), tick_accumulator_(0.0), analytics_(nullptr), game_steps_(0), level_start_step_(0)
+{
+    ghosts_.reserve(2);
+}
+
+void Simulation::new_game(int level, const SimulationSettings &settings)
+{
+    // Drop entities and timers left over from the previous game before new entities schedule theirs
+    timer_wheel_.clear();
+    world_.clear();
+    tick_accumulator_ = 0.0;
+
+    // Everything random in the game comes from the world's generator, so the seed alone reproduces it
+    world_.random().reseed(settings.seed);
+    world_.set_tuning(settings.ghost_tuning);
+
+    load_maze(level);
+    const SpawnCells spawn = find_spawn_cells(level_.maze);
+
+    // Fruit is created first so it is drawn beneath Pac-Man and the ghosts
+    AllocScope alloc_scope(AllocTag::ENTITIES);
+    fruit_.emplace(world_);
+
+    pacman_.emplace(
+        world_,
+        Maze::get_cell_center_x(spawn.pacman.second),
+        Maze::get_cell_center_y(spawn.pacman.first),
+        settings.palette);
+    pacman_->set_speed_multiplier(settings.speed_multiplier);
+
+    ghosts_.clear();
+    ghosts_.emplace_back(
+        world_,
+        Maze::get_cell_center_x(spawn.ghost1.second),
+        Maze::get_cell_center_y(spawn.ghost1.first),
+        PaletteId::RED_BLUE_WHITE,
+        GhostAIType::RANDOM_PATROL);
+    ghosts_.emplace_back(
+        world_,
+        Maze::get_cell_center_x(spawn.ghost2.second),
+        Maze::get_cell_center_y(spawn.ghost2.first),
+        PaletteId::PINK_BLUE_WHTE,
+        GhostAIType::AMBUSHER);
+
+    for (Ghost &ghost : ghosts_)
+    {
+        ghost.set_speed_multiplier(settings.speed_multiplier);
+    }
+
+    level_.game_state = GameState();
+    level_.maze.initialize_tokens(level_.game_state, spawn.pacman.first, spawn.pacman.second);
+    level_.maze.initialize_power_pellets(level_.game_state);
+
+    game_steps_ = 0;
+    level_start_step_ = 0;
+    record_cell_event(AnalyticsEventKind::GAME_START, -1, -1, -1, static_cast<int>(settings.seed));
+}
+
+void Simulation::next_level(int level)
+{
+    const int score = level_.game_state.get_score();
+
+    load_maze(level);
+    const SpawnCells spawn = find_spawn_cells(level_.maze);
+
+    // Reset entities to their spawn positions, with the ghosts chasing again
+    pacman_->set_position(Maze::get_cell_center_x(spawn.pacman.second), Maze::get_cell_center_y(spawn.pacman.first));
+    ghosts_[0].set_position(Maze::get_cell_center_x(spawn.ghost1.second), Maze::get_cell_center_y(spawn.ghost1.first));
+    ghosts_[1].set_position(Maze::get_cell_center_x(spawn.ghost2.second), Maze::get_cell_center_y(spawn.ghost2.first));
+    for (Ghost &ghost : ghosts_)
+    {
+        ghost.set_chasing_mode();
+    }
+
+    // Recreate fruit for the new level
+    {
+        AllocScope alloc_scope(AllocTag::ENTITIES);
+        world_.destroy(fruit_->get_id());
+        fruit_.emplace(world_);
+    }
+
+    // Fresh pellets, with the score carried over
+    level_.game_state = GameState();
+    level_.maze.initialize_tokens(level_.game_state, spawn.pacman.first, spawn.pacman.second);
+    level_.maze.initialize_power_pellets(level_.game_state);
+    level_.game_state.add_score(score);
+
+    level_start_step_ = game_steps_;
+    record_cell_event(AnalyticsEventKind::LEVEL_START, -1, -1);
+}
+
+void Simulation::load_maze(int level)
+{
+    std::optional<Maze> &maze = mazes_[level - 1];
+    if (!maze)
+    {
+        AllocScope alloc_scope(AllocTag::MAZE);
+        maze.emplace(level);
+    }
+    level_.maze = *maze;
+}
+
+void Simulation::apply_input(direction_t dir)
+{
+    if (dir == DIR_NONE)
+        pacman_->release_turn();
+    else
+        pacman_->buffer_turn(dir);
+}
+
+StepEvents Simulation::step(double delta_time)
+{
+    AllocTickScope tick_scope;
+    AllocScope alloc_scope(AllocTag::SYSTEMS);
+    StepEvents events;
+    game_steps_++;
+
+    // 10% speed boost while the ghosts are scared
+    pacman_->set_power_mode(any_ghost_scared());
+
+    // Fire any gameplay timers that expired during this step
+    advance_timers(delta_time);
+
+    // Update entities: ghosts choose directions, then everything moves and animates
+    ghost_ai_system(world_, level_.maze, pacman_->get_x(), pacman_->get_y(), pacman_->get_direction(), delta_time);
+    movement_system(world_, level_.maze, delta_time);
+    animation_system(world_, delta_time);
+
+    // Check for token and power pellet collection
+    const std::size_t tokens_before = level_.game_state.get_newly_collected_tokens().size();
+    const std::size_t power_pellets_before = level_.game_state.get_newly_collected_power_pellets().size();
+    {
+        AllocScope pellet_scope(AllocTag::PELLETS);
+        level_.game_state.check_token_collection(pacman_->get_x(), pacman_->get_y());
+        events.power_pellet_collected = level_.game_state.check_power_pellet_collection(pacman_->get_x(), pacman_->get_y());
+    }
+    if (analytics_)
+    {
+        const GameState &game_state = level_.game_state;
+        const auto &tokens = game_state.get_newly_collected_tokens();
+        for (std::size_t i = tokens_before; i < tokens.size(); i++)
+        {
+            const Token &token = game_state.get_tokens()[tokens[i]];
+            record_cell_event(AnalyticsEventKind::PELLET, token.get_row(), token.get_col());
+        }
+        const auto &power_pellets = game_state.get_newly_collected_power_pellets();
+        for (std::size_t i = power_pellets_before; i < power_pellets.size(); i++)
+        {
+            const PowerPellet &power_pellet = game_state.get_power_pellets()[power_pellets[i]];
+            record_cell_event(AnalyticsEventKind::POWER_PELLET, power_pellet.get_row(), power_pellet.get_col());
+        }
+    }
+    events.token_collected = level_.game_state.was_token_just_collected();
+    level_.game_state.reset_token_collection_flag();
+
+    // Power pellet was collected - set all non-caught ghosts to scared mode in one pass
+    if (events.power_pellet_collected)
+    {
+        scare_system(world_);
+    }
+
+    // Spawn fruit once its timer has fired
+    bonus_system(world_, level_.maze);
+
+    if (fruit_->check_collision(pacman_->get_x(), pacman_->get_y()))
+    {
+        level_.game_state.add_score(fruit_->get_points());
+        events.fruit_collected = true;
+        record_event(AnalyticsEventKind::FRUIT, pacman_->get_x(), pacman_->get_y(), -1, fruit_->get_points());
+    }
+
+    handle_ghost_collisions(events);
+    if (events.pacman_caught)
+    {
+        return events;
+    }
+
+    events.level_cleared = level_.game_state.all_tokens_collected();
+    if (events.level_cleared)
+    {
+        record_event(AnalyticsEventKind::LEVEL_CLEARED, pacman_->get_x(), pacman_->get_y(), -1,
+                     static_cast<int>(game_steps_ - level_start_step_));
+    }
+    return events;
+}
+
+bool Simulation::any_ghost_scared() const
+{
+    for (const Ghost &ghost : ghosts_)
+    {
+        if (ghost.is_scared())
+            return true;
+    }
+    return false;
+}
+
+double Simulation::pellet_percentage() const
+{
+    int total = level_.game_state.get_total_tokens();
+    int collected = level_.game_state.get_tokens_collected();
+    return total > 0 ? 100.0 * (total - collected) / total : 100.0;
+}
+
+void Simulation::advance_timers(double delta_time)
+{
+    const double tick_length = 1.0 / TimerConfig::TICKS_PER_SECOND;
+    tick_accumulator_ += delta_time;
+    while (tick_accumulator_ >= tick_length)
+    {
+        tick_accumulator_ -= tick_length;
+        timer_wheel_.tick();
+    }
+}
+
+void Simulation::handle_ghost_collisions(StepEvents &events)
+{
+    for (Ghost &ghost : ghosts_)
+    {
+        double dx = pacman_->get_x() - ghost.get_x();
+        double dy = pacman_->get_y() - ghost.get_y();
+        double distance = sqrt(dx * dx + dy * dy);
+
+        if (distance > COLLISION_DISTANCE || !ghost.can_interact())
+            continue;
+
+        if (ghost.is_scared())
+        {
+            // Pac-Man catches scared ghost and a 400-point popup shows where it was
+            ghost.set_caught_mode();
+            level_.game_state.add_score(GHOST_EAT_POINTS);
+            ghost.trigger_score_popup(ghost.get_x(), ghost.get_y());
+            events.ghosts_caught++;
+            record_event(AnalyticsEventKind::GHOST_CAUGHT, ghost.get_x(), ghost.get_y(),
+                         static_cast<int>(ghost.get_ai_type()), GHOST_EAT_POINTS);
+        }
+        else if (!ghost.is_caught())
+        {
+            events.pacman_caught = true;
+            record_event(AnalyticsEventKind::DEATH, pacman_->get_x(), pacman_->get_y(),
+                         static_cast<int>(ghost.get_ai_type()));
+            return;
+        }
+    }
+}
+
+void Simulation::record_event(AnalyticsEventKind kind, double x, double y, int ghost, int value)
+{
+    record_cell_event(kind, static_cast<int>(floor(y / CELL_SIZE)), static_cast<int>(floor(x / CELL_SIZE)), ghost, value);
+}
+
+void Simulation::record_cell_event(AnalyticsEventKind kind, int row, int col, int ghost, int value)
+{
+    if (!analytics_)
+        return;
+
+    AnalyticsEvent event;
+    event.kind = kind;
+    event.tick = game_steps_;
+    event.level = level_.maze.get_level();
+    event.row = row;
+    event.col = col;
+    event.ghost = ghost;
+    event.value = value;
+    analytics_->record(event);
+}
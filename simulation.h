@@ -0,0 +1,191 @@
+#pragma once
+
+#include "maze.h"
+#include "entities.h"
+#include "world.h"
+#include "timer_wheel.h"
+#include "palette.h"
+#include "ghost_tuning.h"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * @file simulation.h
+ * @brief The game rules, free of any window, sound or input
+ *
+ * This file contains the Simulation class, which owns the maze, the
+ * entities and the score and advances them one step at a time. It does not
+ * include SplashKit, so it links into headless tools such as benchmarks and
+ * tests as well as into the game itself.
+ */
+
+class AnalyticsLog;
+enum class AnalyticsEventKind : std::uint8_t;
+
+/**
+ * Everything a new game is started from
+ */
+struct SimulationSettings
+{
+    std::uint32_t seed = 0;             ///< Seeds the game's random numbers (as srand() would)
+    PaletteId palette = PACMAN_PALETTE; ///< Pac-Man's colours
+    double speed_multiplier = 1.0;      ///< Difficulty speed multiplier for every character
+    GhostTuning ghost_tuning;           ///< Ghost distances and durations (its speed_multipliers are not read here)
+};
+
+/**
+ * What happened during one Simulation::step, for the caller to play sounds and change mode
+ */
+struct StepEvents
+{
+    bool token_collected = false;        ///< Pac-Man ate at least one token
+    bool power_pellet_collected = false; ///< Pac-Man ate a power pellet and the ghosts were scared
+    bool fruit_collected = false;        ///< Pac-Man ate the bonus fruit
+    int ghosts_caught = 0;               ///< Scared ghosts Pac-Man caught
+    bool pacman_caught = false;          ///< A chasing ghost caught Pac-Man; the rest of the step was skipped
+    bool level_cleared = false;          ///< Every token has been collected
+};
+
+/**
+ * Everything that is replaced when a level starts, in one fixed-size block
+ * Maze and GameState store their cells and pellets inline, so loading a level
+ * is a copy into this block and copying it snapshots the level without allocating.
+ */
+struct LevelState
+{
+    Maze maze;            ///< Maze of the level being played
+    GameState game_state; ///< Score, pellets, and game statistics
+};
+
+/**
+ * @class Simulation
+ * @brief Owns and advances the maze, entities and score of one game
+ *
+ * The Simulation is responsible for:
+ * - Creating the maze, Pac-Man, the ghosts and the fruit for a level
+ * - Running the systems over the World once per step
+ * - Scoring pellets, fruit and caught ghosts
+ * - Reporting collisions and level completion through StepEvents
+ *
+ * Game modes, the start jingle, sounds and drawing stay with the caller,
+ * which decides when to step and how to react to the events.
+ *
+ * Given an AnalyticsLog, every step also records what happened in detail
+ * (which cell, which ghost, how long the level took) for offline analysis.
+ *
+ * Each maze file is parsed the first time its level is played and kept;
+ * later level loads copy it into the LevelState and reuse the entity
+ * storage, so an endless game stops allocating once every level has been
+ * seen.
+ */
+class Simulation
+{
+public:
+    /**
+     * @brief Constructor - starts with an empty level 1 maze
+     */
+    Simulation();
+
+    Simulation(const Simulation &) = delete;
+    Simulation &operator=(const Simulation &) = delete;
+
+    /**
+     * @brief Start a new game: seed its random numbers, then create the level and its entities
+     * @param level Level to play (1-5)
+     * @param settings Seed, palette and speed of the game
+     */
+    void new_game(int level, const SimulationSettings &settings);
+
+    /**
+     * @brief Move on to another level, keeping the entities and the score
+     * @param level Level to play (1-5)
+     */
+    void next_level(int level);
+
+    /**
+     * @brief Apply a change of the held direction key to Pac-Man, as the keyboard does
+     * @param dir Direction now held (buffers a turn), or DIR_NONE once released
+     */
+    void apply_input(direction_t dir);
+
+    /**
+     * @brief Advance the game by one step
+     * @param delta_time Time elapsed since the last step (seconds)
+     * @return What happened during the step
+     */
+    StepEvents step(double delta_time);
+
+    /**
+     * @brief Record gameplay events into a log; attach before new_game so each game starts with GAME_START
+     * @param analytics Log to record into (must outlive its use), or nullptr to stop recording
+     */
+    void set_analytics(AnalyticsLog *analytics) { analytics_ = analytics; }
+
+    /**
+     * @brief Check whether any ghost is scared (power mode)
+     */
+    bool any_ghost_scared() const;
+
+    /**
+     * @brief Calculate the percentage of tokens remaining
+     * @return Percentage of tokens left (0-100)
+     */
+    double pellet_percentage() const;
+
+    // Getters
+    const Maze &get_maze() const { return level_.maze; }
+    GameState &get_game_state() { return level_.game_state; }
+    const GameState &get_game_state() const { return level_.game_state; }
+    const LevelState &get_level_state() const { return level_; }
+    World &get_world() { return world_; }
+    const World &get_world() const { return world_; }
+    Pacman &get_pacman() { return *pacman_; }
+    const Pacman &get_pacman() const { return *pacman_; }
+    const std::vector<Ghost> &get_ghosts() const { return ghosts_; }
+
+private:
+    TimerWheel timer_wheel_;                   ///< Gameplay timers (declared first so entities are destroyed before it)
+    World world_;                              ///< Component storage for every entity
+    LevelState level_;                         ///< Maze and pellets of the level being played
+    std::array<std::optional<Maze>, 5> mazes_; ///< Each level's maze, parsed the first time it is played
+    std::optional<Pacman> pacman_;             ///< Player character
+    std::vector<Ghost> ghosts_;                ///< AI ghosts
+    std::optional<Fruit> fruit_;               ///< Bonus fruit
+    double tick_accumulator_;                  ///< Game time not yet turned into whole timer wheel ticks (seconds)
+    AnalyticsLog *analytics_;                  ///< Where gameplay events are recorded, if anywhere
+    std::uint32_t game_steps_;                 ///< Steps since the game started
+    std::uint32_t level_start_step_;           ///< game_steps_ when the current level started
+
+    /**
+     * @brief Copy a level's maze into level_, parsing its file on first use
+     * @param level Level to load (1-5)
+     */
+    void load_maze(int level);
+
+    /**
+     * @brief Advance the timer wheel by the whole ticks contained in delta_time
+     * @param delta_time Time elapsed since last step (seconds)
+     */
+    void advance_timers(double delta_time);
+
+    /**
+     * @brief Score scared ghosts Pac-Man touches and report whether a chasing one caught him
+     * @param events Filled with the ghosts caught and whether Pac-Man was caught
+     */
+    void handle_ghost_collisions(StepEvents &events);
+
+    /**
+     * @brief Record an event at a position into analytics_, if there is one
+     * @param x, y Position in pixels, recorded as the maze cell containing it
+     * @param ghost GhostAIType of the ghost involved, or -1
+     * @param value Kind-specific figure (see AnalyticsEventKind)
+     */
+    void record_event(AnalyticsEventKind kind, double x, double y, int ghost = -1, int value = 0);
+
+    /**
+     * @brief Record an event in a maze cell into analytics_, if there is one
+     */
+    void record_cell_event(AnalyticsEventKind kind, int row, int col, int ghost = -1, int value = 0);
+};
@@ -6,7 +6,7 @@ using namespace SoundConfig;
  * @brief Constructor - initializes sound manager with default state
  */
 SoundManager::SoundManager()
-    : ghost_chase_sound_playing_(false), current_ghost_chase_sound_(nullptr), ghost_blue_sound_playing_(false), start_sound_playing_(false), use_dot1_sound_(true), sound_base_path_(BASE_SOUND_PATH)
+    : ghost_chase_sound_playing_(false), current_ghost_chase_sound_(nullptr), ghost_blue_sound_playing_(false), start_sound_playing_(false), use_dot1_sound_(true), sound_base_path_(BASE_SOUND_PATH), muted_(false)
 {
 }
 
@@ -55,6 +55,9 @@ bool SoundManager::initialize()
  */
 void SoundManager::update_background_audio(GameMode game_mode, double pellet_percentage)
 {
+    if (muted_)
+        return;
+
     switch (game_mode)
     {
     case GameMode::STARTING:
@@ -119,6 +122,9 @@ void SoundManager::update_background_audio(GameMode game_mode, double pellet_per
  */
 void SoundManager::play_dot_collection_sound()
 {
+    if (muted_)
+        return;
+
     if (use_dot1_sound_)
     {
         play_sound_effect(DOT1_SOUND_NAME);
@@ -137,6 +143,9 @@ void SoundManager::play_dot_collection_sound()
  */
 void SoundManager::play_ghost_eat_sound()
 {
+    if (muted_)
+        return;
+
     play_sound_effect(GHOST_EAT_SOUND_NAME);
 }
 
@@ -145,6 +154,9 @@ void SoundManager::play_ghost_eat_sound()
  */
 void SoundManager::play_ghost_retreat_sound()
 {
+    if (muted_)
+        return;
+
     play_sound_effect(GHOST_RETREAT_SOUND_NAME);
 }
 
@@ -153,6 +165,9 @@ void SoundManager::play_ghost_retreat_sound()
  */
 void SoundManager::play_cutscene_sound()
 {
+    if (muted_)
+        return;
+
     play_sound_effect(CUTSCENE_SOUND_NAME);
 }
 
@@ -268,3 +283,16 @@ void SoundManager::unload_all_sounds()
     if (has_sound_effect(CUTSCENE_SOUND_NAME))
         free_sound_effect(sound_effect_named(CUTSCENE_SOUND_NAME));
 }
+
+/**
+ * @brief Mute or unmute all game audio (used by attract mode)
+ * @param muted true to silence background audio and sound effects
+ */
+void SoundManager::set_muted(bool muted)
+{
+    muted_ = muted;
+    if (muted_)
+    {
+        stop_all_sounds();
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "splashkit.h"
+#include "game_mode.h"
 #include <string>
 
 /**
@@ -57,19 +58,6 @@ namespace SoundConfig
     constexpr const char *FRUIT_SOUND_FILE = "fruit.wav";
 }
 
-/**
- * Game mode enumeration for sound management
- * Determines which background sounds should be playing
- */
-enum class GameMode
-{
-    STARTING,   ///< Game starting sequence (plays start.wav)
-    NORMAL,     ///< Ghosts chasing Pac-Man (plays ghost chase sounds)
-    POWER_MODE, ///< Pac-Man chasing scared ghosts (plays ghostblue.wav)
-    GAME_OVER,  ///< Game has ended (stops all sounds, plays die.wav)
-    VICTORY     ///< All pellets collected (stops all sounds)
-};
-
 /**
  * @class SoundManager
  * @brief Manages all audio operations for the Pac-Man game
@@ -145,6 +133,18 @@ public:
      */
     void unload_all_sounds();
 
+    /**
+     * @brief Mute or unmute all game audio (used by attract mode)
+     * @param muted true to silence background audio and sound effects
+     */
+    void set_muted(bool muted);
+
+    /**
+     * @brief Check if game audio is muted
+     * @return true if muted, false otherwise
+     */
+    bool is_muted() const { return muted_; }
+
 private:
     // Sound state tracking
     bool ghost_chase_sound_playing_;        ///< Whether a ghost chase sound is currently playing
@@ -153,6 +153,7 @@ private:
     bool start_sound_playing_;              ///< Whether start.wav is currently playing
     bool use_dot1_sound_;                   ///< Alternates between dot1 and dot2 sounds
     std::string sound_base_path_;           ///< Base path for sound files
+    bool muted_;                            ///< Whether all game audio is silenced
 
     /**
      * @brief Get the appropriate ghost chase sound name based on pellet percentage
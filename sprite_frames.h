@@ -0,0 +1,179 @@
+#pragma once
+
+#include "components.h"
+#include "palette.h"
+#include "direction.h"
+#include <array>
+
+/**
+ * @file sprite_frames.h
+ * @brief Precomputed sprite frame tables for every animated entity kind
+ *
+ * The rules that map an entity's kind, pose, direction and animation frame
+ * to a sprite cell (and flips) are evaluated once at compile time into a
+ * flat table. Picking the sprite for an entity each frame is then a single
+ * indexed load with no branching.
+ */
+
+// Ghost sprite coordinates (col, row) in the spritesheet
+namespace GhostSprites
+{
+    // Scared ghost sprites (when Pac-Man has power pellet)
+    constexpr int SCARED_1_COL = 5, SCARED_1_ROW = 0;
+    constexpr int SCARED_2_COL = 5, SCARED_2_ROW = 1;
+
+    // Directional ghost sprites with animation frames
+    constexpr int RIGHT_1_COL = 0, RIGHT_1_ROW = 0;
+    constexpr int RIGHT_2_COL = 1, RIGHT_2_ROW = 0;
+    constexpr int DOWN_1_COL = 2, DOWN_1_ROW = 0;
+    constexpr int DOWN_2_COL = 3, DOWN_2_ROW = 0;
+    constexpr int LEFT_1_COL = 4, LEFT_1_ROW = 0;
+    constexpr int LEFT_2_COL = 5, LEFT_2_ROW = 0;
+    constexpr int UP_1_COL = 6, UP_1_ROW = 0;
+    constexpr int UP_2_COL = 7, UP_2_ROW = 0;
+}
+
+/**
+ * A sprite cell on the sheet plus the flips to draw it with
+ */
+struct SpriteFrame
+{
+    int col = 0;
+    int row = 0;
+    bool flip_x = false;
+    bool flip_y = false;
+};
+
+/**
+ * Pose selects between alternative sprite sets for the same kind
+ */
+enum class SpritePose : std::uint8_t
+{
+    NORMAL, ///< Directional sprites
+    SCARED, ///< Scared ghost sprites (direction ignored)
+    COUNT
+};
+
+/**
+ * Per-kind animation and drawing settings
+ */
+struct SpriteKindInfo
+{
+    int frame_count;       ///< Frames in the kind's animation loop
+    double frame_duration; ///< Seconds per frame
+    bool scaled;           ///< Drawn at SPRITE_SCALE and trimmed (maze actors) rather than 1:1
+};
+
+namespace SpriteFrames
+{
+    constexpr int KIND_COUNT = static_cast<int>(SpriteKind::COUNT);
+    constexpr int POSE_COUNT = static_cast<int>(SpritePose::COUNT);
+    constexpr int DIRECTION_COUNT = DIR_DOWN + 1;
+    constexpr int MAX_FRAMES = 4; ///< Animation frames, or fruit variants
+
+    /// Indexed by SpriteKind
+    constexpr SpriteKindInfo KIND_INFO[KIND_COUNT] = {
+        {3, 0.1, true},  // PACMAN: open, closing, closed at 100ms per frame
+        {2, 0.2, true},  // GHOST: two frames at 200ms per frame
+        {1, 0.0, false}, // FRUIT: not animated; the frame index is the fruit type
+    };
+
+    constexpr int index(SpriteKind kind, SpritePose pose, direction_t dir, int frame)
+    {
+        return ((static_cast<int>(kind) * POSE_COUNT + static_cast<int>(pose)) * DIRECTION_COUNT + dir) * MAX_FRAMES + frame;
+    }
+
+    constexpr SpriteFrame pacman_frame(direction_t dir, int frame)
+    {
+        // Frame 0 (open): col 3, Frame 1 (closing): col 4, Frame 2 (closed): col 5
+        const int col = 3 + frame;
+        const bool closed = (frame == 2);
+
+        switch (dir)
+        {
+        case DIR_RIGHT:
+            return {col, 6, false, false};
+        case DIR_LEFT:
+            return {col, 6, true, false};
+        case DIR_DOWN:
+            // Special case: closed state uses row 6 instead of 7
+            return {col, closed ? 6 : 7, false, false};
+        case DIR_UP:
+            // Special case: closed state uses row 6 instead of 7, with flip_y
+            return {col, closed ? 6 : 7, false, true};
+        default:
+            return {5, 6, false, false}; // DIR_NONE - closed mouth
+        }
+    }
+
+    constexpr SpriteFrame ghost_frame(SpritePose pose, direction_t dir, int frame)
+    {
+        const bool is_frame_2 = (frame == 1);
+
+        // Scared ghosts use the same sprites regardless of direction
+        if (pose == SpritePose::SCARED)
+        {
+            return is_frame_2 ? SpriteFrame{GhostSprites::SCARED_2_COL, GhostSprites::SCARED_2_ROW, false, false}
+                              : SpriteFrame{GhostSprites::SCARED_1_COL, GhostSprites::SCARED_1_ROW, false, false};
+        }
+
+        switch (dir)
+        {
+        case DIR_RIGHT:
+            return {0, is_frame_2 ? 1 : 0, false, false};
+        case DIR_LEFT:
+            return {0, is_frame_2 ? 5 : 4, false, false};
+        case DIR_DOWN:
+            return {0, is_frame_2 ? 3 : 2, false, false};
+        case DIR_UP:
+            return {0, is_frame_2 ? 7 : 6, false, false};
+        default:
+            return {0, 0, false, false}; // DIR_NONE - face right
+        }
+    }
+
+    constexpr std::array<SpriteFrame, KIND_COUNT * POSE_COUNT * DIRECTION_COUNT * MAX_FRAMES> build_table()
+    {
+        std::array<SpriteFrame, KIND_COUNT * POSE_COUNT * DIRECTION_COUNT * MAX_FRAMES> table{};
+
+        for (int pose = 0; pose < POSE_COUNT; pose++)
+        {
+            for (int dir = 0; dir < DIRECTION_COUNT; dir++)
+            {
+                for (int frame = 0; frame < MAX_FRAMES; frame++)
+                {
+                    const SpritePose p = static_cast<SpritePose>(pose);
+                    const direction_t d = static_cast<direction_t>(dir);
+
+                    // Frames past a kind's loop length repeat its last frame
+                    const int pacman_frames = KIND_INFO[static_cast<int>(SpriteKind::PACMAN)].frame_count;
+                    const int ghost_frames = KIND_INFO[static_cast<int>(SpriteKind::GHOST)].frame_count;
+                    const int pacman_frame_index = frame < pacman_frames ? frame : pacman_frames - 1;
+                    const int ghost_frame_index = frame < ghost_frames ? frame : ghost_frames - 1;
+
+                    table[index(SpriteKind::PACMAN, p, d, frame)] = pacman_frame(d, pacman_frame_index);
+                    table[index(SpriteKind::GHOST, p, d, frame)] = ghost_frame(p, d, ghost_frame_index);
+
+                    // Fruit sprites are at col 2, rows 0-3 (swap x/y)
+                    table[index(SpriteKind::FRUIT, p, d, frame)] = {2, frame, false, false};
+                }
+            }
+        }
+
+        return table;
+    }
+
+    constexpr std::array<SpriteFrame, KIND_COUNT * POSE_COUNT * DIRECTION_COUNT * MAX_FRAMES> TABLE = build_table();
+
+    /**
+     * @brief Look up the sprite for an entity
+     * @param kind Entity kind
+     * @param pose Sprite set within the kind
+     * @param dir Facing direction
+     * @param frame Animation frame (or fruit type), 0 to MAX_FRAMES - 1
+     */
+    inline const SpriteFrame &lookup(SpriteKind kind, SpritePose pose, direction_t dir, int frame)
+    {
+        return TABLE[index(kind, pose, dir, frame)];
+    }
+}
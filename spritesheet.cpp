@@ -19,15 +19,11 @@ SpriteSheet::SpriteSheet(const std::string &bitmap_name, const std::string &file
     _flipped_sheet = load_bitmap((bitmap_name + "_flipped").c_str(), flipped_path.c_str());
 }
 
-void SpriteSheet::draw_sprite_at_pixel(const std::string &palette_name, int local_col, int local_row, double x, double y, double scale, bool flip_x, bool flip_y, bool trim)
+void SpriteSheet::draw_sprite_at_pixel(PaletteId palette, int local_col, int local_row, double x, double y, double scale, bool flip_x, bool flip_y, bool trim,
+                                       const drawing_options &options)
 {
     int px, py;
-    get_sprite_pixel_coords(palette_name, local_col, local_row, px, py);
-
-    // Diagnostic: print coords for Pacman palette to help debug 'garbage' output
-    if (palette_name == std::string(PACMAN_PALETTE_NAME))
-    {
-    }
+    get_sprite_pixel_coords(palette, local_col, local_row, px, py);
 
     // Decide which source bitmap to use. If the caller requested flipping and
     // we have a pre-flipped sheet available, use it and translate the source
@@ -54,7 +50,7 @@ void SpriteSheet::draw_sprite_at_pixel(const std::string &palette_name, int loca
     // If trimming is not requested, draw directly from the chosen src_sheet.
     if (!trim)
     {
-        drawing_options opts = option_part_bmp(src_px, src_py, _frame_w, _frame_h);
+        drawing_options opts = option_part_bmp(src_px, src_py, _frame_w, _frame_h, options);
         opts.scale_x = scale;
         opts.scale_y = scale;
         if (flip_x)
@@ -88,10 +84,10 @@ void SpriteSheet::draw_sprite_at_pixel(const std::string &palette_name, int loca
     // Restore previous render target
     set_render_target(old_target);
 
-    // Now draw the trimmed 15x15 from the temp bitmap to the screen
+    // Now draw the trimmed 15x15 from the temp bitmap to the screen (or the options' destination)
     int draw_w = std::max(1, _frame_w - 1);
     int draw_h = std::max(1, _frame_h - 1);
-    drawing_options final_opts = option_part_bmp(0, 0, draw_w, draw_h);
+    drawing_options final_opts = option_part_bmp(0, 0, draw_w, draw_h, options);
     final_opts.scale_x = scale;
     final_opts.scale_y = scale;
     if (flip_x)
@@ -116,7 +112,7 @@ void SpriteSheet::draw_sprite_at_pixel(const std::string &palette_name, int loca
     // 16x16 extraction but uses a smaller source rectangle.
     int draw_w = std::max(1, _frame_w - 1);
     int draw_h = std::max(1, _frame_h - 1);
-    drawing_options opts = option_part_bmp(src_px, src_py, draw_w, draw_h);
+    drawing_options opts = option_part_bmp(src_px, src_py, draw_w, draw_h, options);
     opts.scale_x = scale;
     opts.scale_y = scale;
     if (flip_x)
@@ -148,30 +144,20 @@ void SpriteSheet::ensure_temp_bitmap()
 
 // ============== Sprite Utility Functions ==============
 
-int get_palette_cell_col(const char *name)
+int get_palette_cell_col(PaletteId palette)
 {
-    for (const auto &entry : PALETTE_CELL_MAP)
-    {
-        if (entry.name && std::string(entry.name) == name)
-            return entry.col;
-    }
-    return 0;
+    return palette < PaletteId::COUNT ? PALETTE_CELL_MAP[static_cast<int>(palette)].col : 0;
 }
 
-int get_palette_cell_row(const char *name)
+int get_palette_cell_row(PaletteId palette)
 {
-    for (const auto &entry : PALETTE_CELL_MAP)
-    {
-        if (entry.name && std::string(entry.name) == name)
-            return entry.row;
-    }
-    return 0;
+    return palette < PaletteId::COUNT ? PALETTE_CELL_MAP[static_cast<int>(palette)].row : 0;
 }
 
-void get_sprite_pixel_coords(const std::string &palette_name, int local_col, int local_row, int &px, int &py)
+void get_sprite_pixel_coords(PaletteId palette, int local_col, int local_row, int &px, int &py)
 {
-    int cell_col = get_palette_cell_col(palette_name.c_str());
-    int cell_row = get_palette_cell_row(palette_name.c_str());
+    int cell_col = get_palette_cell_col(palette);
+    int cell_row = get_palette_cell_row(palette);
 
     // Sprite sheet layout constants (must match playground.cpp)
     const int SPRITE_W = 16, SPRITE_H = 16;
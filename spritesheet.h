@@ -1,7 +1,9 @@
 #pragma once
 #include "splashkit.h"
 #include "direction.h"
+#include "palette.h"
 #include <string>
+#include <cstdint>
 #include <optional>
 #include <iostream>
 #include <map>
@@ -15,9 +17,11 @@ public:
     // tile_border: border between tiles and sprites (px, vertical only)
     SpriteSheet(const std::string &bitmap_name, const std::string &file_path, int frame_w, int frame_h,
                 int border_v = 4, int border_h = 3, int sprite_border = 1, int tile_border = 2);
-    // Draw using palette name and local coordinates
+    // Draw using palette id and local coordinates
     // If trim is true, draw a (frame_w-1) x (frame_h-1) portion (removes rightmost column and bottom row)
-    void draw_sprite_at_pixel(const std::string &palette_name, int local_col, int local_row, double x, double y, double scale = 1.0, bool flip_x = false, bool flip_y = false, bool trim = false);
+    // options carries the destination (option_to_bitmap) when not drawing to the current target
+    void draw_sprite_at_pixel(PaletteId palette, int local_col, int local_row, double x, double y, double scale = 1.0, bool flip_x = false, bool flip_y = false, bool trim = false,
+                              const drawing_options &options = option_defaults());
     int frame_width() const { return _frame_w; }
     int frame_height() const { return _frame_h; }
 
@@ -34,7 +38,7 @@ private:
     // and then drawing a trimmed 15x15 portion from it. This block is
     // guarded because some SplashKit builds do not expose render-target
     // APIs; define SPLASHKIT_RENDER_TARGETS when your build supports them.
-    bitmap _temp16;
+    bitmap _temp16 = nullptr;
     void ensure_temp_bitmap();
 #endif
 };
@@ -52,7 +56,7 @@ constexpr int TRIM_NUDGE_FLIPPED_Y = 5;
 
 // ...existing code...
 
-// Palette cell color mapping (single definition, correct order)
+// Palette cell color mapping (single definition, correct order, indexed by PaletteId)
 struct PaletteCellInfo
 {
     int row, col;
@@ -81,26 +85,10 @@ constexpr PaletteCellInfo PALETTE_CELL_MAP[] = {
     {2, 4, "TAN_GREEN_ORANGE"},
     {3, 4, nullptr}};
 
-constexpr const char *PACMAN_PALETTE_NAME = "YELLOW_PINK_SKY";
+static_assert(sizeof(PALETTE_CELL_MAP) / sizeof(PALETTE_CELL_MAP[0]) == static_cast<int>(PaletteId::COUNT) + 1,
+              "PaletteId must list every PALETTE_CELL_MAP entry in order");
 
-// Ghost sprite coordinates (col, row) in the spritesheet
-namespace GhostSprites
-{
-    // Scared ghost sprites (when Pac-Man has power pellet)
-    constexpr int SCARED_1_COL = 5, SCARED_1_ROW = 0;
-    constexpr int SCARED_2_COL = 5, SCARED_2_ROW = 1;
-
-    // Directional ghost sprites with animation frames
-    constexpr int RIGHT_1_COL = 0, RIGHT_1_ROW = 0;
-    constexpr int RIGHT_2_COL = 1, RIGHT_2_ROW = 0;
-    constexpr int DOWN_1_COL = 2, DOWN_1_ROW = 0;
-    constexpr int DOWN_2_COL = 3, DOWN_2_ROW = 0;
-    constexpr int LEFT_1_COL = 4, LEFT_1_ROW = 0;
-    constexpr int LEFT_2_COL = 5, LEFT_2_ROW = 0;
-    constexpr int UP_1_COL = 6, UP_1_ROW = 0;
-    constexpr int UP_2_COL = 7, UP_2_ROW = 0;
-}
 // Sprite utility function declarations (implemented in spritesheet.cpp)
-int get_palette_cell_col(const char *name);
-int get_palette_cell_row(const char *name);
-void get_sprite_pixel_coords(const std::string &palette_name, int local_col, int local_row, int &px, int &py);
+int get_palette_cell_col(PaletteId palette);
+int get_palette_cell_row(PaletteId palette);
+void get_sprite_pixel_coords(PaletteId palette, int local_col, int local_row, int &px, int &py);
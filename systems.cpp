@@ -0,0 +1,927 @@
+#include "systems.h"
+#include "sprite_frames.h"
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @file systems.cpp
+ * @brief Implementation of the entity systems
+ */
+
+using namespace MazeConfig;
+using namespace EntityConfig;
+
+namespace
+{
+    constexpr direction_t ALL_DIRS[] = {DIR_RIGHT, DIR_LEFT, DIR_DOWN, DIR_UP};
+
+    direction_t get_opposite_direction(direction_t dir)
+    {
+        switch (dir)
+        {
+        case DIR_LEFT:
+            return DIR_RIGHT;
+        case DIR_RIGHT:
+            return DIR_LEFT;
+        case DIR_UP:
+            return DIR_DOWN;
+        case DIR_DOWN:
+            return DIR_UP;
+        default:
+            return DIR_NONE;
+        }
+    }
+
+    void get_next_cell(direction_t direction, int &row, int &col)
+    {
+        switch (direction)
+        {
+        case DIR_LEFT:
+            col--;
+            break;
+        case DIR_RIGHT:
+            col++;
+            break;
+        case DIR_UP:
+            row--;
+            break;
+        case DIR_DOWN:
+            row++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    double current_speed(const Movement &movement)
+    {
+        return MazeConfig::SPEED * movement.speed_multiplier * movement.speed_boost;
+    }
+
+    // ============== Movement Helpers ==============
+
+    bool is_aligned_for_direction(const Transform &transform, direction_t direction, double center_x, double center_y)
+    {
+        switch (direction)
+        {
+        case DIR_LEFT:
+        case DIR_RIGHT:
+            return fabs(transform.y - center_y) < ALIGNMENT_TOLERANCE;
+        case DIR_UP:
+        case DIR_DOWN:
+            return fabs(transform.x - center_x) < ALIGNMENT_TOLERANCE;
+        default:
+            return false;
+        }
+    }
+
+    void align_to_grid(Transform &transform, direction_t direction, double center_x, double center_y)
+    {
+        switch (direction)
+        {
+        case DIR_LEFT:
+        case DIR_RIGHT:
+            transform.y = center_y;
+            break;
+        case DIR_UP:
+        case DIR_DOWN:
+            transform.x = center_x;
+            break;
+        default:
+            break;
+        }
+    }
+
+    /**
+     * @brief Take a pending turn at the next cell centre the entity crosses within distance
+     * The crossing point is found analytically rather than by waiting for a
+     * tick to land inside ALIGNMENT_TOLERANCE, so fast entities and long
+     * ticks cannot step over it. On a turn the entity is placed on the centre
+     * and distance is reduced by the length already travelled.
+     * @return true if the entity turned
+     */
+    bool turn_at_next_crossing(Transform &transform, Movement &movement, const Maze &maze,
+                               double &center_x, double &center_y, double &distance)
+    {
+        // Only a turn onto the other axis needs a crossing; reversals are taken immediately
+        const bool horizontal = (movement.dir == DIR_LEFT || movement.dir == DIR_RIGHT);
+        const bool turn_horizontal = (movement.desired_dir == DIR_LEFT || movement.desired_dir == DIR_RIGHT);
+        if (movement.dir == DIR_NONE || horizontal == turn_horizontal)
+            return false;
+
+        // The cell centre ahead: this cell's if not yet reached, otherwise the next one's
+        int row = static_cast<int>(transform.y / CELL_SIZE);
+        int col = static_cast<int>(transform.x / CELL_SIZE);
+        double to_center = 0.0;
+        switch (movement.dir)
+        {
+        case DIR_RIGHT:
+            if (transform.x > center_x)
+                col++;
+            to_center = Maze::get_cell_center_x(col) - transform.x;
+            break;
+        case DIR_LEFT:
+            if (transform.x < center_x)
+                col--;
+            to_center = transform.x - Maze::get_cell_center_x(col);
+            break;
+        case DIR_DOWN:
+            if (transform.y > center_y)
+                row++;
+            to_center = Maze::get_cell_center_y(row) - transform.y;
+            break;
+        case DIR_UP:
+            if (transform.y < center_y)
+                row--;
+            to_center = transform.y - Maze::get_cell_center_y(row);
+            break;
+        default:
+            return false;
+        }
+
+        if (to_center > distance)
+            return false;
+
+        const double cross_x = Maze::get_cell_center_x(col);
+        const double cross_y = Maze::get_cell_center_y(row);
+        const double off_line = horizontal ? fabs(transform.y - cross_y) : fabs(transform.x - cross_x);
+        if (off_line >= ALIGNMENT_TOLERANCE)
+            return false;
+
+        int next_row = row;
+        int next_col = col;
+        get_next_cell(movement.desired_dir, next_row, next_col);
+        if (!maze.is_empty(next_row, next_col))
+            return false;
+
+        transform.x = cross_x;
+        transform.y = cross_y;
+        center_x = cross_x;
+        center_y = cross_y;
+        movement.dir = movement.desired_dir;
+        movement.turn_deadline = 0;
+        distance -= to_center;
+        return true;
+    }
+
+    void attempt_movement(Transform &transform, Movement &movement, const Maze &maze,
+                          double center_x, double center_y, double distance)
+    {
+        if (movement.dir == DIR_NONE)
+            return;
+
+        double test_x = transform.x;
+        double test_y = transform.y;
+
+        switch (movement.dir)
+        {
+        case DIR_LEFT:
+            test_x -= distance;
+            break;
+        case DIR_RIGHT:
+            test_x += distance;
+            break;
+        case DIR_UP:
+            test_y -= distance;
+            break;
+        case DIR_DOWN:
+            test_y += distance;
+            break;
+        default:
+            break;
+        }
+
+        if (maze.can_move_to(test_x, test_y))
+        {
+            transform.x = test_x;
+            transform.y = test_y;
+            snap_to_grid_if_close(transform, movement, center_x, center_y);
+        }
+        else
+        {
+            movement.dir = DIR_NONE; // Stop if can't move
+        }
+    }
+
+    void handle_tunnel_wrapping(Transform &transform, const Maze &maze)
+    {
+        const int row = static_cast<int>(floor(transform.y / CELL_SIZE));
+        const int col = static_cast<int>(floor(transform.x / CELL_SIZE));
+
+        // Wrap from left edge to right edge
+        if (col < 0)
+        {
+            transform.x = (row >= 0 && row < MAZE_ROWS && maze.is_empty(row, MAZE_COLS - 1)) ? Maze::get_cell_center_x(MAZE_COLS - 1) : Maze::get_cell_center_x(0);
+        }
+        // Wrap from right edge to left edge
+        else if (col >= MAZE_COLS)
+        {
+            transform.x = (row >= 0 && row < MAZE_ROWS && maze.is_empty(row, 0)) ? Maze::get_cell_center_x(0) : Maze::get_cell_center_x(MAZE_COLS - 1);
+        }
+    }
+
+    // ============== Ghost AI Helpers ==============
+
+    std::pair<double, double> get_non_portal_distance(const Transform &transform, double target_x, double target_y)
+    {
+        // Calculate direct distance without considering portal wrapping
+        double dx = target_x - transform.x;
+        double dy = target_y - transform.y;
+
+        // If the horizontal distance is more than half the maze width,
+        // it likely means we're considering a portal route - ignore it by using the direct route
+        const double maze_width = MAZE_COLS * CELL_SIZE;
+        if (std::abs(dx) > maze_width / 2)
+        {
+            // Force direct non-portal path by clamping the distance calculation
+            if (dx > 0)
+                dx = maze_width - dx; // Go the long way around
+            else
+                dx = -(maze_width + dx); // Go the long way around
+        }
+
+        return {dx, dy};
+    }
+
+    void choose_direction_by_offset(const Transform &transform, Movement &movement, const Maze &maze,
+                                    double dx, double dy, bool allow_any_direction)
+    {
+        const direction_t opposite_dir = get_opposite_direction(movement.dir);
+
+        // Potential directions to try, prioritized by distance to target
+        std::pair<direction_t, double> directions[2];
+        int count = 0;
+
+        // At most one horizontal and one vertical direction gets us closer
+        if (dx != 0)
+            directions[count++] = {dx > 0 ? DIR_RIGHT : DIR_LEFT, std::abs(dx)};
+        if (dy != 0)
+            directions[count++] = {dy > 0 ? DIR_DOWN : DIR_UP, std::abs(dy)};
+
+        // Larger distance difference = higher priority
+        if (count == 2 && directions[1].second > directions[0].second)
+            std::swap(directions[0], directions[1]);
+
+        // Try directions in order of priority, but avoid going backward unless necessary
+        for (int i = 0; i < count; i++)
+        {
+            if (directions[i].first != opposite_dir && can_move_in_direction(transform, maze, directions[i].first))
+            {
+                movement.desired_dir = directions[i].first;
+                return;
+            }
+        }
+
+        // If no forward direction works, try any valid direction (including backward)
+        for (int i = 0; i < count; i++)
+        {
+            if (can_move_in_direction(transform, maze, directions[i].first))
+            {
+                movement.desired_dir = directions[i].first;
+                return;
+            }
+        }
+
+        if (!allow_any_direction)
+            return;
+
+        // Last resort: try any direction that's not a wall
+        for (direction_t dir : ALL_DIRS)
+        {
+            if (can_move_in_direction(transform, maze, dir))
+            {
+                movement.desired_dir = dir;
+                return;
+            }
+        }
+    }
+
+    bool is_at_intersection(const Transform &transform, const Movement &movement, const Maze &maze)
+    {
+        // Check if ghost is approximately centered in a cell
+        const double cell_center_x = Maze::get_cell_center_x(static_cast<int>(transform.x / CELL_SIZE));
+        const double cell_center_y = Maze::get_cell_center_y(static_cast<int>(transform.y / CELL_SIZE));
+        const double dx = std::abs(transform.x - cell_center_x);
+        const double dy = std::abs(transform.y - cell_center_y);
+
+        // Only consider it at intersection if close to cell center
+        if (dx > 3.0 || dy > 3.0)
+        {
+            return false;
+        }
+
+        // Count how many directions are available (excluding the opposite of current direction)
+        const direction_t opposite = get_opposite_direction(movement.dir);
+        int available_directions = 0;
+
+        for (direction_t dir : ALL_DIRS)
+        {
+            if (dir != opposite && can_move_in_direction(transform, maze, dir))
+            {
+                available_directions++;
+            }
+        }
+
+        // It's an intersection if there are 2+ directions available (not counting backward)
+        return available_directions >= 2;
+    }
+
+    bool should_recalculate_direction(const Transform &transform, const Movement &movement, const Maze &maze)
+    {
+        // Always recalculate if not moving or can't continue in current direction
+        if (movement.dir == DIR_NONE || !can_move_in_direction(transform, maze, movement.dir))
+        {
+            return true;
+        }
+
+        // Otherwise, only recalculate at intersections
+        return is_at_intersection(transform, movement, maze);
+    }
+
+    void restart_random_dir_timer(World &world, EntityId id)
+    {
+        AIState &ai = world.ai_state(id);
+        TimerWheel &timers = world.timers();
+
+        ai.random_dir_change_due = false;
+        timers.cancel(ai.random_dir_timer);
+        ai.random_dir_timer = timers.schedule(TimerWheel::seconds_to_ticks(world.tuning().random_dir_change_time), [&world, id]()
+                                              { world.ai_state(id).random_dir_change_due = true; });
+    }
+
+    void choose_direction_random_patrol(World &world, EntityId id, const Maze &maze)
+    {
+        const Transform &transform = world.transform(id);
+        Movement &movement = world.movement(id);
+        AIState &ai = world.ai_state(id);
+        const direction_t opposite_dir = get_opposite_direction(movement.dir);
+
+        // Change direction periodically or if stuck
+        if (ai.random_dir_change_due || movement.dir == DIR_NONE || !can_move_in_direction(transform, maze, movement.dir))
+        {
+            restart_random_dir_timer(world, id);
+
+            // Try to find a new valid random direction (not backward)
+            direction_t valid_dirs[4];
+            int valid_count = 0;
+
+            for (direction_t dir : ALL_DIRS)
+            {
+                if (dir != opposite_dir && can_move_in_direction(transform, maze, dir))
+                {
+                    valid_dirs[valid_count++] = dir;
+                }
+            }
+
+            // If no forward directions available, allow backward
+            if (valid_count == 0)
+            {
+                for (direction_t dir : ALL_DIRS)
+                {
+                    if (can_move_in_direction(transform, maze, dir))
+                    {
+                        valid_dirs[valid_count++] = dir;
+                    }
+                }
+            }
+
+            // Pick a random direction from valid options
+            if (valid_count > 0)
+            {
+                ai.random_target_dir = valid_dirs[world.random().next() % valid_count];
+            }
+        }
+
+        // Set the current random direction
+        movement.desired_dir = ai.random_target_dir;
+    }
+
+    void choose_direction_ambush(const Transform &transform, Movement &movement, const AIState &ai,
+                                 const Maze &maze, direction_t pacman_dir, double ambush_distance)
+    {
+        // Calculate position ahead of Pacman based on their direction
+        double ambush_x = ai.target_x;
+        double ambush_y = ai.target_y;
+
+        // Project ahead by ambush_distance pixels in Pacman's direction
+        switch (pacman_dir)
+        {
+        case DIR_RIGHT:
+            ambush_x += ambush_distance;
+            break;
+        case DIR_LEFT:
+            ambush_x -= ambush_distance;
+            break;
+        case DIR_DOWN:
+            ambush_y += ambush_distance;
+            break;
+        case DIR_UP:
+            ambush_y -= ambush_distance;
+            break;
+        case DIR_NONE:
+            // If Pacman isn't moving, just target their current position
+            break;
+        }
+
+        // Use standard pathfinding to reach ambush point
+        choose_direction_towards_target(transform, movement, maze, ambush_x, ambush_y);
+    }
+
+    void choose_direction_away_from_target(const Transform &transform, Movement &movement, AIState &ai, const Maze &maze)
+    {
+        // Find the best escape position (furthest from Pac-Man)
+        find_escape_target(transform, ai, maze);
+
+        // Now use the same pathfinding logic as chasing, but towards the escape target
+        const double dx = ai.escape_target_x - transform.x;
+        const double dy = ai.escape_target_y - transform.y;
+        choose_direction_by_offset(transform, movement, maze, dx, dy, false);
+    }
+
+    void move_towards_home(World &world, EntityId id, double delta_time)
+    {
+        Transform &transform = world.transform(id);
+        Movement &movement = world.movement(id);
+        AIState &ai = world.ai_state(id);
+
+        const double dx = ai.home_x - transform.x;
+        const double dy = ai.home_y - transform.y;
+        const double distance = sqrt(dx * dx + dy * dy);
+
+        // If we're very close to home, snap to center and enter cooldown mode
+        if (distance < 5.0)
+        {
+            transform.x = ai.home_x;
+            transform.y = ai.home_y;
+            ai.state = GhostState::COOLDOWN;
+
+            TimerWheel &timers = world.timers();
+            timers.cancel(ai.cooldown_timer);
+            ai.cooldown_timer = timers.schedule(TimerWheel::seconds_to_ticks(world.tuning().cooldown_duration), [&world, id]()
+                                                { world.ai_state(id).state = GhostState::CHASING; });
+            return;
+        }
+
+        // Move directly towards home (caught ghosts can move through walls)
+        const double move_distance = current_speed(movement) * delta_time;
+
+        // Update position directly (no collision detection - ghosts can pass through walls when caught)
+        transform.x += (dx / distance) * move_distance;
+        transform.y += (dy / distance) * move_distance;
+
+        // Set sprite direction based on movement direction for visual feedback
+        if (std::abs(dx) > std::abs(dy))
+        {
+            movement.dir = dx > 0 ? DIR_RIGHT : DIR_LEFT;
+        }
+        else
+        {
+            movement.dir = dy > 0 ? DIR_DOWN : DIR_UP;
+        }
+        movement.desired_dir = movement.dir;
+    }
+
+    // ============== Rendering Helpers ==============
+
+    PaletteId ghost_palette(const World &world, EntityId id)
+    {
+        const AIState &ai = world.ai_state(id);
+        const TimerWheel &timers = world.timers();
+
+        if (ai.state == GhostState::CAUGHT || ai.state == GhostState::COOLDOWN)
+        {
+            // Use black/blue/white palette when caught, returning home, or cooling down
+            return PaletteId::BLACK_BLUE_WHITE;
+        }
+
+        if (ai.state == GhostState::SCARED)
+        {
+            const double time_remaining = static_cast<double>(timers.remaining(ai.scared_timer)) / TimerConfig::TICKS_PER_SECOND;
+
+            // Flash when less than 3 seconds remaining
+            if (time_remaining <= WARNING_TIME)
+            {
+                // Flash with 50% duty cycle every 0.33 seconds (3 times per second)
+                // 0.167 seconds normal, 0.167 seconds flashing = 50% duty cycle
+                const double game_time = static_cast<double>(timers.now()) / TimerConfig::TICKS_PER_SECOND;
+                if (fmod(game_time, 0.33) >= 0.167)
+                {
+                    return PaletteId::RED_WHITE_GREEN;
+                }
+            }
+        }
+
+        return world.sprite(id).palette;
+    }
+
+    bool is_clear_of_movers(const World &world, double x, double y)
+    {
+        for (EntityId id = 0; id < world.size(); id++)
+        {
+            if (!world.has(id, Component::TRANSFORM | Component::MOVEMENT))
+                continue;
+
+            const double dx = x - world.transform(id).x;
+            const double dy = y - world.transform(id).y;
+            if (dx * dx + dy * dy < SPAWN_CLEARANCE * SPAWN_CLEARANCE)
+                return false;
+        }
+        return true;
+    }
+
+    void spawn_bonus(World &world, EntityId id, const Maze &maze)
+    {
+        Bonus &bonus = world.bonus(id);
+        Sprite &sprite = world.sprite(id);
+        Transform &transform = world.transform(id);
+
+        // Pick a random fruit type (0-3); plain modulo keeps the choice the same with every standard library
+        GameRandom &random = world.random();
+        sprite.variant = static_cast<int>(random.next() % 4);
+
+        // Candidate cells are precomputed by the maze
+        const auto &cells = maze.get_walkable_cells();
+        if (cells.empty())
+        {
+            schedule_bonus_spawn(world, id);
+            return;
+        }
+
+        // Try a few random cells away from the moving entities; if they are all
+        // too close (tiny maze or crowded area) take the last one anyway
+        std::pair<int, int> cell = cells[random.next() % cells.size()];
+        for (int attempt = 1; attempt < SPAWN_ATTEMPTS; attempt++)
+        {
+            if (is_clear_of_movers(world, Maze::get_cell_center_x(cell.second), Maze::get_cell_center_y(cell.first)))
+                break;
+            cell = cells[random.next() % cells.size()];
+        }
+
+        // Set fruit position to cell center
+        transform.x = Maze::get_cell_center_x(cell.second);
+        transform.y = Maze::get_cell_center_y(cell.first);
+
+        bonus.active = true;
+        sprite.visible = true;
+
+        // Fruit disappears after visible duration, then the spawn timer restarts
+        bonus.visible_timer = world.timers().schedule(TimerWheel::seconds_to_ticks(BONUS_VISIBLE_DURATION), [&world, id]()
+                                                      {
+                                                          world.bonus(id).active = false;
+                                                          world.sprite(id).visible = false;
+                                                          schedule_bonus_spawn(world, id);
+                                                      });
+    }
+}
+
+// ============== Systems ==============
+
+void ghost_ai_system(World &world, const Maze &maze, double pacman_x, double pacman_y, direction_t pacman_dir,
+                     double delta_time)
+{
+    constexpr std::uint32_t required = Component::TRANSFORM | Component::MOVEMENT | Component::AI_STATE;
+    const GhostTuning &tuning = world.tuning();
+
+    for (EntityId id = 0; id < world.size(); id++)
+    {
+        if (!world.has(id, required))
+            continue;
+
+        Transform &transform = world.transform(id);
+        Movement &movement = world.movement(id);
+        AIState &ai = world.ai_state(id);
+
+        ai.target_x = pacman_x;
+        ai.target_y = pacman_y;
+
+        // Caught and cooling-down ghosts leave the grid; caught ones move faster
+        movement.on_grid = (ai.state == GhostState::CHASING || ai.state == GhostState::SCARED);
+        movement.speed_boost = (ai.state == GhostState::CAUGHT) ? CAUGHT_SPEED_BOOST : 1.0;
+
+        // Choose movement based on current state and AI type
+        switch (ai.state)
+        {
+        case GhostState::CHASING:
+        {
+            // Only recalculate direction at intersections or when blocked
+            if (!should_recalculate_direction(transform, movement, maze))
+                break;
+
+            const double distance_to_pacman = sqrt(pow(ai.target_x - transform.x, 2) + pow(ai.target_y - transform.y, 2));
+
+            if (distance_to_pacman < tuning.lock_on_distance)
+            {
+                // Close enough - lock on and chase
+                choose_direction_towards_target(transform, movement, maze, ai.target_x, ai.target_y);
+            }
+            else if (ai.type == GhostAIType::RANDOM_PATROL)
+            {
+                // Too far - wander randomly
+                choose_direction_random_patrol(world, id, maze);
+            }
+            else if (ai.type == GhostAIType::AMBUSHER)
+            {
+                // Too far - aim ahead of Pacman
+                choose_direction_ambush(transform, movement, ai, maze, pacman_dir, tuning.ambush_distance);
+            }
+            break;
+        }
+        case GhostState::SCARED:
+        {
+            // Only recalculate direction at intersections or when blocked
+            if (!should_recalculate_direction(transform, movement, maze))
+                break;
+
+            // Calculate distance to Pacman for smart fleeing behavior
+            const double distance_to_pacman = sqrt(pow(ai.target_x - transform.x, 2) + pow(ai.target_y - transform.y, 2));
+
+            if (distance_to_pacman < tuning.escape_distance)
+            {
+                // Close to Pacman - flee directly away
+                choose_direction_away_from_target(transform, movement, ai, maze);
+            }
+            else
+            {
+                // Far from Pacman - move randomly
+                choose_direction_random_patrol(world, id, maze);
+            }
+            break;
+        }
+        case GhostState::CAUGHT:
+            // No collision detection - caught ghosts can pass through walls
+            move_towards_home(world, id, delta_time);
+            break;
+        case GhostState::COOLDOWN:
+            // Stay at home until cooldown_timer fires
+            break;
+        }
+    }
+}
+
+void movement_system(World &world, const Maze &maze, double delta_time)
+{
+    constexpr std::uint32_t required = Component::TRANSFORM | Component::MOVEMENT;
+
+    for (EntityId id = 0; id < world.size(); id++)
+    {
+        if (!world.has(id, required))
+            continue;
+
+        Transform &transform = world.transform(id);
+        Movement &movement = world.movement(id);
+        if (!movement.on_grid)
+            continue;
+
+        const int col = static_cast<int>(transform.x / CELL_SIZE);
+        const int row = static_cast<int>(transform.y / CELL_SIZE);
+        double center_x = Maze::get_cell_center_x(col);
+        double center_y = Maze::get_cell_center_y(row);
+
+        // A released pre-turn that has not been taken in time is dropped
+        if (movement.turn_deadline != 0 && world.timers().now() > movement.turn_deadline)
+        {
+            movement.desired_dir = DIR_NONE;
+            movement.turn_deadline = 0;
+        }
+
+        // Try to change direction if desired direction differs from current
+        if (movement.desired_dir != DIR_NONE && movement.desired_dir != movement.dir)
+        {
+            attempt_direction_change(transform, movement, maze, row, col, center_x, center_y);
+        }
+
+        // Move in current direction, turning exactly at a cell centre crossed on the way
+        double distance = current_speed(movement) * delta_time; // pixels per second * seconds = pixels
+        if (movement.desired_dir != DIR_NONE && movement.desired_dir != movement.dir)
+        {
+            turn_at_next_crossing(transform, movement, maze, center_x, center_y, distance);
+        }
+        attempt_movement(transform, movement, maze, center_x, center_y, distance);
+
+        // A chasing ghost stalled right next to Pac-Man steps straight at them
+        if (world.has(id, Component::AI_STATE) && movement.dir == DIR_NONE)
+        {
+            const AIState &ai = world.ai_state(id);
+            const double dx = ai.target_x - transform.x;
+            const double dy = ai.target_y - transform.y;
+
+            if (ai.state == GhostState::CHASING && sqrt(dx * dx + dy * dy) < FORCE_MOVE_DISTANCE)
+            {
+                const double distance = current_speed(movement) * delta_time;
+                if (std::abs(dx) > std::abs(dy) && std::abs(dx) > 1.0)
+                {
+                    transform.x += dx > 0 ? distance : -distance;
+                }
+                else if (std::abs(dy) > 1.0)
+                {
+                    transform.y += dy > 0 ? distance : -distance;
+                }
+            }
+        }
+
+        handle_tunnel_wrapping(transform, maze);
+    }
+}
+
+void animation_system(World &world, double delta_time)
+{
+    for (int kind = 0; kind < SpriteFrames::KIND_COUNT; kind++)
+    {
+        const SpriteKindInfo &info = SpriteFrames::KIND_INFO[kind];
+        if (info.frame_count <= 1)
+            continue;
+
+        Animation &clock = world.clock(static_cast<SpriteKind>(kind));
+        clock.timer += delta_time;
+        if (clock.timer > info.frame_duration)
+        {
+            clock.frame = (clock.frame + 1) % info.frame_count;
+            clock.timer = 0.0;
+        }
+    }
+}
+
+void bonus_system(World &world, const Maze &maze)
+{
+    constexpr std::uint32_t required = Component::TRANSFORM | Component::SPRITE | Component::BONUS;
+
+    for (EntityId id = 0; id < world.size(); id++)
+    {
+        // Spawning needs the maze and entity positions, so the timer only flags it
+        if (world.has(id, required) && world.bonus(id).spawn_due)
+        {
+            world.bonus(id).spawn_due = false;
+            spawn_bonus(world, id, maze);
+        }
+    }
+}
+
+void scare_system(World &world)
+{
+    constexpr std::uint32_t required = Component::MOVEMENT | Component::AI_STATE;
+
+    for (EntityId id = 0; id < world.size(); id++)
+    {
+        if (!world.has(id, required) || world.ai_state(id).state == GhostState::CAUGHT)
+            continue;
+
+        start_scared_mode(world, id);
+    }
+}
+
+void snapshot_system(const World &world, RenderSnapshot &snapshot)
+{
+    constexpr std::uint32_t required = Component::TRANSFORM | Component::SPRITE;
+
+    snapshot.sprites.clear();
+    snapshot.popups.clear();
+
+    for (EntityId id = 0; id < world.size(); id++)
+    {
+        if (!world.has(id, required) || !world.sprite(id).visible)
+            continue;
+
+        const Transform &transform = world.transform(id);
+        const Sprite &sprite = world.sprite(id);
+        const int frame = world.has(id, Component::ANIMATION) ? world.clock(sprite.kind).frame : sprite.variant;
+        const direction_t dir = world.has(id, Component::MOVEMENT) ? world.movement(id).dir : DIR_NONE;
+        const bool has_ai = world.has(id, Component::AI_STATE);
+        const SpritePose pose = (has_ai && world.ai_state(id).state == GhostState::SCARED) ? SpritePose::SCARED : SpritePose::NORMAL;
+
+        // Sprite selection is a single table lookup
+        RenderSprite &out = snapshot.sprites.emplace_back();
+        out.x = transform.x;
+        out.y = transform.y;
+        out.palette = has_ai ? ghost_palette(world, id) : sprite.palette;
+        out.frame = SpriteFrames::lookup(sprite.kind, pose, dir, frame);
+        out.scaled = SpriteFrames::KIND_INFO[static_cast<int>(sprite.kind)].scaled;
+    }
+
+    for (EntityId id = 0; id < world.size(); id++)
+    {
+        if (!world.has(id, Component::POPUP) || !world.popup(id).visible)
+            continue;
+
+        const Popup &popup = world.popup(id);
+        snapshot.popups.push_back({popup.x, popup.y, popup.sprite_col, popup.sprite_row});
+    }
+}
+
+// ============== Shared Entity Rules ==============
+
+void schedule_bonus_spawn(World &world, EntityId id)
+{
+    Bonus &bonus = world.bonus(id);
+    TimerWheel &timers = world.timers();
+
+    timers.cancel(bonus.spawn_timer);
+    bonus.spawn_timer = timers.schedule(TimerWheel::seconds_to_ticks(BONUS_SPAWN_INTERVAL), [&world, id]()
+                                        { world.bonus(id).spawn_due = true; });
+}
+
+void start_scared_mode(World &world, EntityId id)
+{
+    AIState &ai = world.ai_state(id);
+    TimerWheel &timers = world.timers();
+
+    ai.state = GhostState::SCARED;
+    // Set actual scared duration inversely to speed multiplier
+    ai.scared_duration = world.tuning().scared_duration / world.movement(id).speed_multiplier;
+
+    // Restart the scared timer; when it fires the ghost resumes chasing
+    timers.cancel(ai.scared_timer);
+    ai.scared_timer = timers.schedule(TimerWheel::seconds_to_ticks(ai.scared_duration), [&world, id]()
+                                      { world.ai_state(id).state = GhostState::CHASING; });
+}
+
+void attempt_direction_change(Transform &transform, Movement &movement, const Maze &maze,
+                              int row, int col, double center_x, double center_y)
+{
+    int next_col = col;
+    int next_row = row;
+
+    get_next_cell(movement.desired_dir, next_row, next_col);
+
+    const bool aligned = is_aligned_for_direction(transform, movement.desired_dir, center_x, center_y);
+
+    if (aligned && maze.is_empty(next_row, next_col))
+    {
+        align_to_grid(transform, movement.desired_dir, center_x, center_y);
+        movement.dir = movement.desired_dir;
+        movement.turn_deadline = 0;
+    }
+}
+
+void snap_to_grid_if_close(Transform &transform, const Movement &movement, double center_x, double center_y)
+{
+    if ((movement.dir == DIR_LEFT || movement.dir == DIR_RIGHT) &&
+        fabs(transform.y - center_y) < ALIGNMENT_TOLERANCE)
+    {
+        transform.y = center_y;
+    }
+
+    if ((movement.dir == DIR_UP || movement.dir == DIR_DOWN) &&
+        fabs(transform.x - center_x) < ALIGNMENT_TOLERANCE)
+    {
+        transform.x = center_x;
+    }
+}
+
+bool can_move_in_direction(const Transform &transform, const Maze &maze, direction_t dir)
+{
+    if (dir == DIR_NONE)
+        return false;
+
+    int next_row = static_cast<int>(transform.y / CELL_SIZE);
+    int next_col = static_cast<int>(transform.x / CELL_SIZE);
+    get_next_cell(dir, next_row, next_col);
+
+    // Use maze's built-in collision detection that handles tunnels
+    return maze.is_empty_or_tunnel(next_row, next_col);
+}
+
+void choose_direction_towards_target(const Transform &transform, Movement &movement, const Maze &maze,
+                                     double target_x, double target_y)
+{
+    // Use non-portal distance calculation for pathfinding
+    const auto [dx, dy] = get_non_portal_distance(transform, target_x, target_y);
+    choose_direction_by_offset(transform, movement, maze, dx, dy, true);
+}
+
+void find_escape_target(const Transform &transform, AIState &ai, const Maze &maze)
+{
+    double max_distance = 0.0;
+    double best_x = transform.x;
+    double best_y = transform.y;
+
+    // Sample positions across the maze to find the furthest valid position
+    const int sample_step = 2; // Check every 2 cells for performance
+    for (int row = 0; row < MAZE_ROWS; row += sample_step)
+    {
+        for (int col = 0; col < MAZE_COLS; col += sample_step)
+        {
+            if (maze.is_empty(row, col))
+            {
+                const double test_x = Maze::get_cell_center_x(col);
+                const double test_y = Maze::get_cell_center_y(row);
+
+                // Calculate distance from this position to the target (Pac-Man)
+                const double dx = ai.target_x - test_x;
+                const double dy = ai.target_y - test_y;
+                const double distance = sqrt(dx * dx + dy * dy);
+
+                if (distance > max_distance)
+                {
+                    max_distance = distance;
+                    best_x = test_x;
+                    best_y = test_y;
+                }
+            }
+        }
+    }
+
+    ai.escape_target_x = best_x;
+    ai.escape_target_y = best_y;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "world.h"
+#include "maze.h"
+#include "render_snapshot.h"
+#include "direction.h"
+
+/**
+ * @file systems.h
+ * @brief Systems that update the entities stored in the World and snapshot them for drawing
+ *
+ * Each system is a free function that makes one linear pass over the World,
+ * acting on every entity that owns the components it needs. Game calls them
+ * in a fixed order each frame:
+ *
+ *   ghost_ai_system -> movement_system -> animation_system -> bonus_system
+ *
+ * with scare_system run in between whenever a power pellet is eaten, and
+ * then snapshot_system to publish the result. Nothing here draws: the
+ * simulation builds without SplashKit, and SceneRenderer draws published
+ * snapshots on the render thread.
+ */
+
+/**
+ * Entity behaviour constants
+ */
+namespace EntityConfig
+{
+    constexpr double POWER_SPEED_BOOST = 1.1;  ///< Pac-Man is 10% faster in power mode
+    constexpr double CAUGHT_SPEED_BOOST = 1.5; ///< Caught ghosts return home 50% faster
+
+    // Ghost distances and durations are runtime values: see GhostTuning, read through World::tuning()
+    constexpr double WARNING_TIME = 3.0;         ///< Flash when this many seconds remain
+    constexpr double FORCE_MOVE_DISTANCE = 25.0; ///< Stalled chasers this close step straight at Pac-Man
+    constexpr double GHOST_POPUP_DURATION = 1.0; ///< Seconds the 400-point popup is shown
+
+    constexpr std::uint64_t TURN_BUFFER_TICKS = TimerConfig::TICKS_PER_SECOND / 4; ///< Ticks a released pre-turn stays buffered
+
+    constexpr double BONUS_SPAWN_INTERVAL = 30.0;                 ///< Spawn every 30 seconds
+    constexpr double BONUS_VISIBLE_DURATION = 20.0;               ///< Visible for 20 seconds
+    constexpr double BONUS_POPUP_DURATION = 1.0;                  ///< Seconds the 200-point popup is shown
+    constexpr int BONUS_POINTS = 200;                             ///< Points awarded for a fruit
+    constexpr double BONUS_COLLISION_DISTANCE = 15.0;             ///< Collection distance
+    constexpr double SPAWN_CLEARANCE = 3 * MazeConfig::CELL_SIZE; ///< Keep spawns this far from moving entities
+    constexpr int SPAWN_ATTEMPTS = 8;                             ///< Random cells tried before accepting any cell
+}
+
+// === Systems ===
+
+/**
+ * @brief Choose directions for every ghost and move caught ghosts home
+ * Runs before movement_system so new directions take effect this frame.
+ * @param world Entity storage
+ * @param maze The maze being played
+ * @param pacman_x Pac-Man's x position (pixels)
+ * @param pacman_y Pac-Man's y position (pixels)
+ * @param pacman_dir Pac-Man's current direction (used by the ambusher)
+ * @param delta_time Time elapsed since last update (seconds), for caught ghosts moving home
+ */
+void ghost_ai_system(World &world, const Maze &maze, double pacman_x, double pacman_y, direction_t pacman_dir,
+                     double delta_time);
+
+/**
+ * @brief Move every on-grid entity along the maze and wrap it through tunnels
+ * A pending turn is taken at the exact point the entity crosses a cell
+ * centre during the tick, so turns never depend on the step size.
+ * @param world Entity storage
+ * @param maze The maze being played
+ * @param delta_time Time elapsed since last update (seconds)
+ */
+void movement_system(World &world, const Maze &maze, double delta_time);
+
+/**
+ * @brief Advance the shared animation clock of every sprite kind
+ * Entities read their kind's clock when drawn, so this costs nothing per entity.
+ * @param world Entity storage
+ * @param delta_time Time elapsed since last update (seconds)
+ */
+void animation_system(World &world, double delta_time);
+
+/**
+ * @brief Spawn bonus items whose spawn timer has fired
+ * Items do not spawn within SPAWN_CLEARANCE of any entity that moves.
+ * @param world Entity storage
+ * @param maze The maze being played
+ */
+void bonus_system(World &world, const Maze &maze);
+
+/**
+ * @brief Put every ghost that has not been caught into scared mode
+ * Called once per power pellet pickup; restarts each scared ghost's timer.
+ * @param world Entity storage
+ */
+void scare_system(World &world);
+
+/**
+ * @brief Record every visible sprite and popup into a render snapshot
+ * Replaces the snapshot's previous sprites and popups.
+ * @param world Entity storage
+ * @param snapshot Snapshot to fill
+ */
+void snapshot_system(const World &world, RenderSnapshot &snapshot);
+
+// === Shared entity rules ===
+
+/**
+ * @brief (Re)start a bonus item's spawn timer
+ */
+void schedule_bonus_spawn(World &world, EntityId id);
+
+/**
+ * @brief Make a ghost scared and (re)start its scared timer, scaled by its speed multiplier
+ */
+void start_scared_mode(World &world, EntityId id);
+
+/**
+ * @brief Turn into the desired direction if aligned with the cell centre and the next cell is open
+ * A successful turn clears the movement's turn deadline.
+ */
+void attempt_direction_change(Transform &transform, Movement &movement, const Maze &maze,
+                              int row, int col, double center_x, double center_y);
+
+/**
+ * @brief Snap onto the cell's centre line when within ALIGNMENT_TOLERANCE of it
+ */
+void snap_to_grid_if_close(Transform &transform, const Movement &movement, double center_x, double center_y);
+
+/**
+ * @brief Check if the cell next to an entity in the given direction is open (tunnels count as open)
+ */
+bool can_move_in_direction(const Transform &transform, const Maze &maze, direction_t dir);
+
+/**
+ * @brief Set the desired direction that best closes the distance to a target
+ * Prefers not to reverse and ignores routes through the side tunnel.
+ */
+void choose_direction_towards_target(const Transform &transform, Movement &movement, const Maze &maze,
+                                     double target_x, double target_y);
+
+/**
+ * @brief Store the sampled open cell furthest from the ghost's target as its escape target
+ */
+void find_escape_target(const Transform &transform, AIState &ai, const Maze &maze);
@@ -0,0 +1,80 @@
+#include "test_framework.h"
+#include "alloc_tracker.h"
+#include "replay.h"
+#include "replay_player.h"
+#include <vector>
+
+/**
+ * @file test_alloc_tracker.cpp
+ * @brief Allocations are charged to their subsystem, and ticks and repeat level loads make none
+ */
+
+TEST(alloc_stats_subtract_per_subsystem)
+{
+    AllocStats earlier;
+    earlier.count[static_cast<int>(AllocTag::MAZE)] = 3;
+    earlier.bytes[static_cast<int>(AllocTag::MAZE)] = 300;
+
+    AllocStats later = earlier;
+    later.count[static_cast<int>(AllocTag::MAZE)] += 2;
+    later.bytes[static_cast<int>(AllocTag::MAZE)] += 64;
+    later.count[static_cast<int>(AllocTag::TIMERS)] = 1;
+    later.bytes[static_cast<int>(AllocTag::TIMERS)] = 16;
+
+    const AllocStats difference = later - earlier;
+    CHECK(difference.count[static_cast<int>(AllocTag::MAZE)] == 2);
+    CHECK(difference.bytes[static_cast<int>(AllocTag::MAZE)] == 64);
+    CHECK(difference.total_count() == 3);
+    CHECK(difference.total_bytes() == 80);
+}
+
+#ifdef PACMAN_ALLOC_TRACKING
+
+TEST(allocations_are_charged_to_the_innermost_scope)
+{
+    const AllocStats before = AllocTracker::snapshot();
+    {
+        AllocScope outer(AllocTag::MAZE);
+        std::vector<int> row(16);
+        {
+            AllocScope inner(AllocTag::BOT);
+            std::vector<int> path(8);
+        }
+        std::vector<int> another_row(16);
+    }
+    const AllocStats made = AllocTracker::snapshot() - before;
+    CHECK(made.count[static_cast<int>(AllocTag::MAZE)] == 2);
+    CHECK(made.bytes[static_cast<int>(AllocTag::MAZE)] == 2 * 16 * sizeof(int));
+    CHECK(made.count[static_cast<int>(AllocTag::BOT)] == 1);
+}
+
+TEST(replayed_ticks_do_not_allocate)
+{
+    Replay replay;
+    CHECK(load_replay("Resources/Replays/level3_hard_1.txt", replay));
+
+    Simulation simulation;
+    ReplayPlayer player(simulation);
+    player.start(replay);
+
+    const AllocStats before = AllocTracker::snapshot();
+    while (player.step())
+    {
+    }
+    CHECK(player.get_tick() > 1000);
+    CHECK((AllocTracker::snapshot() - before).total_count() == 0);
+}
+
+TEST(loading_a_level_seen_before_does_not_allocate)
+{
+    Simulation simulation;
+    simulation.new_game(2, SimulationSettings());
+    simulation.next_level(5);
+
+    const AllocStats before = AllocTracker::snapshot();
+    simulation.next_level(2);
+    simulation.new_game(5, SimulationSettings());
+    CHECK((AllocTracker::snapshot() - before).total_count() == 0);
+}
+
+#endif
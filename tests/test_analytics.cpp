@@ -0,0 +1,99 @@
+#include "test_framework.h"
+#include "analytics.h"
+#include "replay.h"
+#include "replay_player.h"
+#include <filesystem>
+
+/**
+ * @file test_analytics.cpp
+ * @brief Analytics events survive the event file in order, and match the game they were recorded from
+ */
+
+TEST(analytics_events_round_trip_across_chunks)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "pacman_test_events.bin").string();
+    const std::size_t count = AnalyticsConfig::CHUNK_ROWS * 2 + 100;
+    {
+        AnalyticsLog log(path);
+        CHECK(log.is_open());
+        for (std::size_t i = 0; i < count; i++)
+        {
+            AnalyticsEvent event;
+            event.kind = i % 1000 == 0 ? AnalyticsEventKind::GAME_START : AnalyticsEventKind::PELLET;
+            event.tick = static_cast<std::uint32_t>(i);
+            event.level = 3;
+            event.row = static_cast<int>(i % 13);
+            event.col = static_cast<int>(i % 25);
+            event.value = -static_cast<int>(i);
+            log.record(event);
+        }
+        CHECK(log.get_event_count() == count);
+    }
+
+    AnalyticsTable table;
+    CHECK(load_analytics(path, table));
+    std::filesystem::remove(path);
+
+    CHECK(table.size() == count);
+    for (std::size_t i = 0; i < table.size() && i < count; i++)
+    {
+        CHECK(table.game[i] == i / 1000);
+        CHECK(table.tick[i] == i);
+        CHECK(table.level[i] == 3);
+        CHECK(table.row[i] == static_cast<int>(i % 13));
+        CHECK(table.col[i] == static_cast<int>(i % 25));
+        CHECK(table.ghost[i] == -1);
+        CHECK(table.value[i] == -static_cast<int>(i));
+    }
+}
+
+TEST(replayed_game_records_every_pellet_and_how_it_ended)
+{
+    Replay replay;
+    CHECK(load_replay("Resources/Replays/level3_hard_1.txt", replay));
+
+    const std::string path = (std::filesystem::temp_directory_path() / "pacman_test_replay_events.bin").string();
+    Simulation simulation;
+    ReplayPlayer player(simulation);
+    bool caught = false;
+    {
+        AnalyticsLog log(path);
+        simulation.set_analytics(&log);
+        player.start(replay);
+        while (player.step())
+        {
+            caught = caught || player.get_events().pacman_caught;
+        }
+        simulation.set_analytics(nullptr);
+    }
+
+    AnalyticsTable table;
+    CHECK(load_analytics(path, table));
+    std::filesystem::remove(path);
+    CHECK(table.size() > 1);
+    if (table.size() <= 1)
+        return;
+
+    CHECK(table.kind.front() == static_cast<std::uint8_t>(AnalyticsEventKind::GAME_START));
+    CHECK(table.value.front() == static_cast<std::int32_t>(replay.seed));
+
+    // Pellets eaten on the last level played, each in a cell that holds a token
+    int pellets = 0;
+    for (std::size_t i = 0; i < table.size(); i++)
+    {
+        if (table.kind[i] == static_cast<std::uint8_t>(AnalyticsEventKind::LEVEL_START))
+            pellets = 0;
+        if (table.kind[i] != static_cast<std::uint8_t>(AnalyticsEventKind::PELLET))
+            continue;
+        pellets++;
+        CHECK(simulation.get_maze().is_empty(table.row[i], table.col[i]));
+    }
+    CHECK(pellets == simulation.get_game_state().get_tokens_collected());
+
+    // A game that ends with Pac-Man caught ends with his death and the ghost that caught him
+    if (caught)
+    {
+        CHECK(table.kind.back() == static_cast<std::uint8_t>(AnalyticsEventKind::DEATH));
+        CHECK(table.ghost.back() >= 0);
+    }
+}
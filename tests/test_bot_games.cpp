@@ -0,0 +1,118 @@
+#include "test_framework.h"
+#include "bot_games.h"
+
+/**
+ * @file test_bot_games.cpp
+ * @brief Bot game batches give the same results on any number of threads, call their step hook, summarize correctly, and finish
+ */
+
+TEST(bot_batch_results_do_not_depend_on_thread_count)
+{
+    BotBatch batch;
+    batch.level = 3;
+    batch.settings.seed = 500;
+    batch.settings.speed_multiplier = GameConfig::DIFFICULTY_SPEED_MULTIPLIERS[2];
+    batch.games = 6;
+    batch.max_steps = 1800;
+
+    const std::vector<BotGameResult> alone = play_bot_batch(batch, 1);
+    const std::vector<BotGameResult> shared = play_bot_batch(batch, 3);
+    CHECK(alone.size() == 6);
+    CHECK(shared.size() == alone.size());
+    for (std::size_t i = 0; i < alone.size() && i < shared.size(); i++)
+    {
+        CHECK(alone[i].seed == 500 + i);
+        CHECK(shared[i].seed == alone[i].seed);
+        CHECK(shared[i].steps == alone[i].steps);
+        CHECK(shared[i].score == alone[i].score);
+        CHECK(shared[i].outcome == alone[i].outcome);
+        CHECK(alone[i].steps <= batch.max_steps);
+    }
+}
+
+TEST(bot_batch_step_hook_sees_every_step_on_its_own_worker)
+{
+    BotBatch batch;
+    batch.level = 1;
+    batch.settings.seed = 40;
+    batch.games = 5;
+    batch.max_steps = 1200;
+
+    // Each worker counts into its own slot, as danger_sweep's maps do
+    const int workers = bot_batch_workers(batch, 3);
+    CHECK(workers == 3);
+    std::vector<std::uint64_t> worker_steps(workers);
+    const std::vector<BotGameResult> results =
+        play_bot_batch(batch, 3, [&worker_steps](int worker, const Simulation &, const StepEvents &)
+                       { worker_steps[worker]++; });
+
+    std::uint64_t hooked = 0;
+    for (std::uint64_t steps : worker_steps)
+        hooked += steps;
+    std::uint64_t played = 0;
+    for (const BotGameResult &result : results)
+        played += result.steps;
+    CHECK(hooked == played);
+    CHECK(bot_batch_workers(batch, 8) == batch.games);
+}
+
+TEST(bot_batch_summary_rates_and_survival)
+{
+    std::vector<BotGameResult> results(4);
+    results[0].outcome = BotGameOutcome::CLEARED;
+    results[0].steps = 600;
+    results[0].score = 1000;
+    results[1].outcome = BotGameOutcome::CAUGHT;
+    results[1].steps = 120;
+    results[2].outcome = BotGameOutcome::CAUGHT;
+    results[2].steps = 240;
+    results[2].score = 200;
+    results[3].steps = 240;
+
+    const BotBatchSummary summary = summarize_bot_batch(results);
+    CHECK(summary.games == 4);
+    CHECK(summary.clear_rate == 0.25);
+    CHECK(summary.caught_rate == 0.5);
+    CHECK(summary.timed_out_rate == 0.25);
+    CHECK(summary.mean_score == 300.0);
+    CHECK(summary.mean_seconds == 5.0);
+    CHECK(summary.survival_p10 == 2.0);
+    CHECK(summary.survival_p90 == 4.0);
+
+    CHECK(summarize_bot_batch({}).games == 0);
+}
+
+TEST(bot_step_limit_stretches_for_slower_games)
+{
+    CHECK(bot_step_limit(100, 1.0) == 100u * GameConfig::SIMULATION_RATE);
+    CHECK(bot_step_limit(100, 2.0) == 50u * GameConfig::SIMULATION_RATE);
+    CHECK(bot_step_limit(300, 0.75) == 400u * GameConfig::SIMULATION_RATE);
+}
+
+TEST(bot_does_not_stall_at_a_cell_boundary)
+{
+    // A bot that dithers across a cell boundary turns round on nearly every step until the game is cut off
+    Simulation simulation;
+    PacmanBot bot;
+    SimulationSettings settings;
+    std::uint32_t steps = 0;
+    std::uint32_t reversals = 0;
+    for (std::uint32_t seed = 2100001; seed <= 2100005; seed++)
+    {
+        settings.seed = seed;
+        direction_t last = DIR_NONE;
+        const BotGameResult result =
+            play_bot_game(simulation, bot, 2, settings, 300 * GameConfig::SIMULATION_RATE,
+                          [&last, &reversals](const Simulation &played, const StepEvents &)
+                          {
+                              const direction_t dir = played.get_pacman().get_direction();
+                              if (last != DIR_NONE && dir != DIR_NONE && dir != last &&
+                                  (dir == DIR_LEFT || dir == DIR_RIGHT) == (last == DIR_LEFT || last == DIR_RIGHT))
+                                  reversals++;
+                              last = dir;
+                          });
+        steps += result.steps;
+    }
+    CHECK(steps > 0);
+    CHECK(reversals * 20 < steps);
+}
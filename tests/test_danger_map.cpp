@@ -0,0 +1,76 @@
+#include "test_framework.h"
+#include "danger_map.h"
+#include "simulation.h"
+#include <filesystem>
+
+/**
+ * @file test_danger_map.cpp
+ * @brief Danger maps count the right cells, merge by adding, and survive a CSV round trip
+ */
+
+TEST(danger_map_counts_pacman_and_ghosts_each_step)
+{
+    Simulation simulation;
+    simulation.new_game(1, SimulationSettings());
+
+    DangerMap map;
+    map.record_step(simulation);
+    map.record_death(simulation);
+    map.record_game();
+
+    const Pacman &pacman = simulation.get_pacman();
+    const int row = static_cast<int>(pacman.get_y() / MazeConfig::CELL_SIZE);
+    const int col = static_cast<int>(pacman.get_x() / MazeConfig::CELL_SIZE);
+    CHECK(map.get_layer(DangerLayer::PACMAN_DWELL)[row][col] == 1);
+    CHECK(map.get_layer(DangerLayer::DEATHS)[row][col] == 1);
+
+    // Both ghosts start out chasing
+    std::uint64_t chasing = 0;
+    for (const auto &cells : map.get_layer(DangerLayer::GHOST_CHASING))
+    {
+        for (std::uint64_t count : cells)
+            chasing += count;
+    }
+    CHECK(chasing == 2);
+    CHECK(map.get_steps() == 1);
+    CHECK(map.get_games() == 1);
+}
+
+TEST(merged_danger_maps_add_up)
+{
+    Simulation simulation;
+    simulation.new_game(2, SimulationSettings());
+
+    DangerMap first;
+    DangerMap second;
+    first.record_step(simulation);
+    second.record_step(simulation);
+    second.record_death(simulation);
+
+    first.merge(second);
+    CHECK(first.get_steps() == 2);
+
+    const Pacman &pacman = simulation.get_pacman();
+    const int row = static_cast<int>(pacman.get_y() / MazeConfig::CELL_SIZE);
+    const int col = static_cast<int>(pacman.get_x() / MazeConfig::CELL_SIZE);
+    CHECK(first.get_layer(DangerLayer::PACMAN_DWELL)[row][col] == 2);
+    CHECK(first.get_layer(DangerLayer::DEATHS)[row][col] == 1);
+}
+
+TEST(heat_grid_round_trips_through_csv)
+{
+    HeatGrid grid{};
+    grid[0][0] = 1;
+    grid[6][12] = 123456789012ull;
+    grid[MazeConfig::MAZE_ROWS - 1][MazeConfig::MAZE_COLS - 1] = 7;
+
+    const std::string path = (std::filesystem::temp_directory_path() / "pacman_test_heat.csv").string();
+    CHECK(save_heat_grid(path, grid));
+
+    HeatGrid loaded{};
+    CHECK(load_heat_grid(path, loaded));
+    std::filesystem::remove(path);
+    CHECK(loaded == grid);
+
+    CHECK(!load_heat_grid("Resources/no_such_heatmap.csv", loaded));
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+/**
+ * @file test_framework.h
+ * @brief Minimal self-registering test harness for pacman_tests
+ *
+ * TEST(name) defines a test case that registers itself before main runs;
+ * CHECK(condition) records a failure and carries on with the test. The
+ * harness has no dependencies so the tests build wherever the simulation
+ * does. Tests run from the build directory, where Resources/ is linked.
+ */
+
+/**
+ * @brief Add a test case to the list run by test_main.cpp
+ * @return Always true, so registration can initialise a static
+ */
+bool register_test(const char *name, void (*run)());
+
+/**
+ * @brief Record a failed CHECK in the running test
+ */
+void report_failure(const char *file, int line, const std::string &expression);
+
+#define TEST(name)                                                          \
+    static void name();                                                     \
+    static const bool name##_registered = register_test(#name, name);       \
+    static void name()
+
+#define CHECK(condition)                                                    \
+    do                                                                      \
+    {                                                                       \
+        if (!(condition))                                                   \
+            report_failure(__FILE__, __LINE__, #condition);                 \
+    } while (0)
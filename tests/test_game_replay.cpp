@@ -0,0 +1,44 @@
+#include "test_framework.h"
+#include "game.h"
+#include "headless.h"
+#include "replay_player.h"
+#include <filesystem>
+
+/**
+ * @file test_game_replay.cpp
+ * @brief Game playback (as replay_export uses it) ends where a headless ReplayPlayer does
+ */
+
+TEST(game_playback_matches_replay_player_on_the_corpus)
+{
+    headless_use_virtual_clock(true);
+    Game game;
+    CHECK(game.initialize());
+
+    int played = 0;
+    for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator("Resources/Replays"))
+    {
+        Replay replay;
+        CHECK(load_replay(entry.path().string(), replay));
+
+        Simulation simulation;
+        ReplayPlayer player(simulation);
+        player.start(replay);
+        while (player.step())
+        {
+        }
+
+        game.start_replay(replay);
+        std::uint32_t ticks = 0;
+        while (game.step_replay())
+        {
+            ticks++;
+        }
+
+        CHECK(ticks == player.get_tick());
+        CHECK(game.replay_snapshot().score == simulation.get_game_state().get_score());
+        CHECK(game.get_game_state().get_tokens_collected() == simulation.get_game_state().get_tokens_collected());
+        played++;
+    }
+    CHECK(played > 0);
+}
@@ -0,0 +1,85 @@
+#include "test_framework.h"
+#include "ghost_tuning.h"
+#include "simulation.h"
+#include <filesystem>
+#include <fstream>
+
+/**
+ * @file test_ghost_tuning.cpp
+ * @brief Ghost tunings survive a file round trip, reject bad files, and change how the ghosts behave
+ */
+
+namespace
+{
+    constexpr double STEP = 1.0 / GameConfig::SIMULATION_RATE;
+
+    /**
+     * @brief Whether any ghost is still scared a second and a half after Pac-Man eats a power pellet
+     */
+    bool scared_after_pellet(const GhostTuning &tuning)
+    {
+        SimulationSettings settings;
+        settings.ghost_tuning = tuning;
+        Simulation simulation;
+        simulation.new_game(1, settings);
+
+        const PowerPellet &pellet = simulation.get_game_state().get_power_pellets().front();
+        simulation.get_pacman().set_position(pellet.get_x(), pellet.get_y());
+        for (int i = 0; i < GameConfig::SIMULATION_RATE * 3 / 2; i++)
+            simulation.step(STEP);
+        return simulation.any_ghost_scared();
+    }
+}
+
+TEST(ghost_tuning_file_round_trip)
+{
+    GhostTuning tuning;
+    for (int i = 0; i < GHOST_TUNING_VALUE_COUNT; i++)
+        ghost_tuning_value(tuning, i) = 0.1 + i / 3.0;
+
+    const std::string path = (std::filesystem::temp_directory_path() / "pacman_test_tuning.txt").string();
+    CHECK(save_ghost_tuning(path, tuning));
+
+    GhostTuning loaded;
+    CHECK(load_ghost_tuning(path, loaded));
+    for (int i = 0; i < GHOST_TUNING_VALUE_COUNT; i++)
+        CHECK(ghost_tuning_value(loaded, i) == ghost_tuning_value(tuning, i));
+    CHECK(loaded.speed_multipliers[3] == tuning.speed_multipliers[3]);
+    CHECK(ghost_tuning_value_name(6) == "speed_easy");
+    std::filesystem::remove(path);
+}
+
+TEST(ghost_tuning_file_keeps_missing_values_and_rejects_bad_lines)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "pacman_test_tuning.txt").string();
+    {
+        std::ofstream file(path);
+        file << "# hand-edited\n\nscared_duration 4.5\n";
+    }
+    GhostTuning tuning;
+    CHECK(load_ghost_tuning(path, tuning));
+    CHECK(tuning.scared_duration == 4.5);
+    CHECK(tuning.lock_on_distance == GhostTuning().lock_on_distance);
+
+    {
+        std::ofstream file(path);
+        file << "scared_durration 4.5\n";
+    }
+    CHECK(!load_ghost_tuning(path, tuning));
+    {
+        std::ofstream file(path);
+        file << "cooldown_duration -1\n";
+    }
+    CHECK(!load_ghost_tuning(path, tuning));
+    CHECK(!load_ghost_tuning(path + ".missing", tuning));
+    std::filesystem::remove(path);
+}
+
+TEST(ghost_tuning_sets_how_long_ghosts_stay_scared)
+{
+    CHECK(scared_after_pellet(GhostTuning()));
+
+    GhostTuning short_scare;
+    short_scare.scared_duration = 1.0;
+    CHECK(!scared_after_pellet(short_scare));
+}
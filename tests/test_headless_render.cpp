@@ -0,0 +1,201 @@
+#include "test_framework.h"
+#include "headless.h"
+#include "game_config.h"
+#include "menu.h"
+#include "overlay_compositor.h"
+#include "scene_renderer.h"
+#include "simulation.h"
+#include "spritesheet.h"
+#include "systems.h"
+#include "text_renderer.h"
+#include "bot.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/**
+ * @file test_headless_render.cpp
+ * @brief Known scenes drawn by the headless backend, compared pixel for pixel against golden images
+ *
+ * Goldens live in tests/golden/. After an intended rendering change, rerun
+ * with PACMAN_UPDATE_GOLDENS=1 to rewrite them and review the new images.
+ * A mismatching frame is saved as <name>_actual.png in the working
+ * directory.
+ */
+
+namespace
+{
+    constexpr int SMALL_WIDTH = 96;
+    constexpr int SMALL_HEIGHT = 64;
+
+    /**
+     * @brief Compare the screen with a golden image, or rewrite the golden when asked to
+     */
+    bool matches_golden(const std::string &name)
+    {
+        const std::string path = std::string(PACMAN_GOLDEN_DIR) + "/" + name + ".png";
+        if (std::getenv("PACMAN_UPDATE_GOLDENS") != nullptr)
+        {
+            return save_png(path, headless_screen());
+        }
+
+        Canvas golden;
+        if (!load_png(path, golden))
+        {
+            std::cerr << "Missing golden image " << path << std::endl;
+            return false;
+        }
+
+        const ImageDiff diff = compare_canvases(headless_screen(), golden);
+        if (diff.same_size && diff.differing_pixels == 0)
+        {
+            return true;
+        }
+
+        save_png(name + "_actual.png", headless_screen());
+        std::cerr << name << ": " << diff.differing_pixels << " pixels differ (largest channel delta "
+                  << diff.max_channel_delta << ")" << std::endl;
+        return false;
+    }
+
+    /**
+     * @brief Open a fresh window on the virtual clock, so refresh_screen(fps) never sleeps
+     */
+    void open_test_window(int width, int height)
+    {
+        headless_use_virtual_clock(true);
+        open_window("render test", width, height);
+    }
+}
+
+TEST(headless_primitives_match_golden)
+{
+    open_test_window(SMALL_WIDTH, SMALL_HEIGHT);
+    clear_screen(COLOR_BLACK);
+
+    fill_rectangle(COLOR_BLUE, 4, 4, 40, 24);
+    fill_circle(COLOR_YELLOW, 24, 16, 10);
+    fill_circle(rgba_color(255, 0, 0, 128), 34, 20, 7.5);
+    draw_circle(COLOR_WHITE, 70, 32, 20);
+    fill_rectangle(rgba_color(0, 255, 0, 100), 60, 40, 30, 20);
+
+    CHECK(matches_golden("primitives"));
+}
+
+TEST(headless_part_bitmap_scale_and_flip_match_golden)
+{
+    open_test_window(SMALL_WIDTH, SMALL_HEIGHT);
+    clear_screen(COLOR_BLACK);
+    bitmap sheet = load_bitmap("golden_sheet", GameConfig::SPRITESHEET_PATH);
+    CHECK(sheet != nullptr);
+
+    // The first cell of Pac-Man's palette: as is, scaled about its centre, then mirrored each way
+    int px = 0;
+    int py = 0;
+    get_sprite_pixel_coords(PACMAN_PALETTE, 0, 0, px, py);
+    const drawing_options part = option_part_bmp(px, py, 16, 16);
+    draw_bitmap(sheet, 2, 2, part);
+    draw_bitmap(sheet, 30, 16, option_scale_bmp(2, 2, part));
+    draw_bitmap(sheet, 62, 16, option_flip_x(option_scale_bmp(2, 2, part)));
+    draw_bitmap(sheet, 40, 44, option_flip_y(option_scale_bmp(1.5, 1, part)));
+
+    CHECK(matches_golden("part_bitmap"));
+    free_bitmap(sheet);
+}
+
+TEST(headless_text_matches_golden)
+{
+    open_test_window(SMALL_WIDTH * 2, SMALL_HEIGHT);
+    clear_screen(COLOR_BLACK);
+
+    // The backend's font directly, and through the renderer's glyph atlases
+    draw_text("SCORE 1230", COLOR_WHITE, "arial", 8, 2, 2);
+    draw_text("READY!", COLOR_YELLOW, "arial", 16, 2, 14);
+    TextRenderer text_renderer;
+    text_renderer.draw_text("HIGH SCORES", COLOR_RED, 16, 2, 34);
+    text_renderer.draw_centered_text("~ok~", COLOR_GREEN, 8, SMALL_WIDTH * 2, 54);
+
+    CHECK(matches_golden("text"));
+}
+
+TEST(main_menu_matches_golden)
+{
+    open_test_window(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+    SpriteSheet sprite_sheet(GameConfig::SPRITESHEET_NAME, GameConfig::SPRITESHEET_PATH, 16, 16, 4, 3, 1, 2);
+    TextRenderer text_renderer;
+    Menu menu;
+    menu.set_sprite_sheet(&sprite_sheet);
+    menu.set_text_renderer(&text_renderer);
+
+    // The first render draws the whole screen; with nothing changed the next one leaves it alone
+    const unsigned int frames = headless_frame_count();
+    CHECK(menu.render());
+    CHECK(headless_frame_count() == frames + 1);
+    CHECK(matches_golden("main_menu"));
+    CHECK(!menu.render());
+}
+
+TEST(scene_renderer_matches_golden)
+{
+    open_test_window(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+    SpriteSheet sprite_sheet(GameConfig::SPRITESHEET_NAME, GameConfig::SPRITESHEET_PATH, 16, 16, 4, 3, 1, 2);
+    TextRenderer text_renderer;
+    SceneRenderer scene_renderer(sprite_sheet, text_renderer);
+
+    // Two seconds of a bot game, so the scene has eaten pellets, moved ghosts and a score
+    Simulation simulation;
+    PacmanBot bot;
+    SimulationSettings settings;
+    settings.seed = 7u;
+    simulation.new_game(2, settings);
+    scene_renderer.reset(simulation.get_maze(), simulation.get_game_state());
+    for (int tick = 0; tick < 2 * GameConfig::SIMULATION_RATE; tick++)
+    {
+        bot.steer(simulation);
+        simulation.step(1.0 / GameConfig::SIMULATION_RATE);
+    }
+
+    RenderSnapshot snapshot;
+    snapshot_system(simulation.get_world(), snapshot);
+    GameState &game_state = simulation.get_game_state();
+    game_state.drain_collected_pellets(snapshot.collected_tokens, snapshot.collected_power_pellets);
+    snapshot.score = game_state.get_score();
+    snapshot.tokens_collected = game_state.get_tokens_collected();
+    snapshot.total_tokens = game_state.get_total_tokens();
+    CHECK(!snapshot.collected_tokens.empty());
+
+    scene_renderer.draw(snapshot);
+    CHECK(matches_golden("scene_level2"));
+
+    // Drawn into the overlay cache through option_to_bitmap, the same scene blits back identically
+    OverlayCompositor compositor(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+    clear_screen(COLOR_RED);
+    compositor.capture([&](const drawing_options &options) { scene_renderer.draw(snapshot, options); });
+    CHECK(compositor.present());
+    CHECK(matches_golden("scene_level2"));
+}
+
+TEST(text_layout_cache_keeps_only_recent_strings)
+{
+    open_test_window(SMALL_WIDTH * 2, SMALL_HEIGHT);
+    TextRenderer text_renderer;
+    const int font_size = 16;
+
+    clear_screen(COLOR_BLACK);
+    text_renderer.draw_text("SCORE 0", COLOR_WHITE, font_size, 2, 2);
+    const Canvas first = headless_screen();
+
+    // Many one-off strings fill the cache to its cap and push the first one out
+    for (std::size_t i = 0; i < 3 * TextConfig::LAYOUT_CACHE_SIZE; i++)
+    {
+        text_renderer.draw_text("SCORE " + std::to_string(i + 1), COLOR_WHITE, font_size, 2, 2);
+        CHECK(text_renderer.cached_layout_count(font_size) <= TextConfig::LAYOUT_CACHE_SIZE);
+    }
+    CHECK(text_renderer.cached_layout_count(font_size) == TextConfig::LAYOUT_CACHE_SIZE);
+
+    // An evicted string is laid out again and draws the same pixels
+    clear_screen(COLOR_BLACK);
+    text_renderer.draw_text("SCORE 0", COLOR_WHITE, font_size, 2, 2);
+    const ImageDiff diff = compare_canvases(headless_screen(), first);
+    CHECK(diff.same_size && diff.differing_pixels == 0);
+}
@@ -0,0 +1,39 @@
+#include "test_framework.h"
+#include "input_queue.h"
+
+/**
+ * @file test_input_queue.cpp
+ * @brief Input events are handed over in order, up to each tick's time
+ */
+
+TEST(input_pops_only_events_due_by_tick_time)
+{
+    InputQueue queue;
+    const InputClock::time_point start = InputClock::now();
+    const InputClock::duration ms = std::chrono::milliseconds(1);
+
+    CHECK(queue.push({DIR_LEFT, start}));
+    CHECK(queue.push({DIR_UP, start + 10 * ms}));
+    CHECK(queue.push({DIR_NONE, start + 20 * ms}));
+
+    InputEvent event;
+    CHECK(queue.pop_until(start + 15 * ms, event) && event.dir == DIR_LEFT);
+    CHECK(queue.pop_until(start + 15 * ms, event) && event.dir == DIR_UP);
+    CHECK(!queue.pop_until(start + 15 * ms, event));
+    CHECK(queue.pop_until(start + 20 * ms, event) && event.dir == DIR_NONE);
+}
+
+TEST(input_queue_drops_events_when_full)
+{
+    InputQueue queue;
+    const InputClock::time_point now = InputClock::now();
+    for (std::uint32_t i = 0; i < InputConfig::QUEUE_CAPACITY; i++)
+    {
+        CHECK(queue.push({DIR_RIGHT, now}));
+    }
+    CHECK(!queue.push({DIR_DOWN, now}));
+
+    queue.clear();
+    InputEvent event;
+    CHECK(!queue.pop_until(now, event));
+}
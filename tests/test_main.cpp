@@ -0,0 +1,67 @@
+#include "test_framework.h"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+/**
+ * @file test_main.cpp
+ * @brief Runs every registered test, or those whose name contains the first argument
+ */
+
+namespace
+{
+    struct TestCase
+    {
+        const char *name;
+        void (*run)();
+    };
+
+    std::vector<TestCase> &registry()
+    {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    int current_failures = 0;
+}
+
+bool register_test(const char *name, void (*run)())
+{
+    registry().push_back({name, run});
+    return true;
+}
+
+void report_failure(const char *file, int line, const std::string &expression)
+{
+    std::cerr << file << ":" << line << ": CHECK(" << expression << ") failed" << std::endl;
+    current_failures++;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filter = argc > 1 ? argv[1] : "";
+    int run = 0;
+    int failed = 0;
+
+    for (const TestCase &test : registry())
+    {
+        if (std::strstr(test.name, filter) == nullptr)
+            continue;
+
+        current_failures = 0;
+        test.run();
+        run++;
+        if (current_failures > 0)
+        {
+            failed++;
+            std::cout << "FAIL " << test.name << std::endl;
+        }
+        else
+        {
+            std::cout << "ok   " << test.name << std::endl;
+        }
+    }
+
+    std::cout << run - failed << "/" << run << " tests passed" << std::endl;
+    return failed == 0 && run > 0 ? 0 : 1;
+}
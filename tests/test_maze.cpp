@@ -0,0 +1,60 @@
+#include "test_framework.h"
+#include "maze.h"
+
+/**
+ * @file test_maze.cpp
+ * @brief Shipped levels load, and pellets are placed and collected
+ */
+
+TEST(every_level_loads_with_open_spawn)
+{
+    for (int level = 1; level <= 5; level++)
+    {
+        Maze maze(level);
+        CHECK(maze.get_level() == level);
+        CHECK(!maze.get_walkable_cells().empty());
+
+        const auto [row, col] = Maze::find_spawn_position(maze, MazeConfig::MAZE_ROWS / 2, MazeConfig::MAZE_COLS / 2);
+        CHECK(maze.is_empty(row, col));
+        CHECK(!maze.is_wall(row, col));
+    }
+}
+
+TEST(walls_block_movement)
+{
+    Maze maze(1);
+    for (int row = 0; row < MazeConfig::MAZE_ROWS; row++)
+    {
+        for (int col = 0; col < MazeConfig::MAZE_COLS; col++)
+        {
+            if (maze.is_wall(row, col))
+            {
+                CHECK(!maze.can_move_to(Maze::get_cell_center_x(col), Maze::get_cell_center_y(row)));
+            }
+        }
+    }
+}
+
+TEST(tokens_collect_once_and_clear_the_level)
+{
+    Maze maze(1);
+    GameState game_state;
+    const auto [row, col] = Maze::find_spawn_position(maze, MazeConfig::MAZE_ROWS / 2 + 3, MazeConfig::MAZE_COLS / 2);
+    maze.initialize_tokens(game_state, row, col);
+    maze.initialize_power_pellets(game_state);
+    CHECK(game_state.get_total_tokens() > 0);
+    CHECK(!game_state.all_tokens_collected());
+
+    const auto tokens = game_state.get_tokens();
+    for (const Token &token : tokens)
+    {
+        game_state.check_token_collection(token.get_x(), token.get_y());
+    }
+    CHECK(game_state.all_tokens_collected());
+    CHECK(game_state.get_tokens_collected() == game_state.get_total_tokens());
+
+    // A collected token scores nothing the second time
+    const int score = game_state.get_score();
+    CHECK(!game_state.check_token_collection(tokens[0].get_x(), tokens[0].get_y()));
+    CHECK(game_state.get_score() == score);
+}
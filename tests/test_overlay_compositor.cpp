@@ -0,0 +1,59 @@
+#include "test_framework.h"
+#include "overlay_compositor.h"
+#include "headless.h"
+
+/**
+ * @file test_overlay_compositor.cpp
+ * @brief A still frame is drawn once into the cache and then shown with a blit
+ */
+
+namespace
+{
+    constexpr int WIDTH = 64;
+    constexpr int HEIGHT = 48;
+
+    /**
+     * @brief A small stand-in for the pause screen: scene, dimming and menu text
+     */
+    void draw_paused_scene(const drawing_options &options)
+    {
+        fill_rectangle(COLOR_BLUE, 0, 0, WIDTH, HEIGHT, options);
+        fill_circle(COLOR_YELLOW, 20, 24, 8, options);
+        fill_rectangle(rgba_color(0, 0, 0, 180), 0, 0, WIDTH, HEIGHT, options);
+        draw_text("PAUSED", COLOR_WHITE, "arial", 8, 4, 4, options);
+    }
+}
+
+TEST(paused_frame_is_presented_from_the_cache)
+{
+    open_window("overlay test", WIDTH, HEIGHT);
+    OverlayCompositor compositor(WIDTH, HEIGHT);
+
+    // What the pause frame looks like when drawn straight to the screen
+    draw_paused_scene(option_defaults());
+    const Canvas expected = headless_screen();
+
+    // Capturing draws into the cache through the options, leaving the screen alone
+    int draws = 0;
+    clear_screen(COLOR_RED);
+    compositor.capture([&draws](const drawing_options &options)
+                       {
+                           draws++;
+                           draw_paused_scene(options);
+                       });
+    const Pixel red = headless_screen().pixel_at(0, 0);
+    CHECK(headless_screen().pixel_at(WIDTH - 1, HEIGHT - 1) == red);
+
+    // Every later frame is the cached one, without drawing the scene again
+    for (int frame = 0; frame < 3; frame++)
+    {
+        clear_screen(COLOR_RED);
+        CHECK(compositor.present());
+        const ImageDiff diff = compare_canvases(headless_screen(), expected);
+        CHECK(diff.same_size && diff.differing_pixels == 0);
+    }
+    CHECK(draws == 1);
+
+    compositor.invalidate();
+    CHECK(!compositor.present());
+}
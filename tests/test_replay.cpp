@@ -0,0 +1,132 @@
+#include "test_framework.h"
+#include "replay.h"
+#include "replay_player.h"
+#include "game_config.h"
+#include <filesystem>
+
+/**
+ * @file test_replay.cpp
+ * @brief Replays survive a save and load unchanged, and play back headlessly
+ */
+
+TEST(replay_round_trips_through_a_file)
+{
+    Replay replay;
+    replay.seed = 123456789u;
+    replay.level = 4;
+    replay.endless = true;
+    replay.speed_multiplier = 1.25;
+    replay.palette = PaletteId::YELLOW_PINK_SKY;
+    replay.tick_count = 900;
+    replay.ghost_tuning.lock_on_distance = 175.5;
+    replay.ghost_tuning.scared_duration = 1.0 / 3.0;
+    replay.events = {{180, ReplayEventType::START, DIR_NONE},
+                     {200, ReplayEventType::INPUT, DIR_LEFT},
+                     {260, ReplayEventType::INPUT, DIR_NONE}};
+
+    const std::string path = (std::filesystem::temp_directory_path() / "pacman_test_replay.txt").string();
+    CHECK(save_replay(path, replay));
+
+    Replay loaded;
+    CHECK(load_replay(path, loaded));
+    std::filesystem::remove(path);
+
+    CHECK(loaded.seed == replay.seed);
+    CHECK(loaded.level == replay.level);
+    CHECK(loaded.endless == replay.endless);
+    CHECK(loaded.speed_multiplier == replay.speed_multiplier);
+    CHECK(loaded.palette == replay.palette);
+    CHECK(loaded.tick_count == replay.tick_count);
+    for (int i = 0; i < GHOST_CONSTANT_COUNT; i++)
+    {
+        CHECK(ghost_tuning_value(loaded.ghost_tuning, i) == ghost_tuning_value(replay.ghost_tuning, i));
+    }
+    CHECK(loaded.events.size() == replay.events.size());
+    for (std::size_t i = 0; i < loaded.events.size() && i < replay.events.size(); i++)
+    {
+        CHECK(loaded.events[i].tick == replay.events[i].tick);
+        CHECK(loaded.events[i].type == replay.events[i].type);
+        CHECK(loaded.events[i].dir == replay.events[i].dir);
+    }
+}
+
+TEST(missing_replay_fails_to_load)
+{
+    Replay replay;
+    CHECK(!load_replay("no/such/replay.txt", replay));
+}
+
+TEST(replay_player_waits_for_start_and_stops_at_tick_count)
+{
+    Replay replay;
+    replay.seed = 7;
+    replay.tick_count = 120;
+    replay.events = {{10, ReplayEventType::START, DIR_NONE},
+                     {30, ReplayEventType::INPUT, DIR_LEFT},
+                     {60, ReplayEventType::INPUT, DIR_NONE}};
+
+    Simulation simulation;
+    ReplayPlayer player(simulation);
+    player.start(replay);
+    const double start_x = simulation.get_pacman().get_x();
+    const double start_y = simulation.get_pacman().get_y();
+
+    // Nothing moves while the start jingle plays
+    for (int i = 0; i < 10; i++)
+    {
+        CHECK(player.step());
+    }
+    CHECK(simulation.get_pacman().get_x() == start_x);
+    CHECK(simulation.get_pacman().get_y() == start_y);
+
+    while (player.step())
+    {
+    }
+    CHECK(player.get_tick() <= replay.tick_count);
+    const double end_x = simulation.get_pacman().get_x();
+    const int end_score = simulation.get_game_state().get_score();
+
+    // The same replay always plays out the same way
+    player.start(replay);
+    while (player.step())
+    {
+    }
+    CHECK(simulation.get_pacman().get_x() == end_x);
+    CHECK(simulation.get_game_state().get_score() == end_score);
+}
+
+TEST(replay_player_plays_with_the_recorded_ghost_tuning)
+{
+    Replay replay;
+    replay.ghost_tuning.ambush_distance = 120.0;
+    replay.ghost_tuning.cooldown_duration = 5.0;
+
+    Simulation simulation;
+    ReplayPlayer player(simulation);
+    player.start(replay);
+    CHECK(simulation.get_world().tuning().ambush_distance == 120.0);
+    CHECK(simulation.get_world().tuning().cooldown_duration == 5.0);
+}
+
+TEST(replay_corpus_covers_every_level_and_difficulty)
+{
+    bool covered[5][GameConfig::DIFFICULTY_COUNT] = {};
+    for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator("Resources/Replays"))
+    {
+        Replay replay;
+        CHECK(load_replay(entry.path().string(), replay));
+        for (int difficulty = 0; difficulty < GameConfig::DIFFICULTY_COUNT; difficulty++)
+        {
+            if (replay.speed_multiplier == GameConfig::DIFFICULTY_SPEED_MULTIPLIERS[difficulty])
+                covered[replay.level - 1][difficulty] = true;
+        }
+    }
+
+    for (int level = 0; level < 5; level++)
+    {
+        for (int difficulty = 0; difficulty < GameConfig::DIFFICULTY_COUNT; difficulty++)
+        {
+            CHECK(covered[level][difficulty]);
+        }
+    }
+}
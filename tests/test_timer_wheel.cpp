@@ -0,0 +1,64 @@
+#include "test_framework.h"
+#include "timer_wheel.h"
+
+/**
+ * @file test_timer_wheel.cpp
+ * @brief Timer wheel scheduling, cancellation and clearing
+ */
+
+TEST(timer_fires_after_its_delay)
+{
+    TimerWheel wheel;
+    int fired = 0;
+    wheel.schedule(3, [&fired]() { fired++; });
+
+    wheel.tick();
+    wheel.tick();
+    CHECK(fired == 0);
+    wheel.tick();
+    CHECK(fired == 1);
+    wheel.tick();
+    CHECK(fired == 1);
+}
+
+TEST(timer_beyond_one_wheel_turn)
+{
+    TimerWheel wheel;
+    const std::uint64_t delay = TimerConfig::WHEEL_SLOTS + 5;
+    bool fired = false;
+    const TimerId id = wheel.schedule(delay, [&fired]() { fired = true; });
+
+    for (std::uint64_t i = 0; i + 1 < delay; i++)
+        wheel.tick();
+    CHECK(!fired);
+    CHECK(wheel.remaining(id) == 1);
+    wheel.tick();
+    CHECK(fired);
+    CHECK(!wheel.is_pending(id));
+}
+
+TEST(cancelled_timer_never_fires)
+{
+    TimerWheel wheel;
+    bool fired = false;
+    const TimerId id = wheel.schedule(2, [&fired]() { fired = true; });
+    wheel.cancel(id);
+
+    for (int i = 0; i < 4; i++)
+        wheel.tick();
+    CHECK(!fired);
+    CHECK(!wheel.is_pending(id));
+}
+
+TEST(clear_drops_timers_and_restarts_count)
+{
+    TimerWheel wheel;
+    bool fired = false;
+    wheel.schedule(1, [&fired]() { fired = true; });
+    wheel.clear();
+    wheel.tick();
+
+    CHECK(!fired);
+    CHECK(wheel.now() == 1);
+    CHECK(TimerWheel::seconds_to_ticks(1.0) == TimerConfig::TICKS_PER_SECOND);
+}
@@ -0,0 +1,189 @@
+#include "text_renderer.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file text_renderer.cpp
+ * @brief Implementation of the TextRenderer class
+ *
+ * Each font size owns a set of single-row glyph atlases (one per colour) with
+ * a fixed cell per printable ASCII character. Strings are laid out as a list
+ * of atlas cells and drawn with one option_part_bmp blit per glyph.
+ */
+
+using namespace TextConfig;
+
+/**
+ * @brief Constructor - atlases are built lazily on first use
+ */
+TextRenderer::TextRenderer(const std::string &font_name) : font_name_(font_name)
+{
+}
+
+/**
+ * @brief Destructor - frees all atlas bitmaps
+ */
+TextRenderer::~TextRenderer()
+{
+    for (auto &[size, face] : faces_)
+    {
+        for (auto &[key, atlas] : face.atlases)
+        {
+            free_bitmap(atlas);
+        }
+    }
+}
+
+void TextRenderer::draw_text(std::string_view text, const color &clr, int font_size, double x, double y,
+                             const drawing_options &options)
+{
+    FontFace &face = get_face(font_size);
+    draw_layout(get_cached_layout(face, text, font_size), clr, x, y, options);
+}
+
+void TextRenderer::draw_centered_text(std::string_view text, const color &clr, int font_size, int window_width, double y,
+                                      const drawing_options &options)
+{
+    FontFace &face = get_face(font_size);
+    const TextLayout &layout = get_cached_layout(face, text, font_size);
+    draw_layout(layout, clr, window_width / 2 - layout.width / 2, y, options);
+}
+
+void TextRenderer::layout_text(std::string_view text, int font_size, TextLayout &layout)
+{
+    build_layout(get_face(font_size), text, font_size, layout);
+}
+
+void TextRenderer::draw_layout(const TextLayout &layout, const color &clr, double x, double y,
+                               const drawing_options &options)
+{
+    if (layout.quads.empty())
+        return;
+
+    FontFace &face = get_face(layout.font_size);
+    bitmap atlas = get_atlas(face, layout.font_size, clr);
+
+    for (const GlyphQuad &quad : layout.quads)
+    {
+        draw_bitmap(atlas, x + quad.dst_x, y, option_part_bmp(quad.src_x, 0, quad.src_w, layout.height, options));
+    }
+}
+
+int TextRenderer::text_width(std::string_view text, int font_size)
+{
+    FontFace &face = get_face(font_size);
+    return get_cached_layout(face, text, font_size).width;
+}
+
+int TextRenderer::line_height(int font_size)
+{
+    return get_face(font_size).height;
+}
+
+std::size_t TextRenderer::cached_layout_count(int font_size)
+{
+    return get_face(font_size).layout_cache.size();
+}
+
+TextRenderer::FontFace &TextRenderer::get_face(int font_size)
+{
+    auto it = faces_.find(font_size);
+    if (it != faces_.end())
+        return it->second;
+
+    // First use of this size - measure every glyph once
+    FontFace &face = faces_[font_size];
+    face.height = text_height("Hg", font_name_, font_size);
+
+    char glyph[2] = {0, 0};
+    for (int i = 0; i < GLYPH_COUNT; i++)
+    {
+        glyph[0] = static_cast<char>(FIRST_GLYPH + i);
+        face.advances[i] = ::text_width(glyph, font_name_, font_size);
+        face.cell_width = std::max(face.cell_width, face.advances[i]);
+    }
+
+    // Leave a little room for glyphs that overhang their advance
+    face.cell_width += 2;
+    return face;
+}
+
+bitmap TextRenderer::get_atlas(FontFace &face, int font_size, const color &clr)
+{
+    const std::uint32_t key = pack_color(clr);
+    auto it = face.atlases.find(key);
+    if (it != face.atlases.end())
+        return it->second;
+
+    // Rasterise the whole printable range into one row of fixed-width cells
+    const std::string name = "text_atlas_" + std::to_string(font_size) + "_" + std::to_string(key);
+    bitmap atlas = create_bitmap(name, face.cell_width * GLYPH_COUNT, face.height);
+    clear_bitmap(atlas, COLOR_TRANSPARENT);
+
+    char glyph[2] = {0, 0};
+    for (int i = 0; i < GLYPH_COUNT; i++)
+    {
+        glyph[0] = static_cast<char>(FIRST_GLYPH + i);
+        if (glyph[0] != ' ')
+        {
+            draw_text_on_bitmap(atlas, glyph, clr, font_name_, font_size, i * face.cell_width, 0);
+        }
+    }
+
+    face.atlases.emplace(key, atlas);
+    return atlas;
+}
+
+const TextLayout &TextRenderer::get_cached_layout(FontFace &face, std::string_view text, int font_size)
+{
+    face.layout_clock++;
+    auto it = face.layout_cache.find(text);
+    if (it != face.layout_cache.end())
+    {
+        it->second.last_use = face.layout_clock;
+        return it->second.layout;
+    }
+
+    // Text that keeps changing would grow the cache without bound, so the least recently used layout makes room
+    if (face.layout_cache.size() >= LAYOUT_CACHE_SIZE)
+    {
+        auto oldest = std::min_element(face.layout_cache.begin(), face.layout_cache.end(),
+                                       [](const auto &a, const auto &b)
+                                       { return a.second.last_use < b.second.last_use; });
+        face.layout_cache.erase(oldest);
+    }
+
+    CachedLayout cached;
+    build_layout(face, text, font_size, cached.layout);
+    cached.last_use = face.layout_clock;
+    return face.layout_cache.emplace(std::string(text), std::move(cached)).first->second.layout;
+}
+
+void TextRenderer::build_layout(const FontFace &face, std::string_view text, int font_size, TextLayout &layout) const
+{
+    layout.font_size = font_size;
+    layout.height = face.height;
+    layout.width = 0;
+    layout.quads.clear();
+
+    for (char c : text)
+    {
+        // Characters outside the atlas are drawn as '?'
+        int index = (c >= FIRST_GLYPH && c <= LAST_GLYPH) ? c - FIRST_GLYPH : '?' - FIRST_GLYPH;
+
+        if (c != ' ')
+        {
+            layout.quads.push_back({index * face.cell_width, face.cell_width, layout.width});
+        }
+        layout.width += face.advances[index];
+    }
+}
+
+std::uint32_t TextRenderer::pack_color(const color &clr)
+{
+    auto channel = [](float value)
+    {
+        return static_cast<std::uint32_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+    };
+    return channel(clr.r) << 24 | channel(clr.g) << 16 | channel(clr.b) << 8 | channel(clr.a);
+}
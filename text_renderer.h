@@ -0,0 +1,185 @@
+#pragma once
+
+#include "splashkit.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file text_renderer.h
+ * @brief Cached text rendering for the HUD and menu screens
+ *
+ * This file contains the TextRenderer class, which draws text from glyph
+ * atlases instead of asking SplashKit to rasterise the string every frame.
+ */
+
+/**
+ * Text rendering configuration constants
+ */
+namespace TextConfig
+{
+    constexpr const char *FONT_NAME = "Arial"; ///< Font used for all HUD and menu text
+    constexpr char FIRST_GLYPH = ' ';          ///< First printable ASCII character in the atlas
+    constexpr char LAST_GLYPH = '~';           ///< Last printable ASCII character in the atlas
+    constexpr int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+    constexpr std::size_t LAYOUT_CACHE_SIZE = 64; ///< Layouts kept per font size; the least recently drawn goes first
+}
+
+/**
+ * A single glyph blit: where to read it from the atlas and where to place it
+ */
+struct GlyphQuad
+{
+    int src_x; ///< Left edge of the glyph cell in the atlas
+    int src_w; ///< Width of the glyph cell in the atlas
+    int dst_x; ///< Horizontal offset from the start of the string
+};
+
+/**
+ * A string laid out for one font size
+ * Layouts only depend on the font size, so one layout can be drawn in any colour.
+ */
+struct TextLayout
+{
+    int font_size = 0;
+    int width = 0;  ///< Total advance width of the string (pixels)
+    int height = 0; ///< Line height of the font size (pixels)
+    std::vector<GlyphQuad> quads;
+};
+
+/**
+ * @class TextRenderer
+ * @brief Draws text from per-size glyph atlases with a layout cache
+ *
+ * The TextRenderer is responsible for:
+ * - Rasterising the printable ASCII range once per font size and colour
+ * - Caching the layouts of strings drawn through draw_text() by content,
+ *   keeping the TextConfig::LAYOUT_CACHE_SIZE most recently drawn per size
+ * - Laying out frequently changing strings (HUD counters) into caller-owned
+ *   layouts so they are rebuilt only when their value changes
+ *
+ * Once a string has been drawn, drawing it again costs one bitmap blit per
+ * glyph and performs no allocation.
+ */
+class TextRenderer
+{
+public:
+    /**
+     * @brief Constructor - atlases are built lazily on first use
+     * @param font_name Name of the font to rasterise
+     */
+    explicit TextRenderer(const std::string &font_name = TextConfig::FONT_NAME);
+
+    /**
+     * @brief Destructor - frees all atlas bitmaps
+     */
+    ~TextRenderer();
+
+    TextRenderer(const TextRenderer &) = delete;
+    TextRenderer &operator=(const TextRenderer &) = delete;
+
+    /**
+     * @brief Draw a string using the content-keyed layout cache
+     * Use this for strings drawn repeatedly with the same content (menus, labels);
+     * text that changes every frame should go through layout_text() instead.
+     * @param text Text to draw
+     * @param clr Text colour
+     * @param font_size Font size (points)
+     * @param x Left edge of the text
+     * @param y Top edge of the text
+     * @param options Drawing options, such as option_to_bitmap() to draw off screen
+     */
+    void draw_text(std::string_view text, const color &clr, int font_size, double x, double y,
+                   const drawing_options &options = option_defaults());
+
+    /**
+     * @brief Draw a string horizontally centred in the window
+     * @param text Text to draw
+     * @param clr Text colour
+     * @param font_size Font size (points)
+     * @param window_width Width of the window to centre in
+     * @param y Top edge of the text
+     * @param options Drawing options, such as option_to_bitmap() to draw off screen
+     */
+    void draw_centered_text(std::string_view text, const color &clr, int font_size, int window_width, double y,
+                            const drawing_options &options = option_defaults());
+
+    /**
+     * @brief Lay out a string into a caller-owned layout without touching the cache
+     * The layout's storage is reused, so re-laying out a string of similar
+     * length does not allocate.
+     * @param text Text to lay out
+     * @param font_size Font size (points)
+     * @param layout Layout to fill
+     */
+    void layout_text(std::string_view text, int font_size, TextLayout &layout);
+
+    /**
+     * @brief Draw a previously built layout
+     * @param layout Layout produced by layout_text()
+     * @param clr Text colour
+     * @param x Left edge of the text
+     * @param y Top edge of the text
+     * @param options Drawing options, such as option_to_bitmap() to draw off screen
+     */
+    void draw_layout(const TextLayout &layout, const color &clr, double x, double y,
+                     const drawing_options &options = option_defaults());
+
+    /**
+     * @brief Measure the width of a string (uses the layout cache)
+     * @param text Text to measure
+     * @param font_size Font size (points)
+     * @return Width of the string in pixels
+     */
+    int text_width(std::string_view text, int font_size);
+
+    /**
+     * @brief Line height of a font size
+     * @param font_size Font size (points)
+     * @return Height of one line of text in pixels
+     */
+    int line_height(int font_size);
+
+    /**
+     * @brief Number of string layouts cached for a font size
+     * @param font_size Font size (points)
+     * @return At most TextConfig::LAYOUT_CACHE_SIZE
+     */
+    std::size_t cached_layout_count(int font_size);
+
+private:
+    /**
+     * A cached layout and when it was last used
+     */
+    struct CachedLayout
+    {
+        TextLayout layout;
+        std::uint64_t last_use = 0; ///< FontFace::layout_clock when last drawn or measured
+    };
+
+    /**
+     * Glyph metrics and atlases for one font size
+     */
+    struct FontFace
+    {
+        int height = 0;                                                ///< Line height in pixels
+        int cell_width = 0;                                            ///< Width of one atlas cell
+        int advances[TextConfig::GLYPH_COUNT] = {};                    ///< Advance width of each glyph
+        std::map<std::uint32_t, bitmap> atlases;                       ///< One atlas per packed colour
+        std::map<std::string, CachedLayout, std::less<>> layout_cache; ///< Layouts keyed by content
+        std::uint64_t layout_clock = 0;                                ///< Counts layout cache lookups
+    };
+
+    std::string font_name_;
+    std::map<int, FontFace> faces_; ///< Faces keyed by font size
+
+    FontFace &get_face(int font_size);
+    bitmap get_atlas(FontFace &face, int font_size, const color &clr);
+    const TextLayout &get_cached_layout(FontFace &face, std::string_view text, int font_size);
+    void build_layout(const FontFace &face, std::string_view text, int font_size, TextLayout &layout) const;
+    static std::uint32_t pack_color(const color &clr);
+};
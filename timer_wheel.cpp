@@ -0,0 +1,129 @@
+#include "timer_wheel.h"
+#include "alloc_tracker.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file timer_wheel.cpp
+ * @brief Implementation of the TimerWheel class
+ */
+
+using namespace TimerConfig;
+
+static_assert((WHEEL_SLOTS & (WHEEL_SLOTS - 1)) == 0, "WHEEL_SLOTS must be a power of two");
+
+TimerWheel::TimerWheel()
+{
+    AllocScope alloc_scope(AllocTag::TIMERS);
+    for (std::vector<Timer> &slot : slots_)
+    {
+        slot.reserve(SLOT_CAPACITY);
+    }
+    expiries_.reserve(PENDING_CAPACITY);
+    firing_.reserve(SLOT_CAPACITY);
+}
+
+TimerId TimerWheel::schedule(std::uint64_t delay_ticks, std::function<void()> callback)
+{
+    AllocScope alloc_scope(AllocTag::TIMERS);
+    const TimerId id = next_id_++;
+    if (next_id_ == 0)
+        next_id_ = 1; // 0 is reserved for "no timer"
+
+    // Timers longer than one rotation simply stay in their bucket until their tick comes round
+    const std::uint64_t expiry = now_ + std::max<std::uint64_t>(delay_ticks, 1);
+    slots_[slot_of(expiry)].push_back({id, expiry, std::move(callback)});
+    expiries_.emplace_back(id, expiry);
+    return id;
+}
+
+void TimerWheel::cancel(TimerId id)
+{
+    const auto it = find_pending(id);
+    if (it == expiries_.end())
+        return;
+
+    std::vector<Timer> &slot = slots_[slot_of(it->second)];
+    erase_pending(id);
+
+    // The timer may already have been moved out to fire this tick
+    for (size_t i = 0; i < slot.size(); i++)
+    {
+        if (slot[i].id == id)
+        {
+            slot[i] = std::move(slot.back());
+            slot.pop_back();
+            return;
+        }
+    }
+}
+
+void TimerWheel::tick()
+{
+    now_++;
+
+    // Move the due timers out first so callbacks can freely reschedule into this bucket
+    std::vector<Timer> &slot = slots_[slot_of(now_)];
+    firing_.clear();
+    for (size_t i = 0; i < slot.size();)
+    {
+        if (slot[i].expiry == now_)
+        {
+            firing_.push_back(std::move(slot[i]));
+            slot[i] = std::move(slot.back());
+            slot.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    for (Timer &timer : firing_)
+    {
+        // Skip timers cancelled by an earlier callback on this tick
+        if (erase_pending(timer.id))
+        {
+            timer.callback();
+        }
+    }
+}
+
+void TimerWheel::clear()
+{
+    for (std::vector<Timer> &slot : slots_)
+    {
+        slot.clear();
+    }
+    expiries_.clear();
+    now_ = 0;
+}
+
+std::uint64_t TimerWheel::remaining(TimerId id) const
+{
+    const auto it = find_pending(id);
+    return it != expiries_.end() ? it->second - now_ : 0;
+}
+
+std::vector<std::pair<TimerId, std::uint64_t>>::const_iterator TimerWheel::find_pending(TimerId id) const
+{
+    return std::find_if(expiries_.begin(), expiries_.end(),
+                        [id](const std::pair<TimerId, std::uint64_t> &entry) { return entry.first == id; });
+}
+
+bool TimerWheel::erase_pending(TimerId id)
+{
+    const auto it = find_pending(id);
+    if (it == expiries_.end())
+        return false;
+
+    // Order does not matter, so the last entry fills the gap
+    expiries_[it - expiries_.begin()] = expiries_.back();
+    expiries_.pop_back();
+    return true;
+}
+
+std::uint64_t TimerWheel::seconds_to_ticks(double seconds)
+{
+    return static_cast<std::uint64_t>(std::llround(std::max(seconds, 0.0) * TICKS_PER_SECOND));
+}
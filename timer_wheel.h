@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @file timer_wheel.h
+ * @brief Tick-based timer wheel for gameplay timers
+ *
+ * This file contains the TimerWheel class, which replaces per-entity
+ * countdown variables with one-shot timers keyed on simulation ticks.
+ */
+
+/**
+ * Timer configuration constants
+ */
+namespace TimerConfig
+{
+    constexpr int TICKS_PER_SECOND = 60; ///< Simulation ticks per second of game time
+    constexpr int WHEEL_SLOTS = 256;     ///< Number of wheel buckets (power of two)
+    constexpr int SLOT_CAPACITY = 4;     ///< Timers each bucket holds before it has to grow
+    constexpr int PENDING_CAPACITY = 64; ///< Pending timers held before the expiry index has to grow
+}
+
+using TimerId = std::uint32_t; ///< Handle to a scheduled timer (0 = no timer)
+
+/**
+ * @class TimerWheel
+ * @brief Hashed timer wheel that fires callbacks when simulation ticks expire
+ *
+ * Timers are stored in the bucket for their expiry tick, so advancing the
+ * wheel by one tick only looks at the timers in one bucket. Nothing is done
+ * per timer per frame; a timer costs work when it is scheduled, cancelled
+ * and when it fires.
+ *
+ * Callbacks may schedule or cancel other timers, including timers due on
+ * the same tick.
+ *
+ * Storage is reserved up front and reused, so scheduling, cancelling and
+ * firing do not allocate while a game is running (callbacks must fit
+ * std::function's inline storage, which a reference and an id do).
+ */
+class TimerWheel
+{
+public:
+    TimerWheel();
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    /**
+     * @brief Schedule a one-shot timer
+     * @param delay_ticks Ticks from now until the timer fires (at least 1)
+     * @param callback Function called when the timer expires
+     * @return Handle that can be passed to cancel() or remaining()
+     */
+    TimerId schedule(std::uint64_t delay_ticks, std::function<void()> callback);
+
+    /**
+     * @brief Cancel a pending timer
+     * @param id Timer handle (0 and expired handles are ignored)
+     */
+    void cancel(TimerId id);
+
+    /**
+     * @brief Advance the wheel by one tick, firing every timer due on it
+     */
+    void tick();
+
+    /**
+     * @brief Remove every pending timer and restart the tick count at zero
+     */
+    void clear();
+
+    /**
+     * @brief Check if a timer is still pending
+     * @param id Timer handle
+     * @return true if the timer has neither fired nor been cancelled
+     */
+    bool is_pending(TimerId id) const { return find_pending(id) != expiries_.end(); }
+
+    /**
+     * @brief Ticks left before a timer fires
+     * @param id Timer handle
+     * @return Remaining ticks, or 0 if the timer is not pending
+     */
+    std::uint64_t remaining(TimerId id) const;
+
+    /**
+     * @brief Current simulation tick
+     */
+    std::uint64_t now() const { return now_; }
+
+    /**
+     * @brief Convert a duration in seconds to whole ticks (rounded to nearest)
+     */
+    static std::uint64_t seconds_to_ticks(double seconds);
+
+private:
+    struct Timer
+    {
+        TimerId id;
+        std::uint64_t expiry;
+        std::function<void()> callback;
+    };
+
+    std::array<std::vector<Timer>, TimerConfig::WHEEL_SLOTS> slots_;
+    std::vector<std::pair<TimerId, std::uint64_t>> expiries_; ///< Expiry tick of every pending timer, unordered
+    std::vector<Timer> firing_;                               ///< Timers being fired by the current tick
+    std::uint64_t now_ = 0;
+    TimerId next_id_ = 1;
+
+    static std::size_t slot_of(std::uint64_t tick) { return tick & (TimerConfig::WHEEL_SLOTS - 1); }
+
+    /**
+     * @brief Entry of a pending timer in expiries_ (a handful of timers, so a linear scan beats hashing)
+     */
+    std::vector<std::pair<TimerId, std::uint64_t>>::const_iterator find_pending(TimerId id) const;
+
+    /**
+     * @brief Remove a timer from expiries_
+     * @return false if it was not pending
+     */
+    bool erase_pending(TimerId id);
+};
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file bench_compare.cpp
+ * @brief Throughput regression gate: compares two builds of pacman_bench
+ *
+ * Usage: bench_compare <baseline pacman_bench> <current pacman_bench>
+ *                      [--runs N] [--ticks N] [--threshold PERCENT]
+ *
+ * Both benchmarks are run N times, alternating which goes first so drift
+ * in machine load hits both equally, each writing a --report file. For
+ * ticks/s, allocations/tick and p99 tick latency the tool prints the mean
+ * of each build, the change, and a bootstrap 95% confidence interval of
+ * the change. A metric regresses when the whole interval is on the worse
+ * side of zero and the mean change is worse than the threshold.
+ *
+ * Exit status: 0 when nothing regressed, 1 on a regression, 2 when a
+ * benchmark could not be run. Run it from a build directory, which links
+ * Resources/, so both builds play the same mazes (cmake/perf_gate.cmake
+ * builds a baseline from a git ref and does this).
+ */
+
+/**
+ * Comparison configuration constants
+ */
+namespace CompareConfig
+{
+    constexpr int DEFAULT_RUNS = 5;
+    constexpr int DEFAULT_TICKS = 50000;        ///< Ticks per level per run
+    constexpr double DEFAULT_THRESHOLD = 5.0;   ///< Largest tolerated slowdown (percent)
+    constexpr int BOOTSTRAP_RESAMPLES = 10000;
+    constexpr double CONFIDENCE = 0.95;
+    constexpr std::uint32_t BOOTSTRAP_SEED = 1; ///< Fixed so the same samples always give the same verdict
+}
+
+namespace
+{
+    /**
+     * A gated benchmark figure
+     */
+    struct Metric
+    {
+        const char *key;      ///< Name in the pacman_bench report
+        const char *label;    ///< Name printed in the table
+        bool higher_is_better;
+    };
+
+    constexpr Metric METRICS[] = {
+        {"total.ticks_per_second", "ticks/s", true},
+        {"total.allocations_per_tick", "allocs/tick", false},
+        {"total.p99_tick_ns", "p99 tick ns", false},
+    };
+
+    using Report = std::map<std::string, double>;
+
+    /**
+     * @brief Run one benchmark and read its report
+     * @return false if it failed or wrote no report
+     */
+    bool run_bench(const std::string &bench, int ticks, const std::filesystem::path &report_path, Report &report)
+    {
+#ifdef _WIN32
+        const char *discard = " > NUL";
+#else
+        const char *discard = " > /dev/null";
+#endif
+        std::filesystem::remove(report_path);
+        const std::string command = "\"" + bench + "\" " + std::to_string(ticks) + " --report \"" +
+                                    report_path.string() + "\"" + discard;
+        if (std::system(command.c_str()) != 0)
+            return false;
+
+        std::ifstream file(report_path);
+        std::string key;
+        double value;
+        report.clear();
+        while (file >> key >> value)
+            report[key] = value;
+        return !report.empty();
+    }
+
+    double mean(const std::vector<double> &samples)
+    {
+        double sum = 0.0;
+        for (double sample : samples)
+            sum += sample;
+        return sum / samples.size();
+    }
+
+    /**
+     * @brief Relative change of the current mean over the baseline mean (0.05 = 5% higher)
+     */
+    double relative_change(const std::vector<double> &baseline, const std::vector<double> &current)
+    {
+        const double base = mean(baseline);
+        const double now = mean(current);
+        if (base == 0.0)
+            return now == 0.0 ? 0.0 : HUGE_VAL;
+        return (now - base) / base;
+    }
+
+    /**
+     * @brief Bootstrap confidence interval of relative_change, resampling each build's runs
+     */
+    std::pair<double, double> bootstrap_interval(const std::vector<double> &baseline,
+                                                 const std::vector<double> &current, std::mt19937 &random)
+    {
+        std::uniform_int_distribution<std::size_t> pick_baseline(0, baseline.size() - 1);
+        std::uniform_int_distribution<std::size_t> pick_current(0, current.size() - 1);
+        std::vector<double> resampled_baseline(baseline.size());
+        std::vector<double> resampled_current(current.size());
+        std::vector<double> changes(CompareConfig::BOOTSTRAP_RESAMPLES);
+
+        for (double &change : changes)
+        {
+            for (double &sample : resampled_baseline)
+                sample = baseline[pick_baseline(random)];
+            for (double &sample : resampled_current)
+                sample = current[pick_current(random)];
+            change = relative_change(resampled_baseline, resampled_current);
+        }
+
+        std::sort(changes.begin(), changes.end());
+        const double tail = (1.0 - CompareConfig::CONFIDENCE) / 2.0;
+        const std::size_t low = static_cast<std::size_t>(tail * (changes.size() - 1));
+        const std::size_t high = static_cast<std::size_t>((1.0 - tail) * (changes.size() - 1));
+        return {changes[low], changes[high]};
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> benches;
+    int runs = CompareConfig::DEFAULT_RUNS;
+    int ticks = CompareConfig::DEFAULT_TICKS;
+    double threshold = CompareConfig::DEFAULT_THRESHOLD;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--runs" && i + 1 < argc)
+            runs = std::max(2, std::atoi(argv[++i]));
+        else if (argument == "--ticks" && i + 1 < argc)
+            ticks = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--threshold" && i + 1 < argc)
+            threshold = std::max(0.0, std::atof(argv[++i]));
+        else
+            benches.push_back(argument);
+    }
+    if (benches.size() != 2)
+    {
+        std::cerr << "Usage: bench_compare <baseline pacman_bench> <current pacman_bench> [--runs N] [--ticks N] "
+                     "[--threshold PERCENT]"
+                  << std::endl;
+        return 2;
+    }
+
+    const std::filesystem::path report_path = std::filesystem::temp_directory_path() / "bench_compare_report.txt";
+    const char *names[2] = {"baseline", "current"};
+    std::map<std::string, std::vector<double>> samples[2];
+    std::cout << std::fixed << std::setprecision(0);
+
+    for (int run = 0; run < runs; run++)
+    {
+        for (int turn = 0; turn < 2; turn++)
+        {
+            const int build = (run + turn) % 2;
+            Report report;
+            if (!run_bench(benches[build], ticks, report_path, report))
+            {
+                std::cerr << "Failed to run the " << names[build] << " benchmark " << benches[build] << "!"
+                          << std::endl;
+                return 2;
+            }
+            for (const auto &[key, value] : report)
+                samples[build][key].push_back(value);
+        }
+        const std::vector<double> &baseline = samples[0]["total.ticks_per_second"];
+        const std::vector<double> &current = samples[1]["total.ticks_per_second"];
+        if (!baseline.empty() && !current.empty())
+        {
+            std::cout << "run " << run + 1 << "/" << runs << ": baseline " << baseline.back()
+                      << " ticks/s, current " << current.back() << " ticks/s" << std::endl;
+        }
+    }
+    std::filesystem::remove(report_path);
+
+    std::mt19937 random(CompareConfig::BOOTSTRAP_SEED);
+    bool regressed = false;
+    std::cout << std::setprecision(2) << std::endl;
+    for (const Metric &metric : METRICS)
+    {
+        const std::vector<double> &baseline = samples[0][metric.key];
+        const std::vector<double> &current = samples[1][metric.key];
+        if (baseline.empty() || current.empty())
+        {
+            std::cout << metric.label << ": not reported by both builds, skipped" << std::endl;
+            continue;
+        }
+
+        const double change = relative_change(baseline, current);
+        const auto [low, high] = bootstrap_interval(baseline, current, random);
+
+        // Express everything as a slowdown, so positive is always worse
+        const double sign = metric.higher_is_better ? -1.0 : 1.0;
+        const double worse_low = std::min(sign * low, sign * high);
+        const bool significant = worse_low > 0.0 || std::max(sign * low, sign * high) < 0.0;
+        const bool failed = worse_low > 0.0 && sign * change * 100.0 > threshold;
+        regressed = regressed || failed;
+
+        std::cout << metric.label << ": " << mean(baseline) << " -> " << mean(current) << " (" << std::showpos
+                  << change * 100.0 << "%, 95% CI " << low * 100.0 << "% to " << high * 100.0 << "%"
+                  << std::noshowpos << ") " << (failed ? "REGRESSION" : significant ? "significant" : "within noise")
+                  << std::endl;
+    }
+
+    std::cout << (regressed ? "FAIL" : "ok") << ": threshold " << threshold << "%" << std::endl;
+    return regressed ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+#include "bot_games.h"
+#include "danger_map.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file danger_sweep.cpp
+ * @brief Plays many bot games on every level and writes where Pac-Man dies and where the ghosts go
+ *
+ * Usage: danger_sweep [games_per_level] [output_dir] [--difficulty NAME] [--threads N] [--max-seconds N]
+ *
+ * The bot plays the given number of games on each of the five levels at
+ * one difficulty (medium by default) through play_bot_batch, so worker
+ * threads take the next game as they finish one. Every worker counts into
+ * its own DangerMap, and the level's maps are merged once its batch has
+ * finished. Games are cut off after bot_step_limit(max_seconds), which
+ * stretches with slower difficulties as in the other bot tools. One CSV per level and DangerLayer is written to
+ * output_dir (default danger_maps), named level<N>_<layer>.csv, with the
+ * same 13x25 shape as Resources/Maps/level<N>.csv. heatmap_render draws
+ * them over the maze.
+ *
+ * Seeds depend only on the level, difficulty and game number, so a run
+ * gives the same maps however many threads it uses.
+ */
+
+using namespace GameConfig;
+
+/**
+ * Danger sweep configuration constants
+ */
+namespace SweepConfig
+{
+    constexpr int DEFAULT_GAMES_PER_LEVEL = 200;
+    constexpr const char *DEFAULT_OUTPUT_DIR = "danger_maps";
+    constexpr int DEFAULT_DIFFICULTY = 1; ///< Medium
+    constexpr int LEVEL_COUNT = 5;
+}
+
+namespace
+{
+    std::uint32_t game_seed(int level, int difficulty, int game)
+    {
+        return static_cast<std::uint32_t>(1000000 * level + 100000 * difficulty + game + 1);
+    }
+
+    /**
+     * @brief Total count of a layer over every cell
+     */
+    std::uint64_t layer_total(const HeatGrid &grid)
+    {
+        std::uint64_t total = 0;
+        for (const auto &row : grid)
+        {
+            for (std::uint64_t count : row)
+                total += count;
+        }
+        return total;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int games_per_level = SweepConfig::DEFAULT_GAMES_PER_LEVEL;
+    int difficulty = SweepConfig::DEFAULT_DIFFICULTY;
+    std::filesystem::path output = SweepConfig::DEFAULT_OUTPUT_DIR;
+    int max_seconds = BotGamesConfig::DEFAULT_MAX_SECONDS;
+    int thread_count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--difficulty" && i + 1 < argc)
+        {
+            const std::string name = argv[++i];
+            const auto found = std::find(std::begin(DIFFICULTY_NAMES), std::end(DIFFICULTY_NAMES), name);
+            if (found == std::end(DIFFICULTY_NAMES))
+            {
+                std::cerr << "Unknown difficulty " << name << " (easy, medium, hard or crazy)" << std::endl;
+                return 1;
+            }
+            difficulty = static_cast<int>(found - std::begin(DIFFICULTY_NAMES));
+        }
+        else if (argument == "--threads" && i + 1 < argc)
+            thread_count = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--max-seconds" && i + 1 < argc)
+            max_seconds = std::max(1, std::atoi(argv[++i]));
+        else
+            positional.push_back(argument);
+    }
+    if (positional.size() > 0)
+        games_per_level = std::max(1, std::atoi(positional[0].c_str()));
+    if (positional.size() > 1)
+        output = positional[1];
+
+    std::error_code error;
+    std::filesystem::create_directories(output, error);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::array<DangerMap, SweepConfig::LEVEL_COUNT> maps;
+    BotBatch batch;
+    batch.games = games_per_level;
+    batch.settings.speed_multiplier = DIFFICULTY_SPEED_MULTIPLIERS[difficulty];
+    batch.max_steps = bot_step_limit(max_seconds, batch.settings.speed_multiplier);
+    thread_count = bot_batch_workers(batch, thread_count);
+    for (int level = 1; level <= SweepConfig::LEVEL_COUNT; level++)
+    {
+        batch.level = level;
+        batch.settings.seed = game_seed(level, difficulty, 0);
+
+        // Workers only touch their own maps; merging waits until the batch has been played
+        std::vector<DangerMap> worker_maps(thread_count);
+        const std::vector<BotGameResult> results =
+            play_bot_batch(batch, thread_count,
+                           [&worker_maps](int worker, const Simulation &played, const StepEvents &events)
+                           {
+                               worker_maps[worker].record_step(played);
+                               if (events.pacman_caught)
+                                   worker_maps[worker].record_death(played);
+                           });
+
+        DangerMap &map = maps[level - 1];
+        for (const DangerMap &worker_map : worker_maps)
+            map.merge(worker_map);
+        for (std::size_t game = 0; game < results.size(); game++)
+            map.record_game();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (int level = 1; level <= SweepConfig::LEVEL_COUNT; level++)
+    {
+        const DangerMap &map = maps[level - 1];
+        for (int layer = 0; layer < DANGER_LAYER_COUNT; layer++)
+        {
+            const DangerLayer kind = static_cast<DangerLayer>(layer);
+            const std::filesystem::path path =
+                output / ("level" + std::to_string(level) + "_" + danger_layer_name(kind) + ".csv");
+            if (!save_heat_grid(path.string(), map.get_layer(kind)))
+            {
+                std::cerr << "Failed to write " << path << "!" << std::endl;
+                return 1;
+            }
+        }
+
+        // The cell where most games ended
+        const HeatGrid &deaths = map.get_layer(DangerLayer::DEATHS);
+        int worst_row = 0, worst_col = 0;
+        for (int row = 0; row < MazeConfig::MAZE_ROWS; row++)
+        {
+            for (int col = 0; col < MazeConfig::MAZE_COLS; col++)
+            {
+                if (deaths[row][col] > deaths[worst_row][worst_col])
+                {
+                    worst_row = row;
+                    worst_col = col;
+                }
+            }
+        }
+        std::cout << "level " << level << ": " << map.get_games() << " games, " << map.get_steps() << " steps, "
+                  << layer_total(deaths) << " deaths, deadliest cell (" << worst_row << ", " << worst_col << ") with "
+                  << deaths[worst_row][worst_col] << std::endl;
+    }
+
+    std::cout << "Played " << games_per_level * SweepConfig::LEVEL_COUNT << " games on " << thread_count
+              << " threads in " << seconds << " s; maps written to " << output << std::endl;
+    return 0;
+}
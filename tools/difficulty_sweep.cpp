@@ -0,0 +1,184 @@
+#include "bot_games.h"
+#include "ghost_tuning.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file difficulty_sweep.cpp
+ * @brief Estimates how hard each level is at each difficulty from many bot games
+ *
+ * Usage: difficulty_sweep [games_per_setting] [--threads N] [--max-seconds N] [--csv FILE] [--tuning FILE]
+ *
+ * The bot plays the given number of games (default 1000) on every level
+ * at every difficulty, spread over all cores. Games are cut off after
+ * --max-seconds (default 300) at speed 1, stretched by 1 / speed at each
+ * difficulty. Each level and difficulty reports its clear rate, how often
+ * the bot was caught, how often it was cut off, the mean score and game
+ * length, and the 10th/50th/90th percentile of the time survived in games
+ * that ended with Pac-Man caught. The levels are then ranked from easiest
+ * to hardest at each difficulty, by clears plus half the timeouts (the bot
+ * survived those but did not win). --csv writes every game
+ * (level, difficulty, seed, outcome, seconds, score) for closer study of
+ * the distributions. --tuning plays with the ghost constants and
+ * difficulty speeds of a file written by ghost_tuner instead of the
+ * game's own.
+ *
+ * Seeds depend only on the level, difficulty and game number, so a sweep
+ * gives the same figures however many threads it uses.
+ */
+
+using namespace GameConfig;
+
+/**
+ * Difficulty sweep configuration constants
+ */
+namespace SweepConfig
+{
+    constexpr int DEFAULT_GAMES_PER_SETTING = 1000;
+    constexpr int LEVEL_COUNT = 5;
+    constexpr double TIMEOUT_WEIGHT = 0.5; ///< How much of a clear a timed-out game counts for when ranking levels
+}
+
+namespace
+{
+    const char *outcome_name(BotGameOutcome outcome)
+    {
+        switch (outcome)
+        {
+        case BotGameOutcome::CAUGHT:
+            return "caught";
+        case BotGameOutcome::CLEARED:
+            return "cleared";
+        default:
+            return "timed_out";
+        }
+    }
+
+    /**
+     * @brief How easy a setting played: a clear counts 1, a timeout TIMEOUT_WEIGHT and being caught 0
+     */
+    double ease(const BotBatchSummary &summary)
+    {
+        return summary.clear_rate + SweepConfig::TIMEOUT_WEIGHT * summary.timed_out_rate;
+    }
+
+    /**
+     * @brief Whether level a is easier than level b: more ease, then longer survival when caught
+     */
+    bool easier(const BotBatchSummary &a, const BotBatchSummary &b)
+    {
+        if (ease(a) != ease(b))
+            return ease(a) > ease(b);
+        return a.survival_p50 > b.survival_p50;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int games = SweepConfig::DEFAULT_GAMES_PER_SETTING;
+    int max_seconds = BotGamesConfig::DEFAULT_MAX_SECONDS;
+    int thread_count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::string csv_path;
+    std::string tuning_path;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--threads" && i + 1 < argc)
+            thread_count = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--max-seconds" && i + 1 < argc)
+            max_seconds = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--csv" && i + 1 < argc)
+            csv_path = argv[++i];
+        else if (argument == "--tuning" && i + 1 < argc)
+            tuning_path = argv[++i];
+        else
+            games = std::max(1, std::atoi(argument.c_str()));
+    }
+
+    GhostTuning tuning;
+    if (!tuning_path.empty() && !load_ghost_tuning(tuning_path, tuning))
+    {
+        std::cerr << "Failed to load tuning " << tuning_path << "!" << std::endl;
+        return 1;
+    }
+
+    std::ofstream csv;
+    if (!csv_path.empty())
+    {
+        csv.open(csv_path);
+        if (!csv.is_open())
+        {
+            std::cerr << "Failed to open " << csv_path << "!" << std::endl;
+            return 1;
+        }
+        csv << "level,difficulty,seed,outcome,seconds,score\n";
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "level difficulty  clear%  caught%  timeout%  mean score  mean s  survival p10/p50/p90 s" << std::endl;
+
+    std::array<std::array<BotBatchSummary, DIFFICULTY_COUNT>, SweepConfig::LEVEL_COUNT> summaries;
+    const auto start = std::chrono::steady_clock::now();
+    for (int level = 1; level <= SweepConfig::LEVEL_COUNT; level++)
+    {
+        for (int difficulty = 0; difficulty < DIFFICULTY_COUNT; difficulty++)
+        {
+            BotBatch batch;
+            batch.level = level;
+            batch.settings.seed = static_cast<std::uint32_t>(1000000 * level + 100000 * difficulty + 1);
+            batch.settings.speed_multiplier = tuning.speed_multipliers[difficulty];
+            batch.settings.ghost_tuning = tuning;
+            batch.games = games;
+            batch.max_steps = bot_step_limit(max_seconds, batch.settings.speed_multiplier);
+
+            const std::vector<BotGameResult> results = play_bot_batch(batch, thread_count);
+            const BotBatchSummary summary = summarize_bot_batch(results);
+            summaries[level - 1][difficulty] = summary;
+
+            std::cout << std::setw(5) << level << " " << std::left << std::setw(10) << DIFFICULTY_NAMES[difficulty]
+                      << std::right << std::setw(7) << summary.clear_rate * 100.0 << std::setw(9)
+                      << summary.caught_rate * 100.0 << std::setw(10) << summary.timed_out_rate * 100.0
+                      << std::setw(12) << summary.mean_score << std::setw(8)
+                      << summary.mean_seconds << "  " << summary.survival_p10 << "/" << summary.survival_p50 << "/"
+                      << summary.survival_p90 << std::endl;
+
+            for (const BotGameResult &result : results)
+            {
+                if (csv.is_open())
+                {
+                    csv << level << "," << DIFFICULTY_NAMES[difficulty] << "," << result.seed << ","
+                        << outcome_name(result.outcome) << ","
+                        << static_cast<double>(result.steps) / SIMULATION_RATE << "," << result.score << "\n";
+                }
+            }
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Levels from easiest to hardest:" << std::endl;
+    for (int difficulty = 0; difficulty < DIFFICULTY_COUNT; difficulty++)
+    {
+        std::array<int, SweepConfig::LEVEL_COUNT> order;
+        for (int i = 0; i < SweepConfig::LEVEL_COUNT; i++)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&summaries, difficulty](int a, int b)
+                         { return easier(summaries[a][difficulty], summaries[b][difficulty]); });
+
+        std::cout << "  " << std::left << std::setw(8) << DIFFICULTY_NAMES[difficulty] << std::right;
+        for (int index : order)
+            std::cout << " " << index + 1;
+        std::cout << std::endl;
+    }
+
+    std::cout << "Played " << games * SweepConfig::LEVEL_COUNT * DIFFICULTY_COUNT << " games on " << thread_count
+              << " threads in " << seconds << " s" << std::endl;
+    return 0;
+}
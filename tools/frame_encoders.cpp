@@ -0,0 +1,322 @@
+#include "frame_encoders.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @file frame_encoders.cpp
+ * @brief Implementation of the GIF and YUV4MPEG2 frame encoders
+ */
+
+namespace
+{
+    constexpr int GIF_MAX_CODES = 4096; ///< LZW codes are at most 12 bits
+    constexpr int GIF_MAX_SUB_BLOCK = 255;
+
+    void append_u16_le(std::vector<unsigned char> &out, int value)
+    {
+        out.push_back(static_cast<unsigned char>(value & 0xFF));
+        out.push_back(static_cast<unsigned char>((value >> 8) & 0xFF));
+    }
+
+    /**
+     * Colour table and per-pixel indices of one GIF frame
+     */
+    struct IndexedFrame
+    {
+        std::vector<Pixel> palette;
+        std::vector<std::uint8_t> indices;
+        int bits = 1; ///< The table holds 2^bits entries
+    };
+
+    /**
+     * @brief Index a frame against its own colours, or a fixed 3-3-2 palette past 256 of them
+     */
+    IndexedFrame index_frame(const Canvas &frame)
+    {
+        const std::vector<Pixel> &pixels = frame.pixels();
+        IndexedFrame indexed;
+        indexed.indices.resize(pixels.size());
+
+        std::unordered_map<Pixel, std::uint8_t> lookup;
+        Pixel last_colour = 0;
+        std::uint8_t last_index = 0;
+        bool exact = true;
+        for (std::size_t i = 0; i < pixels.size() && exact; ++i)
+        {
+            // Frames are opaque, so alpha is ignored
+            Pixel colour = pixels[i] & 0x00FFFFFFu;
+            if (i > 0 && colour == last_colour)
+            {
+                indexed.indices[i] = last_index;
+                continue;
+            }
+
+            auto found = lookup.find(colour);
+            if (found == lookup.end())
+            {
+                if (indexed.palette.size() == 256)
+                {
+                    exact = false;
+                    break;
+                }
+                found = lookup.emplace(colour, static_cast<std::uint8_t>(indexed.palette.size())).first;
+                indexed.palette.push_back(colour);
+            }
+            last_colour = colour;
+            last_index = found->second;
+            indexed.indices[i] = last_index;
+        }
+
+        if (!exact)
+        {
+            indexed.palette.resize(256);
+            for (int i = 0; i < 256; ++i)
+            {
+                indexed.palette[i] = make_pixel(static_cast<std::uint8_t>((i >> 5) * 255 / 7),
+                                                static_cast<std::uint8_t>(((i >> 2) & 7) * 255 / 7),
+                                                static_cast<std::uint8_t>((i & 3) * 255 / 3), 255);
+            }
+            for (std::size_t i = 0; i < pixels.size(); ++i)
+            {
+                Pixel p = pixels[i];
+                indexed.indices[i] = static_cast<std::uint8_t>((pixel_r(p) >> 5) << 5 | (pixel_g(p) >> 5) << 2 | pixel_b(p) >> 6);
+            }
+        }
+
+        while ((1u << indexed.bits) < indexed.palette.size())
+        {
+            indexed.bits++;
+        }
+        return indexed;
+    }
+
+    /**
+     * Packs variable-width codes least significant bit first, as GIF requires
+     */
+    class CodeWriter
+    {
+    public:
+        void write(int code, int width)
+        {
+            buffer_ |= static_cast<std::uint32_t>(code) << bit_count_;
+            bit_count_ += width;
+            while (bit_count_ >= 8)
+            {
+                bytes_.push_back(static_cast<unsigned char>(buffer_ & 0xFF));
+                buffer_ >>= 8;
+                bit_count_ -= 8;
+            }
+        }
+
+        std::vector<unsigned char> finish()
+        {
+            if (bit_count_ > 0)
+            {
+                bytes_.push_back(static_cast<unsigned char>(buffer_ & 0xFF));
+            }
+            buffer_ = 0;
+            bit_count_ = 0;
+            return std::move(bytes_);
+        }
+
+    private:
+        std::vector<unsigned char> bytes_;
+        std::uint32_t buffer_ = 0;
+        int bit_count_ = 0;
+    };
+
+    /**
+     * @brief LZW-compress palette indices into a GIF code stream
+     */
+    std::vector<unsigned char> compress_lzw(const std::vector<std::uint8_t> &indices, int min_code_size)
+    {
+        const int clear_code = 1 << min_code_size;
+        const int end_code = clear_code + 1;
+
+        // children[prefix * 256 + index] is the code for prefix followed by index, 0 if unassigned
+        std::vector<std::uint16_t> children(GIF_MAX_CODES * 256, 0);
+        int code_size = min_code_size + 1;
+        int last_code = end_code;
+
+        CodeWriter writer;
+        writer.write(clear_code, code_size);
+        if (indices.empty())
+        {
+            writer.write(end_code, code_size);
+            return writer.finish();
+        }
+
+        int prefix = indices[0];
+        for (std::size_t i = 1; i < indices.size(); ++i)
+        {
+            std::uint16_t &child = children[prefix * 256 + indices[i]];
+            if (child != 0)
+            {
+                prefix = child;
+                continue;
+            }
+
+            writer.write(prefix, code_size);
+            child = static_cast<std::uint16_t>(++last_code);
+            if (last_code >= (1 << code_size))
+            {
+                code_size++;
+            }
+            if (last_code == GIF_MAX_CODES - 1)
+            {
+                writer.write(clear_code, code_size);
+                std::fill(children.begin(), children.end(), 0);
+                code_size = min_code_size + 1;
+                last_code = end_code;
+            }
+            prefix = indices[i];
+        }
+
+        writer.write(prefix, code_size);
+        writer.write(end_code, code_size);
+        return writer.finish();
+    }
+
+    std::uint8_t clamp_byte(double value)
+    {
+        return static_cast<std::uint8_t>(std::clamp(std::lround(value), 0L, 255L));
+    }
+}
+
+// ============== GIF ==============
+
+void write_gif_header(std::ostream &out, int width, int height)
+{
+    std::vector<unsigned char> bytes = {'G', 'I', 'F', '8', '9', 'a'};
+    append_u16_le(bytes, width);
+    append_u16_le(bytes, height);
+    bytes.push_back(0x00); // No global colour table: every frame has its own
+    bytes.push_back(0x00); // Background colour index
+    bytes.push_back(0x00); // Square pixels
+
+    // NETSCAPE2.0 application extension: loop forever
+    const std::string application = "NETSCAPE2.0";
+    bytes.push_back(0x21);
+    bytes.push_back(0xFF);
+    bytes.push_back(static_cast<unsigned char>(application.size()));
+    bytes.insert(bytes.end(), application.begin(), application.end());
+    bytes.push_back(0x03);
+    bytes.push_back(0x01);
+    append_u16_le(bytes, 0);
+    bytes.push_back(0x00);
+
+    out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+std::vector<unsigned char> encode_gif_frame(const Canvas &frame, int delay_centiseconds)
+{
+    IndexedFrame indexed = index_frame(frame);
+    std::vector<unsigned char> bytes;
+
+    // Graphic control extension: keep the frame in place, no transparency
+    bytes.push_back(0x21);
+    bytes.push_back(0xF9);
+    bytes.push_back(0x04);
+    bytes.push_back(0x04);
+    append_u16_le(bytes, delay_centiseconds);
+    bytes.push_back(0x00);
+    bytes.push_back(0x00);
+
+    // Image descriptor with a local colour table
+    bytes.push_back(0x2C);
+    append_u16_le(bytes, 0);
+    append_u16_le(bytes, 0);
+    append_u16_le(bytes, frame.width());
+    append_u16_le(bytes, frame.height());
+    bytes.push_back(static_cast<unsigned char>(0x80 | (indexed.bits - 1)));
+
+    const std::size_t table_size = std::size_t{1} << indexed.bits;
+    for (std::size_t i = 0; i < table_size; ++i)
+    {
+        Pixel colour = i < indexed.palette.size() ? indexed.palette[i] : 0;
+        bytes.push_back(pixel_r(colour));
+        bytes.push_back(pixel_g(colour));
+        bytes.push_back(pixel_b(colour));
+    }
+
+    const int min_code_size = std::max(2, indexed.bits);
+    std::vector<unsigned char> codes = compress_lzw(indexed.indices, min_code_size);
+    bytes.push_back(static_cast<unsigned char>(min_code_size));
+    for (std::size_t offset = 0; offset < codes.size(); offset += GIF_MAX_SUB_BLOCK)
+    {
+        std::size_t length = std::min<std::size_t>(GIF_MAX_SUB_BLOCK, codes.size() - offset);
+        bytes.push_back(static_cast<unsigned char>(length));
+        bytes.insert(bytes.end(), codes.begin() + offset, codes.begin() + offset + length);
+    }
+    bytes.push_back(0x00);
+    return bytes;
+}
+
+void write_gif_trailer(std::ostream &out)
+{
+    out.put(0x3B);
+}
+
+// ============== YUV4MPEG2 ==============
+
+void write_y4m_header(std::ostream &out, int width, int height, int fps)
+{
+    out << "YUV4MPEG2 W" << width << " H" << height << " F" << fps << ":1 Ip A1:1 C420jpeg\n";
+}
+
+std::vector<unsigned char> encode_y4m_frame(const Canvas &frame)
+{
+    const int width = frame.width();
+    const int height = frame.height();
+    const int chroma_width = (width + 1) / 2;
+    const int chroma_height = (height + 1) / 2;
+    const std::string marker = "FRAME\n";
+
+    std::vector<unsigned char> bytes(marker.begin(), marker.end());
+    const std::size_t luma_offset = bytes.size();
+    const std::size_t cb_offset = luma_offset + static_cast<std::size_t>(width) * height;
+    const std::size_t cr_offset = cb_offset + static_cast<std::size_t>(chroma_width) * chroma_height;
+    bytes.resize(cr_offset + static_cast<std::size_t>(chroma_width) * chroma_height);
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            Pixel p = frame.pixel_at(x, y);
+            bytes[luma_offset + static_cast<std::size_t>(y) * width + x] =
+                clamp_byte(0.299 * pixel_r(p) + 0.587 * pixel_g(p) + 0.114 * pixel_b(p));
+        }
+    }
+
+    // Chroma comes from the average colour of each 2x2 block
+    for (int cy = 0; cy < chroma_height; ++cy)
+    {
+        for (int cx = 0; cx < chroma_width; ++cx)
+        {
+            double r = 0.0, g = 0.0, b = 0.0;
+            int samples = 0;
+            for (int y = cy * 2; y < std::min(cy * 2 + 2, height); ++y)
+            {
+                for (int x = cx * 2; x < std::min(cx * 2 + 2, width); ++x)
+                {
+                    Pixel p = frame.pixel_at(x, y);
+                    r += pixel_r(p);
+                    g += pixel_g(p);
+                    b += pixel_b(p);
+                    samples++;
+                }
+            }
+            r /= samples;
+            g /= samples;
+            b /= samples;
+
+            std::size_t index = static_cast<std::size_t>(cy) * chroma_width + cx;
+            bytes[cb_offset + index] = clamp_byte(128.0 - 0.168736 * r - 0.331264 * g + 0.5 * b);
+            bytes[cr_offset + index] = clamp_byte(128.0 + 0.5 * r - 0.418688 * g - 0.081312 * b);
+        }
+    }
+    return bytes;
+}
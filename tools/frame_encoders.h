@@ -0,0 +1,49 @@
+#pragma once
+
+#include "software_rasterizer.h"
+#include <ostream>
+#include <vector>
+
+/**
+ * @file frame_encoders.h
+ * @brief Video encoders for frames rendered by the headless backend
+ *
+ * Each format is split into a header, independently encoded frames and a
+ * trailer so frames can be encoded on worker threads and written out in
+ * order by one thread.
+ *
+ * - GIF: animated GIF89a that loops forever. Every frame carries its own
+ *   colour table, exact when the frame has at most 256 colours (the game
+ *   nearly always does) and 3-3-2 quantised otherwise.
+ * - Y4M: YUV4MPEG2 in 4:2:0 with full-range BT.601 colours, readable by
+ *   ffmpeg and most video tools.
+ */
+
+/**
+ * @brief Write the GIF signature, screen descriptor and loop extension
+ */
+void write_gif_header(std::ostream &out, int width, int height);
+
+/**
+ * @brief Encode one frame as a GIF graphic control extension plus image
+ * @param frame Opaque frame the size given to write_gif_header
+ * @param delay_centiseconds How long the frame is shown
+ * @return Bytes to append to the file
+ */
+std::vector<unsigned char> encode_gif_frame(const Canvas &frame, int delay_centiseconds);
+
+/**
+ * @brief Write the GIF trailer that ends the file
+ */
+void write_gif_trailer(std::ostream &out);
+
+/**
+ * @brief Write the YUV4MPEG2 stream header
+ */
+void write_y4m_header(std::ostream &out, int width, int height, int fps);
+
+/**
+ * @brief Encode one frame as a YUV4MPEG2 FRAME record
+ * @return Bytes to append to the file
+ */
+std::vector<unsigned char> encode_y4m_frame(const Canvas &frame);
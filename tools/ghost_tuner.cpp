@@ -0,0 +1,317 @@
+#include "bot_games.h"
+#include "ghost_tuning.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file ghost_tuner.cpp
+ * @brief Searches for ghost constants and difficulty speeds that give the bot a target clear rate per difficulty
+ *
+ * Usage: ghost_tuner [games_per_setting] [--target NAME=RATE]... [--generations N] [--population N]
+ *                    [--start FILE] [--output FILE] [--seed N] [--threads N] [--max-seconds N]
+ *
+ * A candidate GhostTuning is scored by letting the bot play the given
+ * number of games (default 100) on every level at every difficulty, spread
+ * over all cores, and adding up the squared gap between each difficulty's
+ * clear rate and its target (by default easy 0.8, medium 0.6, hard 0.4,
+ * crazy 0.2). The bot wins only the games it clears. A game still going
+ * after --max-seconds (at speed 1, stretched by 1 / speed) is neither a
+ * win nor a loss: timeout rates are reported separately and add
+ * TIMEOUT_PENALTY times the rate to the error, so tunings where games
+ * stall do not pass for balanced ones. Every candidate plays the same seeds, so two
+ * candidates are compared on the same games and a score never changes on
+ * a second look.
+ *
+ * The search is a cross-entropy method: each generation samples candidates
+ * around a mean (the --start tuning, or the game's defaults, at first),
+ * with one spread per value, and moves the mean and spread to those of
+ * the best third. Values are searched within fixed bounds, scaled to 0-1.
+ * The best tuning seen is written to --output (default ghost_tuning.txt)
+ * at the start and whenever it improves, so an interrupted run still
+ * leaves its best result; difficulty_sweep --tuning plays it in full,
+ * and the game plays with it once copied to Resources/ghost_tuning.txt.
+ */
+
+using namespace GameConfig;
+
+/**
+ * Ghost tuner configuration constants
+ */
+namespace TunerConfig
+{
+    constexpr int DEFAULT_GAMES_PER_SETTING = 100;
+    constexpr int DEFAULT_GENERATIONS = 12;
+    constexpr int DEFAULT_POPULATION = 12;
+    constexpr const char *DEFAULT_OUTPUT = "ghost_tuning.txt";
+    constexpr double DEFAULT_TARGETS[DIFFICULTY_COUNT] = {0.8, 0.6, 0.4, 0.2}; ///< Clear rate wanted per difficulty
+    constexpr int LEVEL_COUNT = 5;
+    constexpr double TIMEOUT_PENALTY = 0.5; ///< Error added per difficulty for each unit of timed-out game fraction
+
+    constexpr double INITIAL_SPREAD = 0.15; ///< Starting standard deviation, as a fraction of each value's range
+    constexpr double MIN_SPREAD = 0.01;     ///< Spreads never shrink below this, so the search keeps moving
+    constexpr double SMOOTHING = 0.7;       ///< Weight of the best third when updating the mean and spread
+
+    /// Lowest and highest value searched, in GhostTuning value order (see ghost_tuning_value)
+    constexpr double LOWER[GHOST_TUNING_VALUE_COUNT] = {50.0, 50.0, 25.0, 0.5, 3.0, 0.5, 0.5, 0.5, 0.5, 0.5};
+    constexpr double UPPER[GHOST_TUNING_VALUE_COUNT] = {300.0, 400.0, 250.0, 5.0, 25.0, 8.0, 2.5, 2.5, 2.5, 2.5};
+}
+
+using Point = std::array<double, GHOST_TUNING_VALUE_COUNT>; ///< A tuning scaled to 0-1 per value
+
+namespace
+{
+    /**
+     * How each candidate is played
+     */
+    struct Evaluation
+    {
+        int games = TunerConfig::DEFAULT_GAMES_PER_SETTING;
+        std::array<double, DIFFICULTY_COUNT> targets;
+        int max_seconds = BotGamesConfig::DEFAULT_MAX_SECONDS; ///< Cutoff at speed 1 (see bot_step_limit)
+        int thread_count = 1;
+    };
+
+    /**
+     * A scored candidate
+     */
+    struct Candidate
+    {
+        Point point{};
+        GhostTuning tuning;
+        std::array<double, DIFFICULTY_COUNT> clear_rates{};
+        std::array<double, DIFFICULTY_COUNT> timed_out_rates{};
+        double error = 0.0; ///< Sum over difficulties of (clear rate - target)^2 + TIMEOUT_PENALTY * timed-out rate
+    };
+
+    Point to_point(const GhostTuning &tuning)
+    {
+        Point point;
+        for (int i = 0; i < GHOST_TUNING_VALUE_COUNT; i++)
+        {
+            const double range = TunerConfig::UPPER[i] - TunerConfig::LOWER[i];
+            point[i] = std::clamp((ghost_tuning_value(tuning, i) - TunerConfig::LOWER[i]) / range, 0.0, 1.0);
+        }
+        return point;
+    }
+
+    GhostTuning to_tuning(const Point &point)
+    {
+        GhostTuning tuning;
+        for (int i = 0; i < GHOST_TUNING_VALUE_COUNT; i++)
+        {
+            const double range = TunerConfig::UPPER[i] - TunerConfig::LOWER[i];
+            ghost_tuning_value(tuning, i) = TunerConfig::LOWER[i] + point[i] * range;
+        }
+        return tuning;
+    }
+
+    /**
+     * @brief Play the evaluation's games with a candidate's tuning and score it
+     */
+    void evaluate(const Evaluation &evaluation, Candidate &candidate)
+    {
+        candidate.error = 0.0;
+        for (int difficulty = 0; difficulty < DIFFICULTY_COUNT; difficulty++)
+        {
+            double clear_rate = 0.0;
+            double timed_out_rate = 0.0;
+            for (int level = 1; level <= TunerConfig::LEVEL_COUNT; level++)
+            {
+                BotBatch batch;
+                batch.level = level;
+                batch.settings.seed = static_cast<std::uint32_t>(1000000 * level + 100000 * difficulty + 1);
+                batch.settings.speed_multiplier = candidate.tuning.speed_multipliers[difficulty];
+                batch.settings.ghost_tuning = candidate.tuning;
+                batch.games = evaluation.games;
+                batch.max_steps = bot_step_limit(evaluation.max_seconds, batch.settings.speed_multiplier);
+                const BotBatchSummary summary = summarize_bot_batch(play_bot_batch(batch, evaluation.thread_count));
+                clear_rate += summary.clear_rate;
+                timed_out_rate += summary.timed_out_rate;
+            }
+            clear_rate /= TunerConfig::LEVEL_COUNT;
+            timed_out_rate /= TunerConfig::LEVEL_COUNT;
+
+            const double gap = clear_rate - evaluation.targets[difficulty];
+            candidate.clear_rates[difficulty] = clear_rate;
+            candidate.timed_out_rates[difficulty] = timed_out_rate;
+            candidate.error += gap * gap + TunerConfig::TIMEOUT_PENALTY * timed_out_rate;
+        }
+    }
+
+    /**
+     * @brief Parse NAME=RATE into targets
+     * @return false if the difficulty name is unknown or the rate is not within 0-1
+     */
+    bool parse_target(const std::string &argument, std::array<double, DIFFICULTY_COUNT> &targets)
+    {
+        const std::size_t equals = argument.find('=');
+        if (equals == std::string::npos)
+            return false;
+
+        const std::string name = argument.substr(0, equals);
+        const double rate = std::atof(argument.c_str() + equals + 1);
+        for (int difficulty = 0; difficulty < DIFFICULTY_COUNT; difficulty++)
+        {
+            if (name == DIFFICULTY_NAMES[difficulty] && rate >= 0.0 && rate <= 1.0)
+            {
+                targets[difficulty] = rate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void print_candidate(const Candidate &candidate)
+    {
+        std::cout << "error " << std::setprecision(4) << candidate.error << "  clear%" << std::setprecision(1);
+        for (double rate : candidate.clear_rates)
+            std::cout << " " << rate * 100.0;
+        std::cout << "  timeout%";
+        for (double rate : candidate.timed_out_rates)
+            std::cout << " " << rate * 100.0;
+        std::cout << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Evaluation evaluation;
+    std::copy(std::begin(TunerConfig::DEFAULT_TARGETS), std::end(TunerConfig::DEFAULT_TARGETS),
+              evaluation.targets.begin());
+    evaluation.thread_count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int generations = TunerConfig::DEFAULT_GENERATIONS;
+    int population = TunerConfig::DEFAULT_POPULATION;
+    std::uint32_t seed = 1;
+    std::string start_path;
+    std::string output_path = TunerConfig::DEFAULT_OUTPUT;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--target" && i + 1 < argc)
+        {
+            if (!parse_target(argv[++i], evaluation.targets))
+            {
+                std::cerr << "Bad target " << argv[i] << " (expected NAME=RATE, e.g. hard=0.4)" << std::endl;
+                return 1;
+            }
+        }
+        else if (argument == "--generations" && i + 1 < argc)
+            generations = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--population" && i + 1 < argc)
+            population = std::max(3, std::atoi(argv[++i]));
+        else if (argument == "--start" && i + 1 < argc)
+            start_path = argv[++i];
+        else if (argument == "--output" && i + 1 < argc)
+            output_path = argv[++i];
+        else if (argument == "--seed" && i + 1 < argc)
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (argument == "--threads" && i + 1 < argc)
+            evaluation.thread_count = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--max-seconds" && i + 1 < argc)
+            evaluation.max_seconds = std::max(1, std::atoi(argv[++i]));
+        else
+            evaluation.games = std::max(1, std::atoi(argument.c_str()));
+    }
+
+    GhostTuning start;
+    if (!start_path.empty() && !load_ghost_tuning(start_path, start))
+    {
+        std::cerr << "Failed to load tuning " << start_path << "!" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << "Targets (clear%):";
+    for (int difficulty = 0; difficulty < DIFFICULTY_COUNT; difficulty++)
+        std::cout << " " << DIFFICULTY_NAMES[difficulty] << "=" << std::setprecision(1)
+                  << evaluation.targets[difficulty] * 100.0;
+    std::cout << std::endl;
+
+    const auto start_time = std::chrono::steady_clock::now();
+    Candidate best;
+    best.point = to_point(start);
+    best.tuning = start;
+    evaluate(evaluation, best);
+    std::cout << "start         ";
+    print_candidate(best);
+    if (!save_ghost_tuning(output_path, best.tuning))
+    {
+        std::cerr << "Failed to write " << output_path << "!" << std::endl;
+        return 1;
+    }
+
+    Point mean = best.point;
+    Point spread;
+    spread.fill(TunerConfig::INITIAL_SPREAD);
+    const int elite_count = std::max(2, population / 3);
+    std::mt19937 random(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    int evaluated = 1;
+
+    for (int generation = 1; generation <= generations; generation++)
+    {
+        std::vector<Candidate> candidates(population);
+        for (Candidate &candidate : candidates)
+        {
+            for (int i = 0; i < GHOST_TUNING_VALUE_COUNT; i++)
+                candidate.point[i] = std::clamp(mean[i] + spread[i] * normal(random), 0.0, 1.0);
+            candidate.tuning = to_tuning(candidate.point);
+            evaluate(evaluation, candidate);
+            evaluated++;
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate &a, const Candidate &b) { return a.error < b.error; });
+
+        // Move the search towards the best third, keeping some of the old mean and spread so it does not collapse
+        for (int i = 0; i < GHOST_TUNING_VALUE_COUNT; i++)
+        {
+            double elite_mean = 0.0;
+            for (int e = 0; e < elite_count; e++)
+                elite_mean += candidates[e].point[i];
+            elite_mean /= elite_count;
+
+            double elite_variance = 0.0;
+            for (int e = 0; e < elite_count; e++)
+                elite_variance += (candidates[e].point[i] - elite_mean) * (candidates[e].point[i] - elite_mean);
+            elite_variance /= elite_count;
+
+            mean[i] = TunerConfig::SMOOTHING * elite_mean + (1.0 - TunerConfig::SMOOTHING) * mean[i];
+            spread[i] = std::max(TunerConfig::MIN_SPREAD, TunerConfig::SMOOTHING * std::sqrt(elite_variance) +
+                                                              (1.0 - TunerConfig::SMOOTHING) * spread[i]);
+        }
+
+        std::cout << "generation " << std::setw(2) << generation << " ";
+        print_candidate(candidates[0]);
+
+        if (candidates[0].error < best.error)
+        {
+            best = candidates[0];
+            if (!save_ghost_tuning(output_path, best.tuning))
+            {
+                std::cerr << "Failed to write " << output_path << "!" << std::endl;
+                return 1;
+            }
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    std::cout << "Best tuning (" << output_path << "):" << std::endl;
+    std::cout << std::setprecision(3);
+    for (int i = 0; i < GHOST_TUNING_VALUE_COUNT; i++)
+        std::cout << "  " << std::left << std::setw(24) << ghost_tuning_value_name(i) << std::right
+                  << ghost_tuning_value(best.tuning, i) << std::endl;
+    std::cout << "  ";
+    print_candidate(best);
+    std::cout << std::setprecision(1) << "Evaluated " << evaluated << " tunings ("
+              << static_cast<long long>(evaluated) * evaluation.games * TunerConfig::LEVEL_COUNT * DIFFICULTY_COUNT
+              << " games) on " << evaluation.thread_count << " threads in " << seconds << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "danger_map.h"
+#include "game_config.h"
+#include "headless.h"
+#include "render_snapshot.h"
+#include "scene_renderer.h"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @file heatmap_render.cpp
+ * @brief Draws a heat grid over its level's maze and saves the picture as a PNG
+ *
+ * Usage: heatmap_render <level> <heatmap.csv> <output.png>
+ *
+ * Built against the headless backend. The level is drawn as the game draws
+ * it at the start (walls and pellets, no characters), then each cell is
+ * shaded in proportion to its count in the CSV, such as a
+ * level<N>_deaths.csv written by danger_sweep.
+ */
+
+using namespace GameConfig;
+
+int main(int argc, char *argv[])
+{
+    if (argc != 4)
+    {
+        std::cerr << "Usage: heatmap_render <level> <heatmap.csv> <output.png>" << std::endl;
+        return 1;
+    }
+
+    const int level = std::atoi(argv[1]);
+    if (level < 1 || level > 5)
+    {
+        std::cerr << "Level must be 1-5" << std::endl;
+        return 1;
+    }
+
+    HeatGrid grid;
+    if (!load_heat_grid(argv[2], grid))
+    {
+        std::cerr << "Failed to load heat grid " << argv[2] << "!" << std::endl;
+        return 1;
+    }
+
+    const Maze maze(level);
+    GameState game_state;
+    maze.initialize_tokens(game_state, -1, -1);
+    maze.initialize_power_pellets(game_state);
+
+    SpriteSheet sprite_sheet(SPRITESHEET_NAME, SPRITESHEET_PATH, 16, 16, 4, 3, 1, 2);
+    TextRenderer text_renderer;
+    SceneRenderer scene_renderer(sprite_sheet, text_renderer);
+    bitmap target = create_bitmap(WINDOW_WIDTH, WINDOW_HEIGHT);
+    set_render_target(target);
+
+    RenderSnapshot snapshot;
+    snapshot.total_tokens = game_state.get_total_tokens();
+    scene_renderer.reset(maze, game_state);
+    scene_renderer.draw(snapshot);
+    scene_renderer.draw_heatmap(grid);
+
+    const bool saved = save_png(argv[3], *headless_bitmap_canvas(target));
+    set_render_target(nullptr);
+    free_bitmap(target);
+    if (!saved)
+    {
+        std::cerr << "Failed to write " << argv[3] << "!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
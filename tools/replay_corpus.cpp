@@ -0,0 +1,153 @@
+#include "bot.h"
+#include "game_random.h"
+#include "game_config.h"
+#include "replay.h"
+#include "replay_player.h"
+#include "simulation.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+/**
+ * @file replay_corpus.cpp
+ * @brief Records the replay corpus used to train profile-guided builds
+ *
+ * Usage: replay_corpus [output_dir] [games_per_setting] [max_seconds]
+ *
+ * Plays games on every level at every difficulty and writes each one as a
+ * replay, by default to Resources/Replays. Pac-Man is steered by the bot,
+ * but through key presses shaped like a player's: a direction is pressed
+ * when the bot wants to turn, held for a short, varying time once the turn
+ * is taken, and released. Replays therefore go through the same buffered
+ * turn and release paths as real sessions, and the corpus can be topped up
+ * with players' own Resources/last_replay.txt files.
+ *
+ * Seeds are fixed and every random choice comes from GameRandom, so running
+ * the tool again reproduces the same corpus with any standard library.
+ */
+
+using namespace GameConfig;
+
+/**
+ * Corpus configuration constants
+ */
+namespace CorpusConfig
+{
+    constexpr const char *DEFAULT_OUTPUT_DIR = "Resources/Replays";
+    constexpr int DEFAULT_GAMES_PER_SETTING = 1;
+    constexpr int DEFAULT_MAX_SECONDS = 120;   ///< Games the bot neither wins nor loses are cut off here
+    constexpr std::uint32_t START_TICK = 252;  ///< Length of the start jingle at 60 Hz
+    constexpr int MIN_HOLD_TICKS = 4;          ///< Shortest time a key stays down after its turn is taken
+    constexpr int MAX_HOLD_TICKS = 30;         ///< Longest time a key stays down after its turn is taken
+    constexpr std::uint32_t MIN_PRESS_GAP = 6; ///< Ticks between key changes, about a player's reaction time
+}
+
+namespace
+{
+    /**
+     * @brief Record one bot-played game into a replay
+     * The replay grows as the game is played and is stepped by a ReplayPlayer,
+     * so it plays back exactly as it was recorded.
+     */
+    Replay record_game(int level, double speed_multiplier, std::uint32_t seed, std::uint32_t max_ticks)
+    {
+        Replay replay;
+        replay.seed = seed;
+        replay.level = level;
+        replay.speed_multiplier = speed_multiplier;
+        replay.palette = PACMAN_PALETTE;
+        replay.tick_count = max_ticks;
+        replay.events.push_back({CorpusConfig::START_TICK, ReplayEventType::START, DIR_NONE});
+
+        Simulation simulation;
+        ReplayPlayer player(simulation);
+        PacmanBot bot;
+        GameRandom keys(seed);
+        const auto hold_ticks = [&keys]()
+        {
+            const std::uint32_t range = CorpusConfig::MAX_HOLD_TICKS - CorpusConfig::MIN_HOLD_TICKS + 1;
+            return CorpusConfig::MIN_HOLD_TICKS + static_cast<int>(keys.next() % range);
+        };
+        player.start(replay);
+
+        direction_t held = DIR_NONE;
+        int hold_left = 0;
+        std::uint32_t last_change = 0;
+        while (true)
+        {
+            const std::uint32_t tick = player.get_tick();
+            if (tick > CorpusConfig::START_TICK && tick >= last_change + CorpusConfig::MIN_PRESS_GAP)
+            {
+                Pacman &pacman = simulation.get_pacman();
+                const direction_t wanted = bot.choose_direction(simulation.get_maze(), simulation.get_game_state(),
+                                                                simulation.get_world(), pacman.get_id());
+                const direction_t moving = pacman.get_direction();
+
+                direction_t change = held;
+                if (wanted != DIR_NONE && wanted != held && !(held == DIR_NONE && wanted == moving))
+                {
+                    change = wanted;
+                    hold_left = hold_ticks();
+                }
+                else if (held != DIR_NONE && moving == held && --hold_left <= 0)
+                {
+                    change = DIR_NONE;
+                }
+
+                if (change != held)
+                {
+                    replay.events.push_back({tick, ReplayEventType::INPUT, change});
+                    held = change;
+                    last_change = tick;
+                }
+            }
+
+            if (!player.step())
+                break;
+        }
+
+        replay.tick_count = player.get_tick();
+        return replay;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::filesystem::path output = argc > 1 ? argv[1] : CorpusConfig::DEFAULT_OUTPUT_DIR;
+    const int games = argc > 2 ? std::max(1, std::atoi(argv[2])) : CorpusConfig::DEFAULT_GAMES_PER_SETTING;
+    const int max_seconds = argc > 3 ? std::max(1, std::atoi(argv[3])) : CorpusConfig::DEFAULT_MAX_SECONDS;
+    const std::uint32_t max_ticks = CorpusConfig::START_TICK + static_cast<std::uint32_t>(max_seconds) * SIMULATION_RATE;
+
+    std::error_code error;
+    std::filesystem::create_directories(output, error);
+
+    int written = 0;
+    for (int level = 1; level <= 5; level++)
+    {
+        for (int difficulty = 0; difficulty < DIFFICULTY_COUNT; difficulty++)
+        {
+            for (int game = 0; game < games; game++)
+            {
+                const std::uint32_t seed = static_cast<std::uint32_t>(1000 * level + 100 * difficulty + game + 1);
+                const Replay replay = record_game(level, DIFFICULTY_SPEED_MULTIPLIERS[difficulty], seed, max_ticks);
+
+                const std::string name = "level" + std::to_string(level) + "_" +
+                                         DIFFICULTY_NAMES[difficulty] + "_" + std::to_string(game + 1) +
+                                         ".txt";
+                if (!save_replay((output / name).string(), replay))
+                {
+                    std::cerr << "Failed to write " << (output / name) << "!" << std::endl;
+                    return 1;
+                }
+                std::cout << name << ": " << replay.tick_count << " ticks, " << replay.events.size() << " events"
+                          << std::endl;
+                written++;
+            }
+        }
+    }
+
+    std::cout << "Recorded " << written << " replays to " << output << std::endl;
+    return 0;
+}
@@ -0,0 +1,332 @@
+#include "frame_encoders.h"
+#include "game.h"
+#include "headless.h"
+#include "replay.h"
+#include "scene_renderer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file replay_export.cpp
+ * @brief Renders a recorded game to an animated GIF, a Y4M video or a PNG sequence
+ *
+ * Usage: replay_export <replay> <output> [gif|y4m|png] [fps] [threads]
+ *
+ * Built against the headless backend (see README). The replay is first
+ * simulated tick by tick, keeping every render snapshot. Frames are then
+ * drawn from those snapshots by worker threads, each with its own
+ * SceneRenderer and render target, and encoded on the same thread. Only
+ * writing the file is sequential, so export runs as fast as the cores
+ * allow rather than in real time. For PNG, output names a directory that
+ * receives frame_00000.png, frame_00001.png, ...
+ */
+
+using namespace GameConfig;
+
+/**
+ * Export configuration constants
+ */
+namespace ExportConfig
+{
+    constexpr int DEFAULT_GIF_FPS = 20;          ///< GIF delays are in centiseconds, so 60 fps cannot be shown exactly
+    constexpr std::size_t FRAMES_PER_THREAD = 4; ///< Encoded frames allowed to wait for the writer, per worker
+}
+
+/**
+ * Output formats
+ */
+enum class ExportFormat
+{
+    GIF,
+    Y4M,
+    PNG
+};
+
+/**
+ * The level being played from a given tick on
+ */
+struct SceneRecord
+{
+    std::size_t first_tick; ///< First snapshot drawn from this scene
+    Maze maze;
+    GameState game_state; ///< Pellet positions; collected flags are caught up from the snapshots
+};
+
+/**
+ * Everything the workers draw from: read-only once simulation has finished
+ */
+struct Recording
+{
+    std::vector<RenderSnapshot> snapshots; ///< One per simulated tick
+    std::vector<SceneRecord> scenes;       ///< In tick order
+};
+
+/**
+ * Encoded frames waiting to be written, in a ring of slots indexed by frame number
+ */
+struct FrameQueue
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::vector<unsigned char>> slots;
+    std::vector<bool> ready;
+    std::size_t written = 0; ///< Frames handed to the writer so far
+};
+
+/**
+ * Settings shared by every worker
+ */
+struct ExportJob
+{
+    ExportFormat format = ExportFormat::GIF;
+    std::filesystem::path output;
+    int ticks_per_frame = 1;
+    int delay_centiseconds = 2;
+    std::size_t frame_count = 0;
+};
+
+namespace
+{
+    /**
+     * @brief Simulate a replay to the end, keeping every snapshot and each level's starting state
+     */
+    Recording record_replay(Game &game, const Replay &replay)
+    {
+        Recording recording;
+        recording.snapshots.reserve(replay.tick_count);
+        game.start_replay(replay);
+
+        std::uint32_t scene = 0;
+        while (game.step_replay())
+        {
+            const RenderSnapshot &snapshot = game.replay_snapshot();
+            if (recording.scenes.empty() || snapshot.scene != scene)
+            {
+                scene = snapshot.scene;
+                recording.scenes.push_back({recording.snapshots.size(), game.get_maze(), game.get_game_state()});
+            }
+            recording.snapshots.push_back(snapshot);
+        }
+        return recording;
+    }
+
+    std::filesystem::path png_frame_path(const std::filesystem::path &directory, std::size_t frame)
+    {
+        std::ostringstream name;
+        name << "frame_" << std::setw(5) << std::setfill('0') << frame << ".png";
+        return directory / name.str();
+    }
+
+    /**
+     * @brief Draw and encode every thread_count-th frame, starting at first_frame
+     */
+    void render_frames(const Recording &recording, const ExportJob &job, FrameQueue &queue,
+                       std::size_t first_frame, std::size_t thread_count)
+    {
+        // Render targets are per thread in the headless backend, so each worker draws into its own bitmap
+        SpriteSheet sprite_sheet(SPRITESHEET_NAME, SPRITESHEET_PATH, 16, 16, 4, 3, 1, 2);
+        TextRenderer text_renderer;
+        SceneRenderer scene_renderer(sprite_sheet, text_renderer);
+        bitmap target = create_bitmap(WINDOW_WIDTH, WINDOW_HEIGHT);
+        set_render_target(target);
+
+        std::size_t scene_index = 0;
+        std::size_t next_tick = 0; ///< First snapshot whose pellets are not yet applied
+        bool scene_ready = false;
+        const std::size_t window = queue.slots.size();
+
+        for (std::size_t frame = first_frame; frame < job.frame_count; frame += thread_count)
+        {
+            {
+                // Stay within the ring: the slot is free once the writer has taken frame - window
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.changed.wait(lock, [&] { return frame < queue.written + window; });
+            }
+
+            const std::size_t tick = frame * job.ticks_per_frame;
+            while (scene_index + 1 < recording.scenes.size() && recording.scenes[scene_index + 1].first_tick <= tick)
+            {
+                scene_index++;
+                scene_ready = false;
+            }
+            if (!scene_ready)
+            {
+                const SceneRecord &scene = recording.scenes[scene_index];
+                scene_renderer.reset(scene.maze, scene.game_state);
+                next_tick = scene.first_tick;
+                scene_ready = true;
+            }
+            for (; next_tick < tick; ++next_tick)
+            {
+                scene_renderer.apply_collected(recording.snapshots[next_tick]);
+            }
+            scene_renderer.draw(recording.snapshots[tick]);
+            next_tick = tick + 1;
+
+            const Canvas &canvas = *headless_bitmap_canvas(target);
+            std::vector<unsigned char> encoded;
+            switch (job.format)
+            {
+            case ExportFormat::GIF:
+                encoded = encode_gif_frame(canvas, job.delay_centiseconds);
+                break;
+            case ExportFormat::Y4M:
+                encoded = encode_y4m_frame(canvas);
+                break;
+            case ExportFormat::PNG:
+                if (!save_png(png_frame_path(job.output, frame).string(), canvas))
+                {
+                    std::cerr << "Failed to write frame " << frame << "!" << std::endl;
+                }
+                break;
+            }
+
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.slots[frame % window] = std::move(encoded);
+            queue.ready[frame % window] = true;
+            queue.changed.notify_all();
+        }
+
+        set_render_target(nullptr);
+        free_bitmap(target);
+    }
+
+    bool parse_format(const std::string &name, ExportFormat &format)
+    {
+        if (name == "gif")
+            format = ExportFormat::GIF;
+        else if (name == "y4m")
+            format = ExportFormat::Y4M;
+        else if (name == "png")
+            format = ExportFormat::PNG;
+        else
+            return false;
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <replay> <output> [gif|y4m|png] [fps] [threads]" << std::endl;
+        return 1;
+    }
+
+    ExportJob job;
+    job.output = argv[2];
+    if (argc > 3 && !parse_format(argv[3], job.format))
+    {
+        std::cerr << "Unknown format: " << argv[3] << std::endl;
+        return 1;
+    }
+
+    // Frames are whole simulation ticks apart, so the rate is rounded to a divisor of SIMULATION_RATE
+    int fps = job.format == ExportFormat::GIF ? ExportConfig::DEFAULT_GIF_FPS : SIMULATION_RATE;
+    if (argc > 4)
+        fps = std::clamp(std::atoi(argv[4]), 1, SIMULATION_RATE);
+    job.ticks_per_frame = std::max(1, SIMULATION_RATE / fps);
+    fps = SIMULATION_RATE / job.ticks_per_frame;
+    job.delay_centiseconds = (100 + fps / 2) / fps;
+
+    std::size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 5)
+        thread_count = static_cast<std::size_t>(std::max(1, std::atoi(argv[5])));
+
+    Replay replay;
+    if (!load_replay(argv[1], replay))
+    {
+        std::cerr << "Failed to load replay " << argv[1] << "!" << std::endl;
+        return 1;
+    }
+
+    // Nothing waits on the clock, so simulate as fast as possible
+    headless_use_virtual_clock(true);
+    Game game;
+    if (!game.initialize())
+    {
+        std::cerr << "Failed to initialize game!" << std::endl;
+        return 1;
+    }
+
+    const Recording recording = record_replay(game, replay);
+    if (recording.snapshots.empty())
+    {
+        std::cerr << "Replay has no ticks to render!" << std::endl;
+        return 1;
+    }
+    job.frame_count = (recording.snapshots.size() + job.ticks_per_frame - 1) / job.ticks_per_frame;
+
+    std::ofstream file;
+    if (job.format == ExportFormat::PNG)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(job.output, error);
+    }
+    else
+    {
+        file.open(job.output, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to open " << job.output << "!" << std::endl;
+            return 1;
+        }
+        if (job.format == ExportFormat::GIF)
+            write_gif_header(file, WINDOW_WIDTH, WINDOW_HEIGHT);
+        else
+            write_y4m_header(file, WINDOW_WIDTH, WINDOW_HEIGHT, fps);
+    }
+
+    FrameQueue queue;
+    queue.slots.resize(thread_count * ExportConfig::FRAMES_PER_THREAD);
+    queue.ready.assign(queue.slots.size(), false);
+
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < thread_count; ++i)
+    {
+        workers.emplace_back(render_frames, std::cref(recording), std::cref(job), std::ref(queue), i, thread_count);
+    }
+
+    // Write frames in order as they finish
+    for (std::size_t frame = 0; frame < job.frame_count; ++frame)
+    {
+        std::vector<unsigned char> encoded;
+        {
+            std::unique_lock<std::mutex> lock(queue.mutex);
+            const std::size_t slot = frame % queue.slots.size();
+            queue.changed.wait(lock, [&] { return queue.ready[slot]; });
+            encoded = std::move(queue.slots[slot]);
+            queue.ready[slot] = false;
+            queue.written++;
+            queue.changed.notify_all();
+        }
+        file.write(reinterpret_cast<const char *>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+    }
+
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    if (job.format == ExportFormat::GIF)
+        write_gif_trailer(file);
+    if (job.format != ExportFormat::PNG && !file)
+    {
+        std::cerr << "Failed to write " << job.output << "!" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Rendered " << job.frame_count << " frames at " << fps << " fps on " << thread_count
+              << " threads to " << job.output << std::endl;
+    return 0;
+}
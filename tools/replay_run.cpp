@@ -0,0 +1,224 @@
+#include "alloc_tracker.h"
+#include "analytics.h"
+#include "replay.h"
+#include "replay_player.h"
+#include "simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file replay_run.cpp
+ * @brief Plays recorded games headlessly, as fast as the simulation allows
+ *
+ * Usage: replay_run [replay or directory]... [--repeat N] [--allocs] [--assert-no-alloc]
+ *                   [--analytics FILE]
+ *
+ * Every replay named, or found in a named directory, is re-simulated
+ * through a ReplayPlayer; with no arguments the corpus in
+ * Resources/Replays is played. Nothing is drawn and no SplashKit backend
+ * is linked. This is the training workload of the profile-guided build
+ * (see cmake/pgo.cmake) and reports simulation throughput on real games.
+ *
+ * In a build configured with PACMAN_ALLOC_TRACKING, --allocs reports the
+ * heap allocations of every level load and of the ticks in between, by
+ * subsystem, and --assert-no-alloc aborts on the first allocation made
+ * inside a simulation tick.
+ *
+ * --analytics writes the gameplay events of the first pass to an event
+ * file (see analytics.h), one game per replay.
+ */
+
+/**
+ * Replay runner configuration constants
+ */
+namespace ReplayRunConfig
+{
+    constexpr const char *DEFAULT_CORPUS = "Resources/Replays";
+}
+
+namespace
+{
+    /**
+     * @brief Add a replay file, or every .txt file in a directory, in name order
+     */
+    void collect_replays(const std::filesystem::path &path, std::vector<std::filesystem::path> &replays)
+    {
+        if (!std::filesystem::is_directory(path))
+        {
+            replays.push_back(path);
+            return;
+        }
+
+        std::vector<std::filesystem::path> found;
+        for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(path))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".txt")
+                found.push_back(entry.path());
+        }
+        std::sort(found.begin(), found.end());
+        replays.insert(replays.end(), found.begin(), found.end());
+    }
+
+    /**
+     * @brief Print allocation counts and bytes, followed by the subsystems that made them
+     */
+    void print_allocations(const AllocStats &stats)
+    {
+        std::cout << stats.total_count() << " allocs, " << stats.total_bytes() << " bytes";
+        const char *separator = " (";
+        for (int tag = 0; tag < ALLOC_TAG_COUNT; tag++)
+        {
+            if (stats.count[tag] != 0)
+            {
+                std::cout << separator << alloc_tag_name(static_cast<AllocTag>(tag)) << " " << stats.count[tag] << "/"
+                          << stats.bytes[tag] << "B";
+                separator = ", ";
+            }
+        }
+        std::cout << (separator[0] == ',' ? ")" : "") << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::filesystem::path> paths;
+    int repeat = 1;
+    bool report_allocations = false;
+    bool assert_no_allocations = false;
+    std::string analytics_path;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--repeat" && i + 1 < argc)
+            repeat = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--allocs")
+            report_allocations = true;
+        else if (argument == "--assert-no-alloc")
+            assert_no_allocations = true;
+        else if (argument == "--analytics" && i + 1 < argc)
+            analytics_path = argv[++i];
+        else
+            collect_replays(argument, paths);
+    }
+    if (paths.empty())
+        collect_replays(ReplayRunConfig::DEFAULT_CORPUS, paths);
+
+    if ((report_allocations || assert_no_allocations) && !AllocTracker::ENABLED)
+    {
+        std::cerr << "Allocation tracking needs a build configured with -DPACMAN_ALLOC_TRACKING=ON" << std::endl;
+        return 1;
+    }
+    AllocTracker::set_tick_assertions(assert_no_allocations);
+
+    std::vector<Replay> replays;
+    for (const std::filesystem::path &path : paths)
+    {
+        Replay replay;
+        if (!load_replay(path.string(), replay))
+        {
+            std::cerr << "Failed to load replay " << path << "!" << std::endl;
+            return 1;
+        }
+        replays.push_back(replay);
+    }
+    if (replays.empty())
+    {
+        std::cerr << "No replays to play!" << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<AnalyticsLog> analytics;
+    if (!analytics_path.empty())
+    {
+        analytics = std::make_unique<AnalyticsLog>(analytics_path);
+        if (!analytics->is_open())
+        {
+            std::cerr << "Failed to open analytics file " << analytics_path << "!" << std::endl;
+            return 1;
+        }
+    }
+
+    Simulation simulation;
+    simulation.set_analytics(analytics.get());
+    ReplayPlayer player(simulation);
+    std::uint64_t total_ticks = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int pass = 0; pass < repeat; pass++)
+    {
+        for (std::size_t i = 0; i < replays.size(); i++)
+        {
+            const bool track = report_allocations && pass == 0;
+            AllocStats before = AllocTracker::snapshot();
+            player.start(replays[i]);
+            AllocStats level_load = AllocTracker::snapshot() - before;
+
+            if (!track)
+            {
+                while (player.step())
+                {
+                }
+            }
+            else
+            {
+                // A change of level means the step loaded the next one; every other step is a steady tick
+                AllocStats ticks;
+                std::uint64_t ticks_allocating = 0;
+                std::uint64_t most_in_a_tick = 0;
+                std::vector<AllocStats> level_loads = {level_load};
+                int level = player.get_level();
+                for (before = AllocTracker::snapshot(); player.step(); before = AllocTracker::snapshot())
+                {
+                    const AllocStats tick = AllocTracker::snapshot() - before;
+                    if (player.get_level() != level)
+                    {
+                        level = player.get_level();
+                        level_loads.push_back(tick);
+                        continue;
+                    }
+                    ticks += tick;
+                    ticks_allocating += tick.total_count() != 0 ? 1 : 0;
+                    most_in_a_tick = std::max(most_in_a_tick, tick.total_count());
+                }
+
+                std::cout << paths[i].filename().string() << " allocations:" << std::endl;
+                for (const AllocStats &load : level_loads)
+                {
+                    std::cout << "  level load: ";
+                    print_allocations(load);
+                }
+                std::cout << "  ticks: ";
+                print_allocations(ticks);
+                std::cout << "  " << ticks_allocating << " of " << player.get_tick()
+                          << " ticks allocated, at most " << most_in_a_tick << " in one tick" << std::endl;
+            }
+            total_ticks += player.get_tick();
+            if (pass == 0 && i + 1 == replays.size())
+                simulation.set_analytics(nullptr);
+
+            if (pass == 0)
+            {
+                std::cout << paths[i].filename().string() << ": level " << player.get_level() << ", "
+                          << player.get_tick() << " ticks, score " << simulation.get_game_state().get_score()
+                          << std::endl;
+            }
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Played " << replays.size() * repeat << " replays, " << total_ticks << " ticks in "
+              << seconds * 1000.0 << " ms (" << total_ticks / seconds << " ticks/s)" << std::endl;
+
+    if (analytics)
+    {
+        analytics->flush();
+        std::cout << "Wrote " << analytics->get_event_count() << " events to " << analytics_path << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @file triple_buffer.h
+ * @brief Lock-free single-producer, single-consumer triple buffer
+ *
+ * This file contains the TripleBuffer class, used to hand immutable render
+ * snapshots from the simulation thread to the render thread.
+ */
+
+/**
+ * @class TripleBuffer
+ * @brief Three slots shared by one writer and one reader without locks
+ *
+ * The writer fills its back slot and publishes it by swapping it with the
+ * shared middle slot; the reader swaps the middle slot into its front slot
+ * when a newer one is waiting. Neither side ever waits for the other: a
+ * slow reader simply skips snapshots and always sees the newest complete
+ * one, and a slow writer never stalls the reader.
+ *
+ * A slot is only touched by the side that currently owns it, so the
+ * contents need no synchronisation of their own. Ownership may move to
+ * another thread as long as the handover is ordered (e.g. by joining the
+ * thread that held it).
+ *
+ * @tparam T Slot type, reused between publishes (clear it before refilling)
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    /**
+     * @brief Writer: the slot to fill before the next publish()
+     */
+    T &write_buffer() { return slots_[back_]; }
+
+    /**
+     * @brief Writer: make the back slot the newest snapshot
+     */
+    void publish()
+    {
+        const std::uint8_t previous = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+        back_ = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Reader: take the newest published snapshot, if there is one
+     * @return true if read_buffer() changed
+     */
+    bool acquire()
+    {
+        if ((middle_.load(std::memory_order_relaxed) & FRESH) == 0)
+            return false;
+
+        const std::uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Reader: the snapshot taken by the last successful acquire()
+     */
+    const T &read_buffer() const { return slots_[front_]; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3; ///< Slot index bits of middle_
+    static constexpr std::uint8_t FRESH = 0x4;      ///< Set while the middle slot has not been read
+
+    std::array<T, 3> slots_;
+    std::uint8_t back_ = 0;               ///< Slot owned by the writer
+    std::atomic<std::uint8_t> middle_{1}; ///< Shared slot index plus FRESH flag
+    std::uint8_t front_ = 2;              ///< Slot owned by the reader
+};
@@ -0,0 +1,81 @@
+#include "world.h"
+
+/**
+ * @file world.cpp
+ * @brief Implementation of the World class
+ */
+
+World::World(TimerWheel *timers) : timers_(timers)
+{
+}
+
+EntityId World::create(std::uint32_t mask)
+{
+    EntityId id;
+    if (!free_ids_.empty())
+    {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    }
+    else
+    {
+        // Grow every array together so ids index all of them
+        id = size();
+        masks_.emplace_back();
+        transforms_.emplace_back();
+        movements_.emplace_back();
+        sprites_.emplace_back();
+        ai_states_.emplace_back();
+        popups_.emplace_back();
+        bonuses_.emplace_back();
+    }
+
+    // Reset the slot so a recycled id starts from default components
+    masks_[id] = mask;
+    transforms_[id] = Transform();
+    movements_[id] = Movement();
+    sprites_[id] = Sprite();
+    ai_states_[id] = AIState();
+    popups_[id] = Popup();
+    bonuses_[id] = Bonus();
+    return id;
+}
+
+void World::destroy(EntityId id)
+{
+    if (id >= size() || masks_[id] == 0)
+        return;
+
+    // Pending callbacks refer to this id
+    if (has(id, Component::AI_STATE))
+    {
+        timers_->cancel(ai_states_[id].scared_timer);
+        timers_->cancel(ai_states_[id].cooldown_timer);
+        timers_->cancel(ai_states_[id].random_dir_timer);
+    }
+    if (has(id, Component::POPUP))
+    {
+        timers_->cancel(popups_[id].timer);
+    }
+    if (has(id, Component::BONUS))
+    {
+        timers_->cancel(bonuses_[id].spawn_timer);
+        timers_->cancel(bonuses_[id].visible_timer);
+    }
+
+    masks_[id] = 0;
+    free_ids_.push_back(id);
+}
+
+void World::clear()
+{
+    masks_.clear();
+    free_ids_.clear();
+    transforms_.clear();
+    movements_.clear();
+    sprites_.clear();
+    ai_states_.clear();
+    popups_.clear();
+    bonuses_.clear();
+    clocks_.fill(Animation());
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "components.h"
+#include "game_random.h"
+#include "ghost_tuning.h"
+#include <array>
+#include <vector>
+
+/**
+ * @file world.h
+ * @brief Dense component storage for all game entities
+ *
+ * This file contains the World class, which owns one array per component
+ * type. Arrays are indexed directly by entity id, so a system touching
+ * several components of the same entity reads the same index in each array.
+ */
+
+/**
+ * @class World
+ * @brief Owns every entity's components
+ *
+ * The World is responsible for:
+ * - Allocating and recycling entity ids
+ * - Storing each component type in its own contiguous array
+ * - Cancelling an entity's pending timers when it is destroyed
+ * - Holding the game's random number generator, which systems draw from
+ * - Holding the ghost tuning the systems read their distances and durations from
+ *
+ * Systems loop over [0, size()) and skip ids whose mask lacks the components
+ * they need. With the handful of entities in a maze this is a short linear
+ * scan with no virtual calls or pointer chasing.
+ */
+class World
+{
+public:
+    /**
+     * @brief Constructor
+     * @param timers Timer wheel used by entity state timers
+     */
+    explicit World(TimerWheel *timers);
+
+    World(const World &) = delete;
+    World &operator=(const World &) = delete;
+
+    /**
+     * @brief Create an entity owning the given components (default-initialised)
+     * @param mask Bitwise OR of Component:: flags
+     * @return Id of the new entity
+     */
+    EntityId create(std::uint32_t mask);
+
+    /**
+     * @brief Destroy an entity, cancelling its timers and recycling its id
+     */
+    void destroy(EntityId id);
+
+    /**
+     * @brief Destroy every entity
+     * Timers are not cancelled; clear the timer wheel alongside the world.
+     */
+    void clear();
+
+    /**
+     * @brief Number of entity slots (live and free); systems iterate [0, size())
+     */
+    EntityId size() const { return static_cast<EntityId>(masks_.size()); }
+
+    /**
+     * @brief Check if an entity owns all of the given components
+     */
+    bool has(EntityId id, std::uint32_t mask) const { return id < masks_.size() && (masks_[id] & mask) == mask; }
+
+    // Component access (the entity must own the component)
+    Transform &transform(EntityId id) { return transforms_[id]; }
+    const Transform &transform(EntityId id) const { return transforms_[id]; }
+    Movement &movement(EntityId id) { return movements_[id]; }
+    const Movement &movement(EntityId id) const { return movements_[id]; }
+    Sprite &sprite(EntityId id) { return sprites_[id]; }
+    const Sprite &sprite(EntityId id) const { return sprites_[id]; }
+    AIState &ai_state(EntityId id) { return ai_states_[id]; }
+    const AIState &ai_state(EntityId id) const { return ai_states_[id]; }
+    Popup &popup(EntityId id) { return popups_[id]; }
+    const Popup &popup(EntityId id) const { return popups_[id]; }
+    Bonus &bonus(EntityId id) { return bonuses_[id]; }
+    const Bonus &bonus(EntityId id) const { return bonuses_[id]; }
+
+    // Animation clock shared by every entity of a sprite kind
+    Animation &clock(SpriteKind kind) { return clocks_[static_cast<int>(kind)]; }
+    const Animation &clock(SpriteKind kind) const { return clocks_[static_cast<int>(kind)]; }
+
+    TimerWheel &timers() { return *timers_; }
+    const TimerWheel &timers() const { return *timers_; }
+
+    // Random numbers for this game only, reseeded by Simulation::new_game
+    GameRandom &random() { return random_; }
+
+    // Ghost constants for this game, set by Simulation::new_game
+    const GhostTuning &tuning() const { return tuning_; }
+    void set_tuning(const GhostTuning &tuning) { tuning_ = tuning; }
+
+private:
+    TimerWheel *timers_;
+    GameRandom random_;                ///< Every random choice the game makes comes from here
+    GhostTuning tuning_;               ///< Distances and durations the ghost systems use
+    std::vector<std::uint32_t> masks_; ///< Component mask per entity (0 = free slot)
+    std::vector<EntityId> free_ids_;   ///< Destroyed ids available for reuse
+
+    std::vector<Transform> transforms_;
+    std::vector<Movement> movements_;
+    std::vector<Sprite> sprites_;
+    std::vector<AIState> ai_states_;
+    std::vector<Popup> popups_;
+    std::vector<Bonus> bonuses_;
+
+    std::array<Animation, static_cast<int>(SpriteKind::COUNT)> clocks_; ///< One animation clock per sprite kind
+};